@@ -0,0 +1,111 @@
+import createContext from 'quickjs/gl.js'
+import { createProgramFromSources } from '../common/utils.js'
+
+// Per-call latency of the native methods, below the WebGL validation layer.
+// Build with -DDIRECT_BINDINGS=OFF and ON to compare the quickjspp wrappers
+// with the generated bindings.
+const WARMUP_ITERATIONS = 10000
+const ITERATIONS = 1000000
+
+const vertexSrc = [
+  'attribute vec2 a_position;',
+  'void main() {',
+  'gl_Position = vec4(a_position, 0, 1);',
+  '}'
+].join('\n')
+
+const fragmentSrc = [
+  'precision mediump float;',
+  'uniform vec4 u_color;',
+  'void main() {',
+  'gl_FragColor = u_color;',
+  '}'
+].join('\n')
+
+function nativePrototype (gl) {
+  let proto = Object.getPrototypeOf(gl)
+  while (proto && proto.constructor.name !== 'QJSWebGLRenderingContext') {
+    proto = Object.getPrototypeOf(proto)
+  }
+  return proto
+}
+
+function measure (name, loop, baseline) {
+  loop(WARMUP_ITERATIONS)
+  const start = Date.now()
+  loop(ITERATIONS)
+  const elapsed = (Date.now() - start) * 1e6 / ITERATIONS
+  const net = baseline === undefined ? elapsed : Math.max(elapsed - baseline, 0)
+  console.log(name.padEnd(16) + net.toFixed(1).padStart(8) + ' ns/call')
+  return elapsed
+}
+
+function main () {
+  const gl = createContext(width, height, {
+    window: windowPtr,
+    platform: {
+      msaa: 0, // For PSVita
+      name: platformName
+    }
+  })
+
+  if (gl == null) {
+    console.log('gl is null!!!')
+    return
+  }
+
+  const program = createProgramFromSources(gl, [vertexSrc, fragmentSrc], ['a_position'], [0])
+  if (!program) {
+    console.log('gl program fail!!!')
+    gl.destroy()
+    return
+  }
+  gl.useProgram(program)
+  const location = gl.getUniformLocation(program, 'u_color')._
+  const buffer = gl.createBuffer()
+  gl.bindBuffer(gl.ARRAY_BUFFER, buffer)
+  gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 1, -1, 0, 1]), gl.STATIC_DRAW)
+  gl.enableVertexAttribArray(0)
+  gl.vertexAttribPointer(0, 2, gl.FLOAT, false, 0, 0)
+
+  const native = nativePrototype(gl)
+  const bufferId = buffer._
+  const noop = function () {}
+
+  console.log('Native call latency (loop overhead subtracted)')
+  const baseline = measure('loop', (n) => {
+    for (let i = 0; i < n; ++i) noop.call(gl, i)
+  })
+  measure('uniform4f', (n) => {
+    const uniform4f = native.uniform4f
+    for (let i = 0; i < n; ++i) uniform4f.call(gl, location, i & 1, 0, 0, 1)
+  }, baseline)
+  measure('drawArrays', (n) => {
+    const drawArrays = native.drawArrays
+    for (let i = 0; i < n; ++i) drawArrays.call(gl, gl.TRIANGLES, 0, 0)
+  }, baseline)
+  measure('enable', (n) => {
+    const enable = native.enable
+    for (let i = 0; i < n; ++i) enable.call(gl, gl.BLEND)
+  }, baseline)
+  measure('viewport', (n) => {
+    const viewport = native.viewport
+    for (let i = 0; i < n; ++i) viewport.call(gl, 0, 0, width, height)
+  }, baseline)
+  measure('vertexAttrib4f', (n) => {
+    const vertexAttrib4f = native.vertexAttrib4f
+    for (let i = 0; i < n; ++i) vertexAttrib4f.call(gl, 1, i, 0, 0, 1)
+  }, baseline)
+  measure('bindBuffer', (n) => {
+    const bindBuffer = native.bindBuffer
+    for (let i = 0; i < n; ++i) bindBuffer.call(gl, gl.ARRAY_BUFFER, bufferId)
+  }, baseline)
+  measure('getError', (n) => {
+    const getError = native.getError
+    for (let i = 0; i < n; ++i) getError.call(gl)
+  }, baseline)
+
+  gl.destroy()
+}
+
+main()
@@ -0,0 +1,93 @@
+import createContext from 'quickjs/gl.js'
+import { createProgramFromSources, showError } from '../common/utils.js'
+
+// Frames rendered and read back per second, with readPixels waiting for each
+// frame and with readPixelsAsync reading frame N while frame N + 1 is drawn
+const FRAMES = 300
+const IN_FLIGHT = 2
+const DRAWS_PER_FRAME = 64
+
+const vertexSrc = [
+  'attribute vec2 a_position;',
+  'uniform float u_offset;',
+  'void main() {',
+  'gl_Position = vec4(a_position + vec2(u_offset, 0), 0, 1);',
+  '}'
+].join('\n')
+
+const fragmentSrc = [
+  'precision mediump float;',
+  'uniform float u_offset;',
+  'void main() {',
+  'gl_FragColor = vec4(fract(gl_FragCoord.xy * u_offset), 0.5, 1);',
+  '}'
+].join('\n')
+
+function drawFrame (gl, offsetLocation, frame) {
+  gl.clear(gl.COLOR_BUFFER_BIT)
+  for (let i = 0; i < DRAWS_PER_FRAME; ++i) {
+    gl.uniform1f(offsetLocation, ((frame + i) % 64) / 256)
+    gl.drawArrays(gl.TRIANGLES, 0, 3)
+  }
+}
+
+async function main () {
+  const gl = createContext(width, height, {
+    window: windowPtr,
+    platform: {
+      msaa: 0, // For PSVita
+      name: platformName
+    }
+  })
+
+  if (gl == null) {
+    console.log('gl is null!!!')
+    return
+  }
+
+  const program = createProgramFromSources(gl, [vertexSrc, fragmentSrc], ['a_position'], [0])
+  if (!program) {
+    console.log('gl program fail!!!')
+    gl.destroy()
+    return
+  }
+  gl.useProgram(program)
+  const offsetLocation = gl.getUniformLocation(program, 'u_offset')
+  const buffer = gl.createBuffer()
+  gl.bindBuffer(gl.ARRAY_BUFFER, buffer)
+  gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 1, -1, 0, 1]), gl.STATIC_DRAW)
+  gl.enableVertexAttribArray(0)
+  gl.vertexAttribPointer(0, 2, gl.FLOAT, false, 0, 0)
+
+  const frames = []
+  for (let i = 0; i < IN_FLIGHT; ++i) {
+    frames.push(new Uint8Array(width * height * 4))
+  }
+
+  let start = Date.now()
+  for (let frame = 0; frame < FRAMES; ++frame) {
+    drawFrame(gl, offsetLocation, frame)
+    gl.readPixels(0, 0, width, height, gl.RGBA, gl.UNSIGNED_BYTE, frames[0])
+  }
+  const syncRate = FRAMES * 1000 / Math.max(Date.now() - start, 1)
+
+  start = Date.now()
+  const pending = []
+  for (let frame = 0; frame < FRAMES; ++frame) {
+    if (pending.length === IN_FLIGHT) {
+      await pending.shift()
+    }
+    drawFrame(gl, offsetLocation, frame)
+    pending.push(gl.readPixelsAsync(0, 0, width, height, gl.RGBA, gl.UNSIGNED_BYTE, frames[frame % IN_FLIGHT]))
+  }
+  await Promise.all(pending)
+  const asyncRate = FRAMES * 1000 / Math.max(Date.now() - start, 1)
+
+  showError(gl, 'readback')
+  gl.destroy()
+
+  console.log('readPixels       ' + syncRate.toFixed(1) + ' frames/s')
+  console.log('readPixelsAsync  ' + asyncRate.toFixed(1) + ' frames/s')
+}
+
+main()
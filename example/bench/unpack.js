@@ -0,0 +1,74 @@
+import createContext from 'quickjs/gl.js'
+import { showError } from '../common/utils.js'
+
+// Cost of texImage2D uploads with UNPACK_FLIP_Y_WEBGL and
+// UNPACK_PREMULTIPLY_ALPHA_WEBGL over typical texture sizes. The plain upload
+// is the baseline, the other rows include the unpacking done natively.
+const SIZES = [256, 512, 1024, 2048, 4096]
+const MIN_ITERATIONS = 4
+const TARGET_BYTES = 256 * 1024 * 1024
+
+const MODES = [
+  { name: 'plain', flipY: false, premultiply: false },
+  { name: 'flipY', flipY: true, premultiply: false },
+  { name: 'premultiply', flipY: false, premultiply: true },
+  { name: 'both', flipY: true, premultiply: true }
+]
+
+function upload (gl, size, pixels, iterations) {
+  for (let i = 0; i < iterations; ++i) {
+    gl.texImage2D(gl.TEXTURE_2D, 0, gl.RGBA, size, size, 0, gl.RGBA, gl.UNSIGNED_BYTE, pixels)
+  }
+  gl.finish()
+}
+
+function main () {
+  const gl = createContext(width, height, {
+    window: windowPtr,
+    platform: {
+      msaa: 0, // For PSVita
+      name: platformName
+    }
+  })
+
+  if (gl == null) {
+    console.log('gl is null!!!')
+    return
+  }
+
+  const texture = gl.createTexture()
+  gl.bindTexture(gl.TEXTURE_2D, texture)
+  const maxSize = gl.getParameter(gl.MAX_TEXTURE_SIZE)
+
+  console.log('size'.padEnd(12) + MODES.map((mode) => mode.name.padStart(12)).join('') + '  (ms/upload)')
+  for (const size of SIZES) {
+    if (size > maxSize) {
+      break
+    }
+
+    const pixels = new Uint8Array(size * size * 4)
+    for (let i = 0; i < pixels.length; ++i) {
+      pixels[i] = Math.imul(i, 2654435761) >>> 24
+    }
+    const iterations = Math.max(MIN_ITERATIONS, Math.floor(TARGET_BYTES / pixels.length))
+
+    let line = (size + 'x' + size).padEnd(12)
+    for (const mode of MODES) {
+      gl.pixelStorei(gl.UNPACK_FLIP_Y_WEBGL, mode.flipY)
+      gl.pixelStorei(gl.UNPACK_PREMULTIPLY_ALPHA_WEBGL, mode.premultiply)
+      upload(gl, size, pixels, 1)
+
+      const start = Date.now()
+      upload(gl, size, pixels, iterations)
+      const elapsed = (Date.now() - start) / iterations
+      line += elapsed.toFixed(2).padStart(12)
+    }
+    console.log(line)
+  }
+
+  showError(gl, 'unpack')
+  gl.deleteTexture(texture)
+  gl.destroy()
+}
+
+main()
@@ -0,0 +1,104 @@
+import createContext from 'quickjs/gl.js'
+import { createProgramFromSources, showError } from '../common/utils.js'
+
+// Calls issued per iteration of the render loop below
+const CALLS_PER_ITERATION = 12
+const WARMUP_ITERATIONS = 1000
+const ITERATIONS = 100000
+
+const vertexSrc = [
+  'attribute vec2 a_position;',
+  'uniform mat4 u_matrix;',
+  'void main() {',
+  'gl_Position = u_matrix * vec4(a_position, 0, 1);',
+  '}'
+].join('\n')
+
+const fragmentSrc = [
+  'precision mediump float;',
+  'uniform vec4 u_color;',
+  'void main() {',
+  'gl_FragColor = u_color;',
+  '}'
+].join('\n')
+
+function renderLoop (gl, program, buffer, colorLocation, matrixLocation, matrix, iterations) {
+  for (let i = 0; i < iterations; ++i) {
+    const shade = (i & 255) / 255
+    matrix[12] = shade * 0.01
+    gl.useProgram(program)
+    gl.bindBuffer(gl.ARRAY_BUFFER, buffer)
+    gl.enableVertexAttribArray(0)
+    gl.vertexAttribPointer(0, 2, gl.FLOAT, false, 0, 0)
+    gl.uniform4f(colorLocation, shade, 0, 1 - shade, 1)
+    gl.uniformMatrix4fv(matrixLocation, false, matrix)
+    gl.enable(gl.BLEND)
+    gl.blendFunc(gl.SRC_ALPHA, gl.ONE_MINUS_SRC_ALPHA)
+    gl.viewport(0, 0, width, height)
+    gl.drawArrays(gl.TRIANGLES, 0, 3)
+    gl.disable(gl.BLEND)
+    gl.bindBuffer(gl.ARRAY_BUFFER, null)
+  }
+}
+
+function bench (validation) {
+  const gl = createContext(width, height, {
+    window: windowPtr,
+    validation,
+    platform: {
+      msaa: 0, // For PSVita
+      name: platformName
+    }
+  })
+
+  if (gl == null) {
+    console.log('gl is null!!!')
+    return 0
+  }
+
+  const program = createProgramFromSources(gl, [vertexSrc, fragmentSrc], ['a_position'], [0])
+  if (!program) {
+    console.log('gl program fail!!!')
+    gl.destroy()
+    return 0
+  }
+
+  const colorLocation = gl.getUniformLocation(program, 'u_color')
+  const matrixLocation = gl.getUniformLocation(program, 'u_matrix')
+  const matrix = new Float32Array([
+    1, 0, 0, 0,
+    0, 1, 0, 0,
+    0, 0, 1, 0,
+    0, 0, 0, 1])
+
+  const buffer = gl.createBuffer()
+  gl.bindBuffer(gl.ARRAY_BUFFER, buffer)
+  gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-0.1, -0.1, 0.1, -0.1, 0, 0.1]), gl.STATIC_DRAW)
+
+  renderLoop(gl, program, buffer, colorLocation, matrixLocation, matrix, WARMUP_ITERATIONS)
+  gl.finish()
+
+  const start = Date.now()
+  renderLoop(gl, program, buffer, colorLocation, matrixLocation, matrix, ITERATIONS)
+  gl.finish()
+  const elapsed = Math.max(Date.now() - start, 1)
+
+  showError(gl, 'validation: ' + validation)
+  gl.swap()
+  gl.destroy()
+
+  return ITERATIONS * CALLS_PER_ITERATION * 1000 / elapsed
+}
+
+function main () {
+  const validated = bench('full')
+  const trusted = bench('none')
+
+  console.log('validation: full  ' + Math.round(validated) + ' calls/s')
+  console.log('validation: none  ' + Math.round(trusted) + ' calls/s')
+  if (validated > 0) {
+    console.log('speedup: ' + (trusted / validated).toFixed(2) + 'x')
+  }
+}
+
+main()
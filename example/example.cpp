@@ -66,6 +66,8 @@ int main(int argc, char **argv)
   
   try {
     context.evalFile(EVAL_FILE, JS_EVAL_TYPE_MODULE);
+    //Pending jobs and timers, promises like readPixelsAsync settle here
+    js_std_loop(ctx);
   } catch (const std::exception& e) {
     std::cerr << "File evaluation failed: " << e.what() << std::endl;
   } catch (const qjs::exception& e) {
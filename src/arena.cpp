@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "arena.h"
+
+ScratchArena::ScratchArena(size_t capacity)
+  : block(nullptr)
+  , blockSize(capacity)
+  , offset(0)
+  , fallbackBytes(0)
+  , peak(0)
+  , fallbackPeak(0)
+  , fallbackTotal(0) {
+}
+
+ScratchArena::~ScratchArena() {
+  this->releaseFallbacks(0);
+  free(this->block);
+}
+
+void* ScratchArena::allocate(size_t size, size_t alignment) {
+  //The block is only allocated once something needs it
+  if(!this->block && this->blockSize > 0) {
+    this->block = static_cast<uint8_t*>(malloc(this->blockSize));
+    if(!this->block) {
+      this->blockSize = 0;
+    }
+  }
+
+  size_t start = (this->offset + alignment - 1) & ~(alignment - 1);
+  void* result;
+  if(this->block && start <= this->blockSize && size <= this->blockSize - start) {
+    result = this->block + start;
+    this->offset = start + size;
+  } else {
+    //malloc is aligned for any fundamental type, which covers every caller
+    result = malloc(std::max<size_t>(size, 1));
+    if(!result) {
+      return nullptr;
+    }
+    this->fallbacks.emplace_back(result, size);
+    this->fallbackBytes += size;
+    this->fallbackTotal += 1;
+    this->fallbackPeak = std::max(this->fallbackPeak, this->fallbackBytes);
+  }
+  this->peak = std::max(this->peak, this->used());
+  return result;
+}
+
+void ScratchArena::reset() {
+  this->releaseFallbacks(0);
+  this->offset = 0;
+}
+
+void ScratchArena::resize(size_t capacity) {
+  this->reset();
+  free(this->block);
+  this->block = nullptr;
+  this->blockSize = capacity;
+}
+
+void ScratchArena::rewind(size_t offset, size_t fallbacks) {
+  this->releaseFallbacks(fallbacks);
+  this->offset = std::min(this->offset, offset);
+}
+
+void ScratchArena::releaseFallbacks(size_t count) {
+  while(this->fallbacks.size() > count) {
+    free(this->fallbacks.back().first);
+    this->fallbackBytes -= this->fallbacks.back().second;
+    this->fallbacks.pop_back();
+  }
+}
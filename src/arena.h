@@ -0,0 +1,87 @@
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Bump allocator for native scratch memory. Allocations live until the scope
+// that made them ends or until the context resets the arena in swap(), the
+// block itself is kept from frame to frame. Requests that don't fit in the
+// block are served by the heap and released at the same points.
+class ScratchArena {
+public:
+  explicit ScratchArena(size_t capacity);
+  ~ScratchArena();
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  template <typename T>
+  T* allocate(size_t count) {
+    return static_cast<T*>(this->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  //Releases everything allocated since the last reset
+  void reset();
+
+  //Replaces the block with one of the given size, after a reset
+  void resize(size_t capacity);
+
+  //Position in the arena, what was allocated after it can be released early
+  struct Mark {
+    size_t offset    = 0;
+    size_t fallbacks = 0;
+  };
+  Mark mark() const { return Mark{ offset, fallbacks.size() }; }
+  void release(const Mark& mark) { this->rewind(mark.offset, mark.fallbacks); }
+
+  //Releases what was allocated during its lifetime, for scratch memory that
+  //is not needed until the end of the frame
+  class Scope {
+  public:
+    explicit Scope(ScratchArena& arena)
+      : arena(arena)
+      , offset(arena.offset)
+      , fallbacks(arena.fallbacks.size()) {}
+    ~Scope() {
+      arena.rewind(offset, fallbacks);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    ScratchArena& arena;
+    size_t offset;
+    size_t fallbacks;
+  };
+
+  size_t capacity() const { return blockSize; }
+  size_t used() const { return offset + fallbackBytes; }
+  size_t highWater() const { return peak; }
+  size_t fallbackCount() const { return fallbackTotal; }
+  size_t fallbackHighWater() const { return fallbackPeak; }
+
+private:
+  void rewind(size_t offset, size_t fallbacks);
+  void releaseFallbacks(size_t count);
+
+  uint8_t* block;
+  size_t   blockSize;
+  size_t   offset;
+
+  //Heap allocations for the requests the block couldn't hold
+  std::vector<std::pair<void*, size_t>> fallbacks;
+  size_t   fallbackBytes;
+
+  //Statistics, peaks of used() and of the heap part of it
+  size_t   peak;
+  size_t   fallbackPeak;
+  size_t   fallbackTotal;
+};
+
+#endif
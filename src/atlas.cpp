@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <limits>
+
+#include "atlas.h"
+
+WebGLAtlasPacker::WebGLAtlasPacker(int32_t width, int32_t height)
+  : pageWidth(width)
+  , pageHeight(height)
+  , used(0) {
+  this->skyline.push_back(Segment{ 0, 0, width });
+}
+
+int32_t WebGLAtlasPacker::fit(size_t index, int32_t width, int32_t height) const {
+  const int32_t x = this->skyline[index].x;
+  if(x + width > this->pageWidth) {
+    return -1;
+  }
+  //The region rests on the highest segment it spans
+  int32_t y = 0;
+  int32_t remaining = width;
+  for(size_t i = index; remaining > 0; ++i) {
+    y = std::max(y, this->skyline[i].y);
+    if(y + height > this->pageHeight) {
+      return -1;
+    }
+    remaining -= this->skyline[i].width;
+  }
+  return y;
+}
+
+bool WebGLAtlasPacker::insert(int32_t width, int32_t height, int32_t& x, int32_t& y) {
+  if(width <= 0 || height <= 0) {
+    return false;
+  }
+
+  size_t best = this->skyline.size();
+  int32_t bestTop = std::numeric_limits<int32_t>::max();
+  int32_t bestWidth = std::numeric_limits<int32_t>::max();
+  for(size_t i = 0; i < this->skyline.size(); ++i) {
+    const int32_t top = this->fit(i, width, height);
+    if(top < 0) {
+      continue;
+    }
+    if(top + height < bestTop ||
+      (top + height == bestTop && this->skyline[i].width < bestWidth)) {
+      best = i;
+      bestTop = top + height;
+      bestWidth = this->skyline[i].width;
+    }
+  }
+  if(best == this->skyline.size()) {
+    return false;
+  }
+
+  x = this->skyline[best].x;
+  y = bestTop - height;
+
+  //The new segment covers the region, those it hides are cut or dropped
+  this->skyline.insert(this->skyline.begin() + best, Segment{ x, bestTop, width });
+  const int32_t right = x + width;
+  for(size_t i = best + 1; i < this->skyline.size();) {
+    Segment& segment = this->skyline[i];
+    if(segment.x >= right) {
+      break;
+    }
+    const int32_t shrink = right - segment.x;
+    if(segment.width <= shrink) {
+      this->skyline.erase(this->skyline.begin() + i);
+      continue;
+    }
+    segment.x += shrink;
+    segment.width -= shrink;
+    break;
+  }
+
+  //Neighbours at the same height are one segment
+  for(size_t i = 0; i + 1 < this->skyline.size();) {
+    if(this->skyline[i].y == this->skyline[i + 1].y) {
+      this->skyline[i].width += this->skyline[i + 1].width;
+      this->skyline.erase(this->skyline.begin() + i + 1);
+    } else {
+      ++i;
+    }
+  }
+
+  this->used += size_t(width) * height;
+  return true;
+}
+
+void WebGLAtlasPacker::close() {
+  this->skyline.assign(1, Segment{ 0, this->pageHeight, this->pageWidth });
+}
@@ -0,0 +1,43 @@
+#ifndef ATLAS_H_
+#define ATLAS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Skyline packer for the pages of a texture atlas. The skyline is the top edge
+// of the regions placed so far, a new region goes where it leaves the skyline
+// lowest (bottom-left rule), ties going to the narrowest segment. Regions are
+// never freed, an atlas page is filled once and dropped whole.
+class WebGLAtlasPacker {
+public:
+  WebGLAtlasPacker(int32_t width, int32_t height);
+
+  // Places a width x height region, false when it fits nowhere
+  bool insert(int32_t width, int32_t height, int32_t& x, int32_t& y);
+
+  // Nothing more goes into a full packer
+  void close();
+
+  int32_t width() const { return pageWidth; }
+  int32_t height() const { return pageHeight; }
+  size_t usedArea() const { return used; }
+
+private:
+  struct Segment {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+  };
+
+  // Height the region would rest at starting from segment index, -1 when it
+  // doesn't fit there
+  int32_t fit(size_t index, int32_t width, int32_t height) const;
+
+  int32_t pageWidth;
+  int32_t pageHeight;
+  size_t used;
+  std::vector<Segment> skyline;
+};
+
+#endif
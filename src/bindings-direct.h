@@ -0,0 +1,1908 @@
+// Generated by tools/gen-direct-bindings.py from webgl.h and bindings.cpp, do not edit
+
+#ifndef WEBGL_BINDINGS_DIRECT_H_
+#define WEBGL_BINDINGS_DIRECT_H_
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_VOID[])() = {
+  &WebGLRenderingContext::TakeMemoryBudgetCrossed,
+};
+
+static JSValue direct_GLboolean_void(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_VOID[magic])());
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLENUM_GLENUM_GLSIZEI_GLSIZEI[])(GLenum, GLenum, GLsizei, GLsizei) = {
+  &WebGLRenderingContext::RenderbufferStorage,
+};
+
+static JSValue direct_GLboolean_GLenum_GLenum_GLsizei_GLsizei(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLsizei a2;
+  GLsizei a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLENUM_GLENUM_GLSIZEI_GLSIZEI[magic])(a0, a1, a2, a3));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLINT_GLINT_GLSIZEI_GLSIZEI_GLINT[])(GLenum, GLint, GLenum, GLint, GLint, GLsizei, GLsizei, GLint) = {
+  &WebGLRenderingContext::CopyTexImage2D,
+};
+
+static JSValue direct_GLboolean_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLenum a2;
+  GLint a3;
+  GLint a4;
+  GLsizei a5;
+  GLsizei a6;
+  GLint a7;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6) ||
+     directArg(ctx, argv[7], &a7)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLINT_GLINT_GLSIZEI_GLSIZEI_GLINT[magic])(a0, a1, a2, a3, a4, a5, a6, a7));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLINT_GLENUM_GLINT_WEBGLBYTEARRAY[])(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLenum, GLint, WebGLByteArray) = {
+  &WebGLRenderingContext::TexImage2D,
+};
+
+static JSValue direct_GLboolean_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLenum_GLint_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLenum a2;
+  GLsizei a3;
+  GLsizei a4;
+  GLint a5;
+  GLenum a6;
+  GLint a7;
+  WebGLByteArray a8;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6) ||
+     directArg(ctx, argv[7], &a7) ||
+     directArg(ctx, argv[8], &a8)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLINT_GLENUM_GLINT_WEBGLBYTEARRAY[magic])(a0, a1, a2, a3, a4, a5, a6, a7, a8));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLINT_GLENUM_WEBGLBYTEARRAY[])(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLenum, WebGLByteArray) = {
+  &WebGLRenderingContext::TexImage2DFloat32,
+};
+
+static JSValue direct_GLboolean_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLenum_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLenum a2;
+  GLsizei a3;
+  GLsizei a4;
+  GLint a5;
+  GLenum a6;
+  WebGLByteArray a7;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6) ||
+     directArg(ctx, argv[7], &a7)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLINT_GLENUM_WEBGLBYTEARRAY[magic])(a0, a1, a2, a3, a4, a5, a6, a7));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLINT_WEBGLBYTEARRAY[])(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, WebGLByteArray) = {
+  &WebGLRenderingContext::CompressedTexImage2D,
+};
+
+static JSValue direct_GLboolean_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLenum a2;
+  GLsizei a3;
+  GLsizei a4;
+  GLint a5;
+  WebGLByteArray a6;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLINT_WEBGLBYTEARRAY[magic])(a0, a1, a2, a3, a4, a5, a6));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLINT_WEBGLBUFFERDATA_GLENUM[])(GLint, WebGLBufferData, GLenum) = {
+  &WebGLRenderingContext::BufferData,
+};
+
+static JSValue direct_GLboolean_GLint_WebGLBufferData_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  WebGLBufferData a1;
+  GLenum a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLINT_WEBGLBUFFERDATA_GLENUM[magic])(a0, a1, a2));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLUINT[])(GLuint) = {
+  &WebGLRenderingContext::IsBuffer,
+  &WebGLRenderingContext::IsFramebuffer,
+  &WebGLRenderingContext::IsProgram,
+  &WebGLRenderingContext::IsRenderbuffer,
+  &WebGLRenderingContext::IsShader,
+  &WebGLRenderingContext::IsTexture,
+  &WebGLRenderingContext::TextureEvicted,
+};
+
+static JSValue direct_GLboolean_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLUINT[magic])(a0));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLUINT_GLUINT[])(GLuint, GLuint) = {
+  &WebGLRenderingContext::AtlasAddPage,
+};
+
+static JSValue direct_GLboolean_GLuint_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLuint a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLUINT_GLUINT[magic])(a0, a1));
+}
+
+static GLboolean (WebGLRenderingContext::* const DIRECT_GLBOOLEAN_GLUINT_GLUINT_GLENUM_GLINT[])(GLuint, GLuint, GLenum, GLint) = {
+  &WebGLRenderingContext::TexImage2DDecoded,
+};
+
+static JSValue direct_GLboolean_GLuint_GLuint_GLenum_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLuint a1;
+  GLenum a2;
+  GLint a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLBOOLEAN_GLUINT_GLUINT_GLENUM_GLINT[magic])(a0, a1, a2, a3));
+}
+
+static GLenum (WebGLRenderingContext::* const DIRECT_GLENUM_VOID[])() = {
+  &WebGLRenderingContext::GetError,
+};
+
+static JSValue direct_GLenum_void(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLENUM_VOID[magic])());
+}
+
+static GLenum (WebGLRenderingContext::* const DIRECT_GLENUM_GLENUM[])(GLenum) = {
+  &WebGLRenderingContext::CheckFramebufferStatus,
+};
+
+static JSValue direct_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLENUM_GLENUM[magic])(a0));
+}
+
+static GLenum (WebGLRenderingContext::* const DIRECT_GLENUM_GLUINT[])(GLuint) = {
+  &WebGLRenderingContext::FramebufferStatus,
+};
+
+static JSValue direct_GLenum_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLENUM_GLUINT[magic])(a0));
+}
+
+static GLint (WebGLRenderingContext::* const DIRECT_GLINT_GLENUM_GLENUM[])(GLenum, GLenum) = {
+  &WebGLRenderingContext::GetBufferParameter,
+};
+
+static JSValue direct_GLint_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLINT_GLENUM_GLENUM[magic])(a0, a1));
+}
+
+static GLint (WebGLRenderingContext::* const DIRECT_GLINT_GLENUM_GLENUM_GLENUM[])(GLenum, GLenum, GLenum) = {
+  &WebGLRenderingContext::GetFramebufferAttachmentParameter,
+};
+
+static JSValue direct_GLint_GLenum_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLenum a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLINT_GLENUM_GLENUM_GLENUM[magic])(a0, a1, a2));
+}
+
+static GLint (WebGLRenderingContext::* const DIRECT_GLINT_GLINT_GLENUM[])(GLint, GLenum) = {
+  &WebGLRenderingContext::GetShaderParameter,
+  &WebGLRenderingContext::GetProgramParameter,
+};
+
+static JSValue direct_GLint_GLint_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLenum a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLINT_GLINT_GLENUM[magic])(a0, a1));
+}
+
+static GLint (WebGLRenderingContext::* const DIRECT_GLINT_GLUINT_WEBGLBYTEARRAY[])(GLuint, WebGLByteArray) = {
+  &WebGLRenderingContext::ReadPixelsAsyncResult,
+};
+
+static JSValue direct_GLint_GLuint_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  WebGLByteArray a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLINT_GLUINT_WEBGLBYTEARRAY[magic])(a0, a1));
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_VOID[])() = {
+  &WebGLRenderingContext::CreateProgram,
+  &WebGLRenderingContext::CreateTexture,
+  &WebGLRenderingContext::CreateFramebuffer,
+  &WebGLRenderingContext::CreateBuffer,
+  &WebGLRenderingContext::CreateRenderbuffer,
+  &WebGLRenderingContext::CreateVertexArrayOES,
+};
+
+static JSValue direct_GLuint_void(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_VOID[magic])());
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_GLENUM[])(GLenum) = {
+  &WebGLRenderingContext::CreateShader,
+};
+
+static JSValue direct_GLuint_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_GLENUM[magic])(a0));
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLENUM_GLENUM_WEBGLBYTEARRAY[])(GLenum, GLint, GLenum, GLsizei, GLsizei, GLenum, GLenum, WebGLByteArray) = {
+  &WebGLRenderingContext::EnqueueTexImage2D,
+};
+
+static JSValue direct_GLuint_GLenum_GLint_GLenum_GLsizei_GLsizei_GLenum_GLenum_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLenum a2;
+  GLsizei a3;
+  GLsizei a4;
+  GLenum a5;
+  GLenum a6;
+  WebGLByteArray a7;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6) ||
+     directArg(ctx, argv[7], &a7)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_GLENUM_GLINT_GLENUM_GLSIZEI_GLSIZEI_GLENUM_GLENUM_WEBGLBYTEARRAY[magic])(a0, a1, a2, a3, a4, a5, a6, a7));
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_GLENUM_WEBGLBYTEARRAY_GLENUM[])(GLenum, WebGLByteArray, GLenum) = {
+  &WebGLRenderingContext::EnqueueBufferData,
+};
+
+static JSValue direct_GLuint_GLenum_WebGLByteArray_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  WebGLByteArray a1;
+  GLenum a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_GLENUM_WEBGLBYTEARRAY_GLENUM[magic])(a0, a1, a2));
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_GLENUM[])(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum) = {
+  &WebGLRenderingContext::ReadPixelsAsync,
+};
+
+static JSValue direct_GLuint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  GLsizei a2;
+  GLsizei a3;
+  GLenum a4;
+  GLenum a5;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_GLENUM[magic])(a0, a1, a2, a3, a4, a5));
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_GLSIZEI_GLSIZEI_GLINT_GLENUM_GLBOOLEAN[])(GLsizei, GLsizei, GLint, GLenum, GLboolean) = {
+  &WebGLRenderingContext::CreateAtlas,
+};
+
+static JSValue direct_GLuint_GLsizei_GLsizei_GLint_GLenum_GLboolean(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLsizei a0;
+  GLsizei a1;
+  GLint a2;
+  GLenum a3;
+  GLboolean a4;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_GLSIZEI_GLSIZEI_GLINT_GLENUM_GLBOOLEAN[magic])(a0, a1, a2, a3, a4));
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_GLUINT_GLENUM[])(GLuint, GLenum) = {
+  &WebGLRenderingContext::GetVertexAttribOffset,
+};
+
+static JSValue direct_GLuint_GLuint_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLenum a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_GLUINT_GLENUM[magic])(a0, a1));
+}
+
+static GLuint (WebGLRenderingContext::* const DIRECT_GLUINT_WEBGLBYTEARRAY_GLENUM_GLBOOLEAN_GLBOOLEAN[])(WebGLByteArray, GLenum, GLboolean, GLboolean) = {
+  &WebGLRenderingContext::DecodeImage,
+};
+
+static JSValue direct_GLuint_WebGLByteArray_GLenum_GLboolean_GLboolean(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  WebGLByteArray a0;
+  GLenum a1;
+  GLboolean a2;
+  GLboolean a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_GLUINT_WEBGLBYTEARRAY_GLENUM_GLBOOLEAN_GLBOOLEAN[magic])(a0, a1, a2, a3));
+}
+
+static bool (WebGLRenderingContext::* const DIRECT_BOOL_VOID[])() = {
+  &WebGLRenderingContext::IsRobustAccess,
+  &WebGLRenderingContext::DeferErrors,
+};
+
+static JSValue direct_bool_void(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_BOOL_VOID[magic])());
+}
+
+static bool (WebGLRenderingContext::* const DIRECT_BOOL_GLENUM[])(GLenum) = {
+  &WebGLRenderingContext::IsEnabled,
+};
+
+static JSValue direct_bool_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_BOOL_GLENUM[magic])(a0));
+}
+
+static bool (WebGLRenderingContext::* const DIRECT_BOOL_GLUINT[])(GLuint) = {
+  &WebGLRenderingContext::IsVertexArrayOES,
+};
+
+static JSValue direct_bool_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_BOOL_GLUINT[magic])(a0));
+}
+
+static int (WebGLRenderingContext::* const DIRECT_INT_GLENUM_GLENUM[])(GLenum, GLenum) = {
+  &WebGLRenderingContext::GetRenderbufferParameter,
+};
+
+static JSValue direct_int_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  return directReturn(ctx, (self->*DIRECT_INT_GLENUM_GLENUM[magic])(a0, a1));
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_VOID[])() = {
+  &WebGLRenderingContext::Swap,
+  &WebGLRenderingContext::Flush,
+  &WebGLRenderingContext::Finish,
+  &WebGLRenderingContext::ProcessUploads,
+  &WebGLRenderingContext::Destroy,
+};
+
+static JSValue direct_void_void(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_VOID[magic])();
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLBITFIELD[])(GLbitfield) = {
+  &WebGLRenderingContext::Clear,
+};
+
+static JSValue direct_void_GLbitfield(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLbitfield a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLBITFIELD[magic])(a0);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLBOOLEAN[])(GLboolean) = {
+  &WebGLRenderingContext::DepthMask,
+};
+
+static JSValue direct_void_GLboolean(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLboolean a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLBOOLEAN[magic])(a0);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLBOOLEAN_GLBOOLEAN_GLBOOLEAN_GLBOOLEAN[])(GLboolean, GLboolean, GLboolean, GLboolean) = {
+  &WebGLRenderingContext::ColorMask,
+};
+
+static JSValue direct_void_GLboolean_GLboolean_GLboolean_GLboolean(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLboolean a0;
+  GLboolean a1;
+  GLboolean a2;
+  GLboolean a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLBOOLEAN_GLBOOLEAN_GLBOOLEAN_GLBOOLEAN[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLCLAMPF_GLBOOLEAN[])(GLclampf, GLboolean) = {
+  &WebGLRenderingContext::SampleCoverage,
+};
+
+static JSValue direct_void_GLclampf_GLboolean(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLclampf a0;
+  GLboolean a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLCLAMPF_GLBOOLEAN[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLCLAMPF_GLCLAMPF[])(GLclampf, GLclampf) = {
+  &WebGLRenderingContext::DepthRange,
+};
+
+static JSValue direct_void_GLclampf_GLclampf(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLclampf a0;
+  GLclampf a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLCLAMPF_GLCLAMPF[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLCLAMPF_GLCLAMPF_GLCLAMPF_GLCLAMPF[])(GLclampf, GLclampf, GLclampf, GLclampf) = {
+  &WebGLRenderingContext::BlendColor,
+};
+
+static JSValue direct_void_GLclampf_GLclampf_GLclampf_GLclampf(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLclampf a0;
+  GLclampf a1;
+  GLclampf a2;
+  GLclampf a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLCLAMPF_GLCLAMPF_GLCLAMPF_GLCLAMPF[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM[])(GLenum) = {
+  &WebGLRenderingContext::DepthFunc,
+  &WebGLRenderingContext::Disable,
+  &WebGLRenderingContext::Enable,
+  &WebGLRenderingContext::BlendEquation,
+  &WebGLRenderingContext::ActiveTexture,
+  &WebGLRenderingContext::CullFace,
+  &WebGLRenderingContext::FrontFace,
+  &WebGLRenderingContext::SetError,
+};
+
+static JSValue direct_void_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM[magic])(a0);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM[])(GLenum, GLenum) = {
+  &WebGLRenderingContext::PixelStorei,
+  &WebGLRenderingContext::BlendFunc,
+  &WebGLRenderingContext::BlendEquationSeparate,
+  &WebGLRenderingContext::Hint,
+};
+
+static JSValue direct_void_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM_GLENUM[])(GLenum, GLenum, GLenum) = {
+  &WebGLRenderingContext::StencilOp,
+};
+
+static JSValue direct_void_GLenum_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLenum a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM_GLENUM[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM_GLENUM_GLENUM[])(GLenum, GLenum, GLenum, GLenum) = {
+  &WebGLRenderingContext::BlendFuncSeparate,
+  &WebGLRenderingContext::StencilOpSeparate,
+};
+
+static JSValue direct_void_GLenum_GLenum_GLenum_GLenum(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLenum a2;
+  GLenum a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM_GLENUM_GLENUM[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM_GLENUM_GLUINT[])(GLenum, GLenum, GLenum, GLuint) = {
+  &WebGLRenderingContext::FramebufferRenderbuffer,
+};
+
+static JSValue direct_void_GLenum_GLenum_GLenum_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLenum a2;
+  GLuint a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM_GLENUM_GLUINT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM_GLFLOAT[])(GLenum, GLenum, GLfloat) = {
+  &WebGLRenderingContext::TexParameterf,
+};
+
+static JSValue direct_void_GLenum_GLenum_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLfloat a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM_GLFLOAT[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM_GLINT[])(GLenum, GLenum, GLint) = {
+  &WebGLRenderingContext::TexParameteri,
+};
+
+static JSValue direct_void_GLenum_GLenum_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLint a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM_GLINT[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM_GLINT_GLINT_GLINT[])(GLenum, GLenum, GLint, GLint, GLint) = {
+  &WebGLRenderingContext::FramebufferTexture2D,
+};
+
+static JSValue direct_void_GLenum_GLenum_GLint_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLint a2;
+  GLint a3;
+  GLint a4;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM_GLINT_GLINT_GLINT[magic])(a0, a1, a2, a3, a4);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLENUM_GLINT_GLUINT[])(GLenum, GLenum, GLint, GLuint) = {
+  &WebGLRenderingContext::StencilFuncSeparate,
+};
+
+static JSValue direct_void_GLenum_GLenum_GLint_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLenum a1;
+  GLint a2;
+  GLuint a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLENUM_GLINT_GLUINT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT[])(GLenum, GLint) = {
+  &WebGLRenderingContext::BindTexture,
+};
+
+static JSValue direct_void_GLenum_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLENUM_GLINT[])(GLenum, GLint, GLenum, GLint) = {
+  &WebGLRenderingContext::DrawElements,
+};
+
+static JSValue direct_void_GLenum_GLint_GLenum_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLenum a2;
+  GLint a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLENUM_GLINT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLENUM_GLINT_GLINT[])(GLenum, GLint, GLenum, GLint, GLint) = {
+  &WebGLRenderingContext::DrawElementsInstanced,
+};
+
+static JSValue direct_void_GLenum_GLint_GLenum_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLenum a2;
+  GLint a3;
+  GLint a4;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLENUM_GLINT_GLINT[magic])(a0, a1, a2, a3, a4);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLINT[])(GLenum, GLint, GLint) = {
+  &WebGLRenderingContext::DrawArrays,
+};
+
+static JSValue direct_void_GLenum_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLint a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLINT[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT[])(GLenum, GLint, GLint, GLint) = {
+  &WebGLRenderingContext::DrawArraysInstanced,
+};
+
+static JSValue direct_void_GLenum_GLint_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLint a2;
+  GLint a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT_GLINT_GLINT_GLSIZEI_GLSIZEI[])(GLenum, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei) = {
+  &WebGLRenderingContext::CopyTexSubImage2D,
+};
+
+static JSValue direct_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLint a2;
+  GLint a3;
+  GLint a4;
+  GLint a5;
+  GLsizei a6;
+  GLsizei a7;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6) ||
+     directArg(ctx, argv[7], &a7)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT_GLINT_GLINT_GLSIZEI_GLSIZEI[magic])(a0, a1, a2, a3, a4, a5, a6, a7);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_GLENUM_WEBGLBYTEARRAY[])(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, WebGLByteArray) = {
+  &WebGLRenderingContext::TexSubImage2D,
+};
+
+static JSValue direct_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLint a2;
+  GLint a3;
+  GLsizei a4;
+  GLsizei a5;
+  GLenum a6;
+  GLenum a7;
+  WebGLByteArray a8;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6) ||
+     directArg(ctx, argv[7], &a7) ||
+     directArg(ctx, argv[8], &a8)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_GLENUM_WEBGLBYTEARRAY[magic])(a0, a1, a2, a3, a4, a5, a6, a7, a8);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_WEBGLBYTEARRAY[])(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, WebGLByteArray) = {
+  &WebGLRenderingContext::CompressedTexSubImage2D,
+  &WebGLRenderingContext::TexSubImage2DFloat32,
+};
+
+static JSValue direct_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLint a2;
+  GLint a3;
+  GLsizei a4;
+  GLsizei a5;
+  GLenum a6;
+  WebGLByteArray a7;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6) ||
+     directArg(ctx, argv[7], &a7)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_WEBGLBYTEARRAY[magic])(a0, a1, a2, a3, a4, a5, a6, a7);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_GLUINT[])(GLenum, GLint, GLuint) = {
+  &WebGLRenderingContext::StencilFunc,
+};
+
+static JSValue direct_void_GLenum_GLint_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  GLuint a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_GLUINT[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLINT_WEBGLBYTEARRAY[])(GLenum, GLint, WebGLByteArray) = {
+  &WebGLRenderingContext::BufferSubData,
+};
+
+static JSValue direct_void_GLenum_GLint_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLint a1;
+  WebGLByteArray a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLINT_WEBGLBYTEARRAY[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLENUM_GLUINT[])(GLenum, GLuint) = {
+  &WebGLRenderingContext::BindBuffer,
+  &WebGLRenderingContext::StencilMaskSeparate,
+  &WebGLRenderingContext::BindRenderbuffer,
+};
+
+static JSValue direct_void_GLenum_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLenum a0;
+  GLuint a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLENUM_GLUINT[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLFLOAT[])(GLfloat) = {
+  &WebGLRenderingContext::ClearDepth,
+  &WebGLRenderingContext::LineWidth,
+};
+
+static JSValue direct_void_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLfloat a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLFLOAT[magic])(a0);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLFLOAT_GLFLOAT[])(GLfloat, GLfloat) = {
+  &WebGLRenderingContext::PolygonOffset,
+};
+
+static JSValue direct_void_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLfloat a0;
+  GLfloat a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLFLOAT_GLFLOAT[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLFLOAT_GLFLOAT_GLFLOAT_GLFLOAT[])(GLfloat, GLfloat, GLfloat, GLfloat) = {
+  &WebGLRenderingContext::ClearColor,
+};
+
+static JSValue direct_void_GLfloat_GLfloat_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLfloat a0;
+  GLfloat a1;
+  GLfloat a2;
+  GLfloat a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLFLOAT_GLFLOAT_GLFLOAT_GLFLOAT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT[])(GLint) = {
+  &WebGLRenderingContext::GenerateMipmap,
+  &WebGLRenderingContext::ClearStencil,
+  &WebGLRenderingContext::SetUploadBudget,
+};
+
+static JSValue direct_void_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT[magic])(a0);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLFLOAT[])(GLint, GLfloat) = {
+  &WebGLRenderingContext::Uniform1f,
+};
+
+static JSValue direct_void_GLint_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLfloat a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLFLOAT[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLFLOAT_GLFLOAT[])(GLint, GLfloat, GLfloat) = {
+  &WebGLRenderingContext::Uniform2f,
+};
+
+static JSValue direct_void_GLint_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLfloat a1;
+  GLfloat a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLFLOAT_GLFLOAT[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLFLOAT_GLFLOAT_GLFLOAT[])(GLint, GLfloat, GLfloat, GLfloat) = {
+  &WebGLRenderingContext::Uniform3f,
+};
+
+static JSValue direct_void_GLint_GLfloat_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLfloat a1;
+  GLfloat a2;
+  GLfloat a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLFLOAT_GLFLOAT_GLFLOAT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLFLOAT_GLFLOAT_GLFLOAT_GLFLOAT[])(GLint, GLfloat, GLfloat, GLfloat, GLfloat) = {
+  &WebGLRenderingContext::Uniform4f,
+};
+
+static JSValue direct_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLfloat a1;
+  GLfloat a2;
+  GLfloat a3;
+  GLfloat a4;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLFLOAT_GLFLOAT_GLFLOAT_GLFLOAT[magic])(a0, a1, a2, a3, a4);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLINT[])(GLint, GLint) = {
+  &WebGLRenderingContext::Uniform1i,
+  &WebGLRenderingContext::AttachShader,
+  &WebGLRenderingContext::BindFramebuffer,
+};
+
+static JSValue direct_void_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLINT[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLINT_GLENUM_GLBOOLEAN_GLINT_QJS_SIZE_T[])(GLint, GLint, GLenum, GLboolean, GLint, qjs_size_t) = {
+  &WebGLRenderingContext::VertexAttribPointer,
+};
+
+static JSValue direct_void_GLint_GLint_GLenum_GLboolean_GLint_qjs_size_t(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  GLenum a2;
+  GLboolean a3;
+  GLint a4;
+  qjs_size_t a5;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLINT_GLENUM_GLBOOLEAN_GLINT_QJS_SIZE_T[magic])(a0, a1, a2, a3, a4, a5);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLINT_GLINT[])(GLint, GLint, GLint) = {
+  &WebGLRenderingContext::Uniform2i,
+};
+
+static JSValue direct_void_GLint_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  GLint a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLINT_GLINT[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLINT_GLINT_GLINT[])(GLint, GLint, GLint, GLint) = {
+  &WebGLRenderingContext::Uniform3i,
+};
+
+static JSValue direct_void_GLint_GLint_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  GLint a2;
+  GLint a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLINT_GLINT_GLINT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLINT_GLINT_GLINT_GLINT[])(GLint, GLint, GLint, GLint, GLint) = {
+  &WebGLRenderingContext::Uniform4i,
+};
+
+static JSValue direct_void_GLint_GLint_GLint_GLint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  GLint a2;
+  GLint a3;
+  GLint a4;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLINT_GLINT_GLINT_GLINT[magic])(a0, a1, a2, a3, a4);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLINT_GLSIZEI_GLSIZEI[])(GLint, GLint, GLsizei, GLsizei) = {
+  &WebGLRenderingContext::Viewport,
+  &WebGLRenderingContext::Scissor,
+};
+
+static JSValue direct_void_GLint_GLint_GLsizei_GLsizei(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  GLsizei a2;
+  GLsizei a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLINT_GLSIZEI_GLSIZEI[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_GLENUM_WEBGLBYTEARRAY[])(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, WebGLByteArray) = {
+  &WebGLRenderingContext::ReadPixels,
+};
+
+static JSValue direct_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_WebGLByteArray(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLint a0;
+  GLint a1;
+  GLsizei a2;
+  GLsizei a3;
+  GLenum a4;
+  GLenum a5;
+  WebGLByteArray a6;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4) ||
+     directArg(ctx, argv[5], &a5) ||
+     directArg(ctx, argv[6], &a6)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLINT_GLINT_GLSIZEI_GLSIZEI_GLENUM_GLENUM_WEBGLBYTEARRAY[magic])(a0, a1, a2, a3, a4, a5, a6);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLSIZEI_GLSIZEI[])(GLsizei, GLsizei) = {
+  &WebGLRenderingContext::SetDrawingBufferSize,
+};
+
+static JSValue direct_void_GLsizei_GLsizei(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLsizei a0;
+  GLsizei a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLSIZEI_GLSIZEI[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT[])(GLuint) = {
+  &WebGLRenderingContext::CompileShader,
+  &WebGLRenderingContext::LinkProgram,
+  &WebGLRenderingContext::UseProgram,
+  &WebGLRenderingContext::EnableVertexAttribArray,
+  &WebGLRenderingContext::DisableVertexAttribArray,
+  &WebGLRenderingContext::StencilMask,
+  &WebGLRenderingContext::DeleteBuffer,
+  &WebGLRenderingContext::DeleteFramebuffer,
+  &WebGLRenderingContext::DeleteProgram,
+  &WebGLRenderingContext::DeleteRenderbuffer,
+  &WebGLRenderingContext::DeleteShader,
+  &WebGLRenderingContext::DeleteTexture,
+  &WebGLRenderingContext::ValidateProgram,
+  &WebGLRenderingContext::ReleaseDecodedImage,
+  &WebGLRenderingContext::DeleteAtlas,
+  &WebGLRenderingContext::UnmanageTexture,
+  &WebGLRenderingContext::DeleteVertexArrayOES,
+  &WebGLRenderingContext::BindVertexArrayOES,
+  &WebGLRenderingContext::SetDrawingBuffer,
+};
+
+static JSValue direct_void_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT[magic])(a0);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT_GLBOOLEAN[])(GLuint, GLboolean) = {
+  &WebGLRenderingContext::ManageTexture,
+};
+
+static JSValue direct_void_GLuint_GLboolean(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLboolean a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT_GLBOOLEAN[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT_GLENUM_GLENUM_GLUINT_GLINT[])(GLuint, GLenum, GLenum, GLuint, GLint) = {
+  &WebGLRenderingContext::FramebufferAttachment,
+};
+
+static JSValue direct_void_GLuint_GLenum_GLenum_GLuint_GLint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLenum a1;
+  GLenum a2;
+  GLuint a3;
+  GLint a4;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT_GLENUM_GLENUM_GLUINT_GLINT[magic])(a0, a1, a2, a3, a4);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT_GLFLOAT[])(GLuint, GLfloat) = {
+  &WebGLRenderingContext::VertexAttrib1f,
+};
+
+static JSValue direct_void_GLuint_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLfloat a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT_GLFLOAT[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT_GLFLOAT_GLFLOAT[])(GLuint, GLfloat, GLfloat) = {
+  &WebGLRenderingContext::VertexAttrib2f,
+};
+
+static JSValue direct_void_GLuint_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLfloat a1;
+  GLfloat a2;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT_GLFLOAT_GLFLOAT[magic])(a0, a1, a2);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT_GLFLOAT_GLFLOAT_GLFLOAT[])(GLuint, GLfloat, GLfloat, GLfloat) = {
+  &WebGLRenderingContext::VertexAttrib3f,
+};
+
+static JSValue direct_void_GLuint_GLfloat_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLfloat a1;
+  GLfloat a2;
+  GLfloat a3;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT_GLFLOAT_GLFLOAT_GLFLOAT[magic])(a0, a1, a2, a3);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT_GLFLOAT_GLFLOAT_GLFLOAT_GLFLOAT[])(GLuint, GLfloat, GLfloat, GLfloat, GLfloat) = {
+  &WebGLRenderingContext::VertexAttrib4f,
+};
+
+static JSValue direct_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLfloat a1;
+  GLfloat a2;
+  GLfloat a3;
+  GLfloat a4;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1) ||
+     directArg(ctx, argv[2], &a2) ||
+     directArg(ctx, argv[3], &a3) ||
+     directArg(ctx, argv[4], &a4)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT_GLFLOAT_GLFLOAT_GLFLOAT_GLFLOAT[magic])(a0, a1, a2, a3, a4);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_GLUINT_GLUINT[])(GLuint, GLuint) = {
+  &WebGLRenderingContext::VertexAttribDivisor,
+  &WebGLRenderingContext::DetachShader,
+  &WebGLRenderingContext::SetDrawingBufferStorage,
+};
+
+static JSValue direct_void_GLuint_GLuint(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  GLuint a0;
+  GLuint a1;
+  if(directArg(ctx, argv[0], &a0) ||
+     directArg(ctx, argv[1], &a1)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_GLUINT_GLUINT[magic])(a0, a1);
+  return JS_UNDEFINED;
+}
+
+static void (WebGLRenderingContext::* const DIRECT_VOID_QJS_SIZE_T[])(qjs_size_t) = {
+  &WebGLRenderingContext::SetArenaSize,
+};
+
+static JSValue direct_void_qjs_size_t(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {
+  WebGLRenderingContext* self = directContext(ctx, this_val);
+  if(!self) {
+    return JS_EXCEPTION;
+  }
+  qjs_size_t a0;
+  if(directArg(ctx, argv[0], &a0)) {
+    return JS_EXCEPTION;
+  }
+  (self->*DIRECT_VOID_QJS_SIZE_T[magic])(a0);
+  return JS_UNDEFINED;
+}
+
+static const JSCFunctionListEntry DIRECT_BINDINGS[] = {
+  JS_CFUNC_MAGIC_DEF("_drawArraysInstanced", 4, direct_void_GLenum_GLint_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("_drawElementsInstanced", 5, direct_void_GLenum_GLint_GLenum_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("_vertexAttribDivisor", 2, direct_void_GLuint_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("swap", 0, direct_void_void, 0),
+  JS_CFUNC_MAGIC_DEF("uniform1f", 2, direct_void_GLint_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("uniform2f", 3, direct_void_GLint_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("uniform3f", 4, direct_void_GLint_GLfloat_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("uniform4f", 5, direct_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("uniform1i", 2, direct_void_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("uniform2i", 3, direct_void_GLint_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("uniform3i", 4, direct_void_GLint_GLint_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("uniform4i", 5, direct_void_GLint_GLint_GLint_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("pixelStorei", 2, direct_void_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("getError", 0, direct_GLenum_void, 0),
+  JS_CFUNC_MAGIC_DEF("drawArrays", 3, direct_void_GLenum_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("generateMipmap", 1, direct_void_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("depthFunc", 1, direct_void_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("viewport", 4, direct_void_GLint_GLint_GLsizei_GLsizei, 0),
+  JS_CFUNC_MAGIC_DEF("createShader", 1, direct_GLuint_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("compileShader", 1, direct_void_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("getShaderParameter", 2, direct_GLint_GLint_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("createProgram", 0, direct_GLuint_void, 0),
+  JS_CFUNC_MAGIC_DEF("attachShader", 2, direct_void_GLint_GLint, 1),
+  JS_CFUNC_MAGIC_DEF("linkProgram", 1, direct_void_GLuint, 1),
+  JS_CFUNC_MAGIC_DEF("getProgramParameter", 2, direct_GLint_GLint_GLenum, 1),
+  JS_CFUNC_MAGIC_DEF("clearColor", 4, direct_void_GLfloat_GLfloat_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("clearDepth", 1, direct_void_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("disable", 1, direct_void_GLenum, 1),
+  JS_CFUNC_MAGIC_DEF("createTexture", 0, direct_GLuint_void, 1),
+  JS_CFUNC_MAGIC_DEF("bindTexture", 2, direct_void_GLenum_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("texImage2D", 9, direct_GLboolean_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLenum_GLint_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("texParameteri", 3, direct_void_GLenum_GLenum_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("texParameterf", 3, direct_void_GLenum_GLenum_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("clear", 1, direct_void_GLbitfield, 0),
+  JS_CFUNC_MAGIC_DEF("useProgram", 1, direct_void_GLuint, 2),
+  JS_CFUNC_MAGIC_DEF("createFramebuffer", 0, direct_GLuint_void, 2),
+  JS_CFUNC_MAGIC_DEF("bindFramebuffer", 2, direct_void_GLint_GLint, 2),
+  JS_CFUNC_MAGIC_DEF("framebufferTexture2D", 5, direct_void_GLenum_GLenum_GLint_GLint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("createBuffer", 0, direct_GLuint_void, 3),
+  JS_CFUNC_MAGIC_DEF("bindBuffer", 2, direct_void_GLenum_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("bufferData", 3, direct_GLboolean_GLint_WebGLBufferData_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("bufferSubData", 3, direct_void_GLenum_GLint_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("enable", 1, direct_void_GLenum, 2),
+  JS_CFUNC_MAGIC_DEF("blendEquation", 1, direct_void_GLenum, 3),
+  JS_CFUNC_MAGIC_DEF("blendFunc", 2, direct_void_GLenum_GLenum, 1),
+  JS_CFUNC_MAGIC_DEF("enableVertexAttribArray", 1, direct_void_GLuint, 3),
+  JS_CFUNC_MAGIC_DEF("vertexAttribPointer", 6, direct_void_GLint_GLint_GLenum_GLboolean_GLint_qjs_size_t, 0),
+  JS_CFUNC_MAGIC_DEF("activeTexture", 1, direct_void_GLenum, 4),
+  JS_CFUNC_MAGIC_DEF("drawElements", 4, direct_void_GLenum_GLint_GLenum_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("flush", 0, direct_void_void, 1),
+  JS_CFUNC_MAGIC_DEF("finish", 0, direct_void_void, 2),
+  JS_CFUNC_MAGIC_DEF("vertexAttrib1f", 2, direct_void_GLuint_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("vertexAttrib2f", 3, direct_void_GLuint_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("vertexAttrib3f", 4, direct_void_GLuint_GLfloat_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("vertexAttrib4f", 5, direct_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("blendColor", 4, direct_void_GLclampf_GLclampf_GLclampf_GLclampf, 0),
+  JS_CFUNC_MAGIC_DEF("blendEquationSeparate", 2, direct_void_GLenum_GLenum, 2),
+  JS_CFUNC_MAGIC_DEF("blendFuncSeparate", 4, direct_void_GLenum_GLenum_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("clearStencil", 1, direct_void_GLint, 1),
+  JS_CFUNC_MAGIC_DEF("colorMask", 4, direct_void_GLboolean_GLboolean_GLboolean_GLboolean, 0),
+  JS_CFUNC_MAGIC_DEF("copyTexImage2D", 8, direct_GLboolean_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("copyTexSubImage2D", 8, direct_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei, 0),
+  JS_CFUNC_MAGIC_DEF("compressedTexImage2D", 7, direct_GLboolean_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("compressedTexSubImage2D", 8, direct_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("cullFace", 1, direct_void_GLenum, 5),
+  JS_CFUNC_MAGIC_DEF("depthMask", 1, direct_void_GLboolean, 0),
+  JS_CFUNC_MAGIC_DEF("depthRange", 2, direct_void_GLclampf_GLclampf, 0),
+  JS_CFUNC_MAGIC_DEF("disableVertexAttribArray", 1, direct_void_GLuint, 4),
+  JS_CFUNC_MAGIC_DEF("hint", 2, direct_void_GLenum_GLenum, 3),
+  JS_CFUNC_MAGIC_DEF("isEnabled", 1, direct_bool_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("lineWidth", 1, direct_void_GLfloat, 1),
+  JS_CFUNC_MAGIC_DEF("polygonOffset", 2, direct_void_GLfloat_GLfloat, 0),
+  JS_CFUNC_MAGIC_DEF("scissor", 4, direct_void_GLint_GLint_GLsizei_GLsizei, 1),
+  JS_CFUNC_MAGIC_DEF("stencilFunc", 3, direct_void_GLenum_GLint_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("stencilFuncSeparate", 4, direct_void_GLenum_GLenum_GLint_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("stencilMask", 1, direct_void_GLuint, 5),
+  JS_CFUNC_MAGIC_DEF("stencilMaskSeparate", 2, direct_void_GLenum_GLuint, 1),
+  JS_CFUNC_MAGIC_DEF("stencilOp", 3, direct_void_GLenum_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("stencilOpSeparate", 4, direct_void_GLenum_GLenum_GLenum_GLenum, 1),
+  JS_CFUNC_MAGIC_DEF("bindRenderbuffer", 2, direct_void_GLenum_GLuint, 2),
+  JS_CFUNC_MAGIC_DEF("createRenderbuffer", 0, direct_GLuint_void, 4),
+  JS_CFUNC_MAGIC_DEF("deleteBuffer", 1, direct_void_GLuint, 6),
+  JS_CFUNC_MAGIC_DEF("deleteFramebuffer", 1, direct_void_GLuint, 7),
+  JS_CFUNC_MAGIC_DEF("deleteProgram", 1, direct_void_GLuint, 8),
+  JS_CFUNC_MAGIC_DEF("deleteRenderbuffer", 1, direct_void_GLuint, 9),
+  JS_CFUNC_MAGIC_DEF("deleteShader", 1, direct_void_GLuint, 10),
+  JS_CFUNC_MAGIC_DEF("deleteTexture", 1, direct_void_GLuint, 11),
+  JS_CFUNC_MAGIC_DEF("detachShader", 2, direct_void_GLuint_GLuint, 1),
+  JS_CFUNC_MAGIC_DEF("framebufferRenderbuffer", 4, direct_void_GLenum_GLenum_GLenum_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("getVertexAttribOffset", 2, direct_GLuint_GLuint_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("isBuffer", 1, direct_GLboolean_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("isFramebuffer", 1, direct_GLboolean_GLuint, 1),
+  JS_CFUNC_MAGIC_DEF("isProgram", 1, direct_GLboolean_GLuint, 2),
+  JS_CFUNC_MAGIC_DEF("isRenderbuffer", 1, direct_GLboolean_GLuint, 3),
+  JS_CFUNC_MAGIC_DEF("isShader", 1, direct_GLboolean_GLuint, 4),
+  JS_CFUNC_MAGIC_DEF("isTexture", 1, direct_GLboolean_GLuint, 5),
+  JS_CFUNC_MAGIC_DEF("renderbufferStorage", 4, direct_GLboolean_GLenum_GLenum_GLsizei_GLsizei, 0),
+  JS_CFUNC_MAGIC_DEF("validateProgram", 1, direct_void_GLuint, 12),
+  JS_CFUNC_MAGIC_DEF("texSubImage2D", 9, direct_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("readPixels", 7, direct_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("_readPixelsAsync", 6, direct_GLuint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("_readPixelsAsyncResult", 2, direct_GLint_GLuint_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("_decodeImage", 4, direct_GLuint_WebGLByteArray_GLenum_GLboolean_GLboolean, 0),
+  JS_CFUNC_MAGIC_DEF("_texImage2DDecoded", 4, direct_GLboolean_GLuint_GLuint_GLenum_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("_releaseDecodedImage", 1, direct_void_GLuint, 13),
+  JS_CFUNC_MAGIC_DEF("_enqueueTexImage2D", 8, direct_GLuint_GLenum_GLint_GLenum_GLsizei_GLsizei_GLenum_GLenum_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("_enqueueBufferData", 3, direct_GLuint_GLenum_WebGLByteArray_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("_setUploadBudget", 1, direct_void_GLint, 2),
+  JS_CFUNC_MAGIC_DEF("_processUploads", 0, direct_void_void, 3),
+  JS_CFUNC_MAGIC_DEF("_createAtlas", 5, direct_GLuint_GLsizei_GLsizei_GLint_GLenum_GLboolean, 0),
+  JS_CFUNC_MAGIC_DEF("_atlasAddPage", 2, direct_GLboolean_GLuint_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("_deleteAtlas", 1, direct_void_GLuint, 14),
+  JS_CFUNC_MAGIC_DEF("_manageTexture", 2, direct_void_GLuint_GLboolean, 0),
+  JS_CFUNC_MAGIC_DEF("_unmanageTexture", 1, direct_void_GLuint, 15),
+  JS_CFUNC_MAGIC_DEF("_textureEvicted", 1, direct_GLboolean_GLuint, 6),
+  JS_CFUNC_MAGIC_DEF("_texImage2DFloat32", 8, direct_GLboolean_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLenum_WebGLByteArray, 0),
+  JS_CFUNC_MAGIC_DEF("_texSubImage2DFloat32", 8, direct_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_WebGLByteArray, 1),
+  JS_CFUNC_MAGIC_DEF("getBufferParameter", 2, direct_GLint_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("getFramebufferAttachmentParameter", 3, direct_GLint_GLenum_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("getRenderbufferParameter", 2, direct_int_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("checkFramebufferStatus", 1, direct_GLenum_GLenum, 0),
+  JS_CFUNC_MAGIC_DEF("frontFace", 1, direct_void_GLenum, 6),
+  JS_CFUNC_MAGIC_DEF("sampleCoverage", 2, direct_void_GLclampf_GLboolean, 0),
+  JS_CFUNC_MAGIC_DEF("destroy", 0, direct_void_void, 4),
+  JS_CFUNC_MAGIC_DEF("createVertexArrayOES", 0, direct_GLuint_void, 5),
+  JS_CFUNC_MAGIC_DEF("deleteVertexArrayOES", 1, direct_void_GLuint, 16),
+  JS_CFUNC_MAGIC_DEF("isVertexArrayOES", 1, direct_bool_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("bindVertexArrayOES", 1, direct_void_GLuint, 17),
+  JS_CFUNC_MAGIC_DEF("_isRobustAccess", 0, direct_bool_void, 0),
+  JS_CFUNC_MAGIC_DEF("_deferErrors", 0, direct_bool_void, 1),
+  JS_CFUNC_MAGIC_DEF("_setDrawingBuffer", 1, direct_void_GLuint, 18),
+  JS_CFUNC_MAGIC_DEF("_setDrawingBufferSize", 2, direct_void_GLsizei_GLsizei, 0),
+  JS_CFUNC_MAGIC_DEF("_setDrawingBufferStorage", 2, direct_void_GLuint_GLuint, 2),
+  JS_CFUNC_MAGIC_DEF("_framebufferAttachment", 5, direct_void_GLuint_GLenum_GLenum_GLuint_GLint, 0),
+  JS_CFUNC_MAGIC_DEF("_framebufferStatus", 1, direct_GLenum_GLuint, 0),
+  JS_CFUNC_MAGIC_DEF("_setArenaSize", 1, direct_void_qjs_size_t, 0),
+  JS_CFUNC_MAGIC_DEF("_takeMemoryBudgetCrossed", 0, direct_GLboolean_void, 0),
+  JS_CFUNC_MAGIC_DEF("setError", 1, direct_void_GLenum, 7),
+};
+
+#endif
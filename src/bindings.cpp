@@ -14,9 +14,127 @@
 static qjs::ContextContainer contextContainer;
 static bool alreadyLoaded = false;
 
+/* Borrows the bytes of an ArrayBuffer or any ArrayBufferView, without copying */
+static int getArrayView(JSContext* ctx, JSValueConst value, WebGLArrayView* view)
+{
+	size_t byteOffset = 0, byteLength = 0, bytesPerElement = 0, size = 0;
+	bool whole = false;
+	JSValue buffer = JS_GetTypedArrayBuffer(ctx, value, &byteOffset, &byteLength, &bytesPerElement);
+	if (JS_IsException(buffer)) {
+		//DataView or ArrayBuffer, quickjs only exposes the layout of typed arrays
+		JS_FreeValue(ctx, JS_GetException(ctx));
+		buffer = JS_GetPropertyStr(ctx, value, "buffer");
+		if (JS_IsException(buffer)) {
+			return -1;
+		}
+		if (JS_IsUndefined(buffer)) {
+			buffer = JS_DupValue(ctx, value);
+			whole = true;
+		} else {
+			uint64_t offset = 0, length = 0;
+			JSValue property = JS_GetPropertyStr(ctx, value, "byteOffset");
+			int status = JS_ToIndex(ctx, &offset, property);
+			JS_FreeValue(ctx, property);
+			if (!status) {
+				property = JS_GetPropertyStr(ctx, value, "byteLength");
+				status = JS_ToIndex(ctx, &length, property);
+				JS_FreeValue(ctx, property);
+			}
+			if (status) {
+				JS_FreeValue(ctx, buffer);
+				return -1;
+			}
+			byteOffset = static_cast<size_t>(offset);
+			byteLength = static_cast<size_t>(length);
+		}
+	}
+
+	//The view keeps the buffer alive, the pointer stays valid for the call
+	uint8_t* bytes = JS_GetArrayBuffer(ctx, &size, buffer);
+	JS_FreeValue(ctx, buffer);
+	if (!bytes) {
+		return -1;
+	}
+	if (whole) {
+		byteLength = size;
+	} else if (byteOffset > size || byteLength > size - byteOffset) {
+		JS_ThrowRangeError(ctx, "invalid ArrayBufferView");
+		return -1;
+	}
+	view->bytes = bytes + byteOffset;
+	view->length = byteLength;
+	return 0;
+}
+
+/* bufferData takes a byte size or the data itself */
+static int getBufferSource(JSContext* ctx, JSValueConst value, WebGLBufferSource* source)
+{
+	if (JS_IsNumber(value)) {
+		int64_t size;
+		if (JS_ToInt64(ctx, &size, value)) {
+			return -1;
+		}
+		source->bytes = nullptr;
+		source->size = static_cast<GLsizeiptr>(size);
+		return 0;
+	}
+	WebGLArrayView view;
+	if (getArrayView(ctx, value, &view)) {
+		return -1;
+	}
+	source->bytes = view.bytes;
+	source->size = static_cast<GLsizeiptr>(view.length);
+	return 0;
+}
+
 /* Bindings for complex objects */
 namespace qjs
 {
+	template <>
+	struct js_traits<WebGLArrayView>
+	{
+		static WebGLArrayView unwrap(JSContext * ctx, JSValueConst value)
+		{
+			WebGLArrayView view;
+			if (getArrayView(ctx, value, &view)) {
+				throw exception{ctx};
+			}
+			return view;
+		}
+	};
+
+	template <>
+	struct js_traits<WebGLBufferSource>
+	{
+		static WebGLBufferSource unwrap(JSContext * ctx, JSValueConst value)
+		{
+			WebGLBufferSource source;
+			if (getBufferSource(ctx, value, &source)) {
+				throw exception{ctx};
+			}
+			return source;
+		}
+	};
+
+	template <typename T>
+	struct js_traits<WebGLScratchArray<T>>
+	{
+		static JSValue wrap(JSContext * ctx, const WebGLScratchArray<T>& array) noexcept
+		{
+			JSValue result = JS_NewArray(ctx);
+			if (JS_IsException(result)) {
+				return result;
+			}
+			for (size_t i = 0; i < array.length; ++i) {
+				JS_SetPropertyUint32(ctx, result, static_cast<uint32_t>(i), js_traits<T>::wrap(ctx, array.values[i]));
+			}
+			if (array.arena) {
+				array.arena->release(array.mark);
+			}
+			return result;
+		}
+	};
+
 	template <>
 	struct js_traits<WebGLActiveElementContent>
 	{
@@ -106,6 +224,86 @@ namespace qjs
 	};
 }
 
+#ifdef DIRECT_BINDINGS
+/* Direct bindings for the methods taking numbers and buffers and returning numbers */
+static inline WebGLRenderingContext* directContext(JSContext* ctx, JSValueConst this_val)
+{
+	auto* context = static_cast<std::shared_ptr<WebGLRenderingContext>*>(JS_GetOpaque2(
+		ctx, this_val, qjs::js_traits<std::shared_ptr<WebGLRenderingContext>>::QJSClassId));
+	return context ? context->get() : nullptr;
+}
+
+template <typename T>
+static inline int directArg(JSContext* ctx, JSValueConst value, T* result)
+{
+	const int tag = JS_VALUE_GET_TAG(value);
+	if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, GLboolean>) {
+		const int flag = JS_ToBool(ctx, value);
+		*result = static_cast<T>(flag > 0);
+		return flag < 0 ? -1 : 0;
+	} else if constexpr (std::is_floating_point_v<T>) {
+		if (JS_TAG_IS_FLOAT64(tag)) {
+			*result = static_cast<T>(JS_VALUE_GET_FLOAT64(value));
+			return 0;
+		} else if (tag == JS_TAG_INT) {
+			*result = static_cast<T>(JS_VALUE_GET_INT(value));
+			return 0;
+		}
+		double number;
+		if (JS_ToFloat64(ctx, &number, value)) {
+			return -1;
+		}
+		*result = static_cast<T>(number);
+		return 0;
+	} else {
+		//Unsigned values wrap around like JS_ToUint32
+		if (tag == JS_TAG_INT) {
+			*result = static_cast<T>(JS_VALUE_GET_INT(value));
+			return 0;
+		}
+		int32_t number;
+		if (JS_ToInt32(ctx, &number, value)) {
+			return -1;
+		}
+		*result = static_cast<T>(number);
+		return 0;
+	}
+}
+
+//Views and bufferData sources, null and undefined pass no data
+static inline int directArg(JSContext* ctx, JSValueConst value, WebGLByteArray* result)
+{
+	if (JS_IsNull(value) || JS_IsUndefined(value)) {
+		result->reset();
+		return 0;
+	}
+	return getArrayView(ctx, value, &result->emplace());
+}
+
+static inline int directArg(JSContext* ctx, JSValueConst value, WebGLBufferData* result)
+{
+	if (JS_IsNull(value) || JS_IsUndefined(value)) {
+		result->reset();
+		return 0;
+	}
+	return getBufferSource(ctx, value, &result->emplace());
+}
+
+template <typename T>
+static inline JSValue directReturn(JSContext* ctx, T value)
+{
+	if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, GLboolean>) {
+		return JS_NewBool(ctx, value);
+	} else if constexpr (std::is_signed_v<T>) {
+		return JS_NewInt32(ctx, value);
+	} else {
+		return JS_NewInt64(ctx, value);
+	}
+}
+
+#include "bindings-direct.h"
+#endif
+
 extern "C"
 {
 
@@ -122,7 +320,7 @@ JSModuleDef* js_init_module_qjsc_quickjs_gl_bindings(JSContext* ctx, const char*
 {
   bindingsModule
     .class_<WebGLRenderingContext>("QJSWebGLRenderingContext")
-      .constructor<int, int, bool, bool, bool, bool, bool, bool, bool, bool, std::optional<intptr_t>, qjs::Value>()
+      .constructor<int, int, bool, bool, bool, bool, bool, bool, bool, bool, bool, std::optional<intptr_t>, qjs::Value>()
       /* WebGL methods */
     	.fun<&WebGLRenderingContext::DrawArraysInstanced>("_drawArraysInstanced")
     	.fun<&WebGLRenderingContext::DrawElementsInstanced>("_drawElementsInstanced")
@@ -139,6 +337,14 @@ JSModuleDef* js_init_module_qjsc_quickjs_gl_bindings(JSContext* ctx, const char*
     	.fun<&WebGLRenderingContext::Uniform2i>("uniform2i")
     	.fun<&WebGLRenderingContext::Uniform3i>("uniform3i")
     	.fun<&WebGLRenderingContext::Uniform4i>("uniform4i")
+    	.fun<&WebGLRenderingContext::Uniform1fv>("uniform1fv")
+    	.fun<&WebGLRenderingContext::Uniform2fv>("uniform2fv")
+    	.fun<&WebGLRenderingContext::Uniform3fv>("uniform3fv")
+    	.fun<&WebGLRenderingContext::Uniform4fv>("uniform4fv")
+    	.fun<&WebGLRenderingContext::Uniform1iv>("uniform1iv")
+    	.fun<&WebGLRenderingContext::Uniform2iv>("uniform2iv")
+    	.fun<&WebGLRenderingContext::Uniform3iv>("uniform3iv")
+    	.fun<&WebGLRenderingContext::Uniform4iv>("uniform4iv")
     	.fun<&WebGLRenderingContext::PixelStorei>("pixelStorei")
     	.fun<&WebGLRenderingContext::BindAttribLocation>("bindAttribLocation")
     	.fun<&WebGLRenderingContext::GetError>("getError")
@@ -197,6 +403,8 @@ JSModuleDef* js_init_module_qjsc_quickjs_gl_bindings(JSContext* ctx, const char*
     	.fun<&WebGLRenderingContext::ColorMask>("colorMask")
     	.fun<&WebGLRenderingContext::CopyTexImage2D>("copyTexImage2D")
     	.fun<&WebGLRenderingContext::CopyTexSubImage2D>("copyTexSubImage2D")
+    	.fun<&WebGLRenderingContext::CompressedTexImage2D>("compressedTexImage2D")
+    	.fun<&WebGLRenderingContext::CompressedTexSubImage2D>("compressedTexSubImage2D")
     	.fun<&WebGLRenderingContext::CullFace>("cullFace")
     	.fun<&WebGLRenderingContext::DepthMask>("depthMask")
     	.fun<&WebGLRenderingContext::DepthRange>("depthRange")
@@ -234,11 +442,34 @@ JSModuleDef* js_init_module_qjsc_quickjs_gl_bindings(JSContext* ctx, const char*
     	.fun<&WebGLRenderingContext::ValidateProgram>("validateProgram")
     	.fun<&WebGLRenderingContext::TexSubImage2D>("texSubImage2D")
     	.fun<&WebGLRenderingContext::ReadPixels>("readPixels")
+    	.fun<&WebGLRenderingContext::ReadPixelsAsync>("_readPixelsAsync")
+    	.fun<&WebGLRenderingContext::ReadPixelsAsyncResult>("_readPixelsAsyncResult")
+    	.fun<&WebGLRenderingContext::DecodeImage>("_decodeImage")
+    	.fun<&WebGLRenderingContext::GetDecodedImage>("_getDecodedImage")
+    	.fun<&WebGLRenderingContext::TexImage2DDecoded>("_texImage2DDecoded")
+    	.fun<&WebGLRenderingContext::ReleaseDecodedImage>("_releaseDecodedImage")
+    	.fun<&WebGLRenderingContext::EnqueueTexImage2D>("_enqueueTexImage2D")
+    	.fun<&WebGLRenderingContext::EnqueueBufferData>("_enqueueBufferData")
+    	.fun<&WebGLRenderingContext::SetUploadBudget>("_setUploadBudget")
+    	.fun<&WebGLRenderingContext::ProcessUploads>("_processUploads")
+    	.fun<&WebGLRenderingContext::TakeFinishedUploads>("_takeFinishedUploads")
+    	.fun<&WebGLRenderingContext::CreateAtlas>("_createAtlas")
+    	.fun<&WebGLRenderingContext::AtlasAddPage>("_atlasAddPage")
+    	.fun<&WebGLRenderingContext::AtlasInsert>("_atlasInsert")
+    	.fun<&WebGLRenderingContext::DeleteAtlas>("_deleteAtlas")
+    	.fun<&WebGLRenderingContext::SetResidencyBudget>("_setResidencyBudget")
+    	.fun<&WebGLRenderingContext::ManageTexture>("_manageTexture")
+    	.fun<&WebGLRenderingContext::UnmanageTexture>("_unmanageTexture")
+    	.fun<&WebGLRenderingContext::TextureEvicted>("_textureEvicted")
+    	.fun<&WebGLRenderingContext::GetResidencyStats>("_getResidencyStats")
+    	.fun<&WebGLRenderingContext::TexImage2DFloat32>("_texImage2DFloat32")
+    	.fun<&WebGLRenderingContext::TexSubImage2DFloat32>("_texSubImage2DFloat32")
     	.fun<&WebGLRenderingContext::GetTexParameter>("getTexParameter")
     	.fun<&WebGLRenderingContext::GetActiveAttrib>("getActiveAttrib")
     	.fun<&WebGLRenderingContext::GetActiveUniform>("getActiveUniform")
     	.fun<&WebGLRenderingContext::GetAttachedShaders>("getAttachedShaders")
     	.fun<&WebGLRenderingContext::GetParameter>("getParameter")
+    	.fun<&WebGLRenderingContext::GetParameterInto>("getParameterInto")
     	.fun<&WebGLRenderingContext::GetBufferParameter>("getBufferParameter")
     	.fun<&WebGLRenderingContext::GetFramebufferAttachmentParameter>("getFramebufferAttachmentParameter")
     	.fun<&WebGLRenderingContext::GetProgramInfoLog>("getProgramInfoLog")
@@ -257,6 +488,22 @@ JSModuleDef* js_init_module_qjsc_quickjs_gl_bindings(JSContext* ctx, const char*
     	.fun<&WebGLRenderingContext::DeleteVertexArrayOES>("deleteVertexArrayOES")
     	.fun<&WebGLRenderingContext::IsVertexArrayOES>("isVertexArrayOES")
     	.fun<&WebGLRenderingContext::BindVertexArrayOES>("bindVertexArrayOES")
+    	.fun<&WebGLRenderingContext::Submit>("_submit")
+    	.fun<&WebGLRenderingContext::IsRobustAccess>("_isRobustAccess")
+    	.fun<&WebGLRenderingContext::DeferErrors>("_deferErrors")
+    	.fun<&WebGLRenderingContext::EnableExtension>("_enableExtension")
+    	.fun<&WebGLRenderingContext::SetDrawingBuffer>("_setDrawingBuffer")
+    	.fun<&WebGLRenderingContext::SetDrawingBufferSize>("_setDrawingBufferSize")
+    	.fun<&WebGLRenderingContext::SetDrawingBufferStorage>("_setDrawingBufferStorage")
+    	.fun<&WebGLRenderingContext::FramebufferAttachment>("_framebufferAttachment")
+    	.fun<&WebGLRenderingContext::FramebufferStatus>("_framebufferStatus")
+    	.fun<&WebGLRenderingContext::GetUniformStats>("_getUniformStats")
+    	.fun<&WebGLRenderingContext::SetArenaSize>("_setArenaSize")
+    	.fun<&WebGLRenderingContext::GetArenaStats>("_getArenaStats")
+    	.fun<&WebGLRenderingContext::GetMemoryStats>("_getMemoryStats")
+    	.fun<&WebGLRenderingContext::GetObjectMemory>("_getObjectMemory")
+    	.fun<&WebGLRenderingContext::SetMemoryBudget>("_setMemoryBudget")
+    	.fun<&WebGLRenderingContext::TakeMemoryBudgetCrossed>("_takeMemoryBudgetCrossed")
       	
 		.fun("NO_ERROR", GL_NO_ERROR)
   		.fun("INVALID_ENUM", GL_INVALID_ENUM)
@@ -562,12 +809,24 @@ JSModuleDef* js_init_module_qjsc_quickjs_gl_bindings(JSContext* ctx, const char*
   		.fun("VERSION", 0x1F02)
   		.fun("IMPLEMENTATION_COLOR_READ_TYPE", 0x8B9A)
   		.fun("IMPLEMENTATION_COLOR_READ_FORMAT", 0x8B9B)
+
+      	// Non-standard readPixels options
+  		.fun("PACK_REVERSE_ROW_ORDER_ANGLE", 0x93A4)
+  		.fun("BGRA_EXT", 0x80E1)
   
   	  	//Export helper methods for clean up and error handling
 		.static_fun<&WebGLRenderingContext::DisposeAll>("cleanup")
     	.fun<&WebGLRenderingContext::SetError>("setError")
 	;
 }
+
+#ifdef DIRECT_BINDINGS
+  //Replace the quickjspp wrappers of these methods
+  JSValue prototype = JS_GetClassProto(ctx, qjs::js_traits<std::shared_ptr<WebGLRenderingContext>>::QJSClassId);
+  JS_SetPropertyFunctionList(ctx, prototype, DIRECT_BINDINGS, sizeof(DIRECT_BINDINGS) / sizeof(DIRECT_BINDINGS[0]));
+  JS_FreeValue(ctx, prototype);
+#endif
+
 	alreadyLoaded = true;
 	return bindingsModule.m;	
 }
@@ -0,0 +1,119 @@
+#include <cstring>
+
+#include "decoder.h"
+#include "kernels.h"
+
+#ifdef WEBGL_IMAGE_DECODER
+//Formats assets ship in, the others only grow the binary
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_BMP
+#define STBI_ONLY_TGA
+#define STBI_NO_STDIO
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#endif
+
+WebGLImageDecoder::WebGLImageDecoder()
+    : stopping(false) {
+  thread = std::thread(&WebGLImageDecoder::run, this);
+}
+
+WebGLImageDecoder::~WebGLImageDecoder() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    //Images still queued are dropped, nobody waits for them anymore
+    for(auto& image : queue) {
+      image->status.store(WEBGL_DECODE_FAILED, std::memory_order_release);
+    }
+    queue.clear();
+  }
+  wake.notify_one();
+  thread.join();
+}
+
+bool WebGLImageDecoder::available() {
+#ifdef WEBGL_IMAGE_DECODER
+  return true;
+#else
+  return false;
+#endif
+}
+
+void WebGLImageDecoder::submit(std::shared_ptr<WebGLDecodedImage> image) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(std::move(image));
+  }
+  wake.notify_one();
+}
+
+void WebGLImageDecoder::run() {
+  for(;;) {
+    std::shared_ptr<WebGLDecodedImage> image;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this] { return stopping || !queue.empty(); });
+      if(stopping) {
+        break;
+      }
+      image = std::move(queue.front());
+      queue.pop_front();
+    }
+    decode(*image);
+  }
+}
+
+#ifdef WEBGL_IMAGE_DECODER
+static int formatChannels(GLenum format) {
+  switch(format) {
+    case GL_LUMINANCE:
+      return 1;
+    case GL_LUMINANCE_ALPHA:
+      return 2;
+    case GL_RGB:
+      return 3;
+    default:
+      return 4;
+  }
+}
+#endif
+
+void WebGLImageDecoder::decode(WebGLDecodedImage& image) {
+  int status = WEBGL_DECODE_FAILED;
+#ifdef WEBGL_IMAGE_DECODER
+  const int channels = formatChannels(image.format);
+  int width = 0, height = 0, sourceChannels = 0;
+  stbi_uc* decoded = stbi_load_from_memory(
+    image.encoded.data(), static_cast<int>(image.encoded.size()),
+    &width, &height, &sourceChannels, channels);
+  if(decoded) {
+    //Rows are copied to the unpack alignment, bottom-up when flipping, and
+    //premultiplied on the way when the image has alpha
+    const size_t rowSize = size_t(width) * channels;
+    const size_t rowStride = image.alignment > 1 ?
+      (rowSize + image.alignment - 1) / image.alignment * image.alignment : rowSize;
+    image.pixels.resize(rowStride * height);
+    for(int row = 0; row < height; ++row) {
+      const uint8_t* src = decoded + size_t(image.flipY ? height - 1 - row : row) * rowSize;
+      uint8_t* dst = image.pixels.data() + size_t(row) * rowStride;
+      if(image.premultiply && channels == 4) {
+        premultiplyRGBA8(dst, src, width);
+      } else if(image.premultiply && channels == 2) {
+        premultiplyLA8(dst, src, width);
+      } else {
+        memcpy(dst, src, rowSize);
+      }
+    }
+    stbi_image_free(decoded);
+
+    image.width = width;
+    image.height = height;
+    status = WEBGL_DECODE_READY;
+  }
+#endif
+  //The encoded bytes are not needed anymore
+  std::vector<uint8_t>().swap(image.encoded);
+  image.status.store(status, std::memory_order_release);
+}
@@ -0,0 +1,68 @@
+#ifndef DECODER_H_
+#define DECODER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __vita__
+#include "platform/vita/egl.h"
+#else
+#include <GLES2/gl2.h>
+#endif
+
+enum WebGLDecodeStatus {
+  WEBGL_DECODE_PENDING,
+  WEBGL_DECODE_READY,
+  WEBGL_DECODE_FAILED
+};
+
+// Encoded image queued by texImage2DFromEncoded and the rows it decodes to.
+// The format, row alignment, flip and premultiplication are the ones of the
+// upload, pixels can be handed to glTexImage2D as they are
+struct WebGLDecodedImage {
+  std::vector<uint8_t> encoded;
+  GLenum  format      = GL_RGBA;
+  GLint   alignment   = 4;
+  bool    flipY       = false;
+  bool    premultiply = false;
+  GLsizei width       = 0;
+  GLsizei height      = 0;
+  std::vector<uint8_t> pixels;
+  std::atomic<int> status{WEBGL_DECODE_PENDING};
+};
+
+// Thread decoding PNG, JPEG, BMP and TGA images with stb_image, one at a time
+// in submission order. Flipping and premultiplication are done while the
+// decoded rows are copied out, so the GL thread only uploads them
+class WebGLImageDecoder {
+public:
+  WebGLImageDecoder();
+  ~WebGLImageDecoder();
+
+  WebGLImageDecoder(const WebGLImageDecoder&) = delete;
+  WebGLImageDecoder& operator=(const WebGLImageDecoder&) = delete;
+
+  // False when the library was built without stb_image
+  static bool available();
+
+  void submit(std::shared_ptr<WebGLDecodedImage> image);
+
+private:
+  void run();
+  static void decode(WebGLDecodedImage& image);
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<std::shared_ptr<WebGLDecodedImage>> queue;
+  bool stopping;
+  std::thread thread;
+};
+
+#endif
@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <cstring>
+
+#include "kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define KERNELS_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+uint32_t maxIndexU8(const uint8_t* indices, size_t count) {
+  size_t i = 0;
+  uint32_t result = 0;
+
+#if defined(KERNELS_SSE2)
+  if(count >= 16) {
+    __m128i vmax = _mm_setzero_si128();
+    for(; i + 16 <= count; i += 16) {
+      vmax = _mm_max_epu8(vmax, _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)));
+    }
+    alignas(16) uint8_t lanes[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), vmax);
+    result = *std::max_element(lanes, lanes + 16);
+  }
+#elif defined(KERNELS_NEON)
+  if(count >= 16) {
+    uint8x16_t vmax = vdupq_n_u8(0);
+    for(; i + 16 <= count; i += 16) {
+      vmax = vmaxq_u8(vmax, vld1q_u8(indices + i));
+    }
+    uint8_t lanes[16];
+    vst1q_u8(lanes, vmax);
+    result = *std::max_element(lanes, lanes + 16);
+  }
+#endif
+
+  for(; i < count; ++i) {
+    result = std::max<uint32_t>(result, indices[i]);
+  }
+  return result;
+}
+
+uint32_t maxIndexU16(const uint16_t* indices, size_t count) {
+  size_t i = 0;
+  uint32_t result = 0;
+
+#if defined(KERNELS_SSE2)
+  if(count >= 8) {
+    //SSE2 only has a signed 16-bit max, so bias the values into signed range
+    const __m128i bias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+    __m128i vmax = bias;
+    for(; i + 8 <= count; i += 8) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+      vmax = _mm_max_epi16(vmax, _mm_xor_si128(v, bias));
+    }
+    alignas(16) uint16_t lanes[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(vmax, bias));
+    result = *std::max_element(lanes, lanes + 8);
+  }
+#elif defined(KERNELS_NEON)
+  if(count >= 8) {
+    uint16x8_t vmax = vdupq_n_u16(0);
+    for(; i + 8 <= count; i += 8) {
+      vmax = vmaxq_u16(vmax, vld1q_u16(indices + i));
+    }
+    uint16_t lanes[8];
+    vst1q_u16(lanes, vmax);
+    result = *std::max_element(lanes, lanes + 8);
+  }
+#endif
+
+  for(; i < count; ++i) {
+    result = std::max<uint32_t>(result, indices[i]);
+  }
+  return result;
+}
+
+uint32_t maxIndexU32(const uint32_t* indices, size_t count) {
+  size_t i = 0;
+  uint32_t result = 0;
+
+#if defined(KERNELS_SSE2)
+  if(count >= 4) {
+    //No unsigned 32-bit compare either, bias and select with a mask
+    const __m128i bias = _mm_set1_epi32(static_cast<int32_t>(0x80000000));
+    __m128i vmax = bias;
+    for(; i + 4 <= count; i += 4) {
+      __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)), bias);
+      __m128i greater = _mm_cmpgt_epi32(v, vmax);
+      vmax = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, vmax));
+    }
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(vmax, bias));
+    result = *std::max_element(lanes, lanes + 4);
+  }
+#elif defined(KERNELS_NEON)
+  if(count >= 4) {
+    uint32x4_t vmax = vdupq_n_u32(0);
+    for(; i + 4 <= count; i += 4) {
+      vmax = vmaxq_u32(vmax, vld1q_u32(indices + i));
+    }
+    uint32_t lanes[4];
+    vst1q_u32(lanes, vmax);
+    result = *std::max_element(lanes, lanes + 4);
+  }
+#endif
+
+  for(; i < count; ++i) {
+    result = std::max(result, indices[i]);
+  }
+  return result;
+}
+
+//Nearest c * a / 255 with a multiply and shifts, exact for all 8-bit inputs
+static inline uint8_t mulDiv255(uint32_t c, uint32_t a) {
+  uint32_t t = c * a + 128;
+  return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+#if defined(KERNELS_SSE2)
+//Same rounding on eight 16-bit products
+static inline __m128i mulDiv255x8(__m128i c, __m128i a) {
+  __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+#elif defined(KERNELS_NEON)
+static inline uint8x8_t mulDiv255x8(uint8x8_t c, uint8x8_t a) {
+  uint16x8_t t = vmull_u8(c, a);
+  return vraddhn_u16(t, vrshrq_n_u16(t, 8));
+}
+#endif
+
+void premultiplyRGBA8(uint8_t* dst, const uint8_t* src, size_t count) {
+  size_t i = 0;
+
+#if defined(KERNELS_SSE2)
+  //Alpha lanes are multiplied by 255 so they come out unchanged
+  const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+  const __m128i opaque = _mm_and_si128(alphaLanes, _mm_set1_epi16(255));
+  const __m128i zero = _mm_setzero_si128();
+  for(; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    __m128i lo = _mm_unpacklo_epi8(v, zero);
+    __m128i hi = _mm_unpackhi_epi8(v, zero);
+    __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    alphaLo = _mm_or_si128(_mm_andnot_si128(alphaLanes, alphaLo), opaque);
+    alphaHi = _mm_or_si128(_mm_andnot_si128(alphaLanes, alphaHi), opaque);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(
+        mulDiv255x8(lo, alphaLo)
+      , mulDiv255x8(hi, alphaHi)));
+  }
+#elif defined(KERNELS_NEON)
+  for(; i + 8 <= count; i += 8) {
+    uint8x8x4_t v = vld4_u8(src + i * 4);
+    v.val[0] = mulDiv255x8(v.val[0], v.val[3]);
+    v.val[1] = mulDiv255x8(v.val[1], v.val[3]);
+    v.val[2] = mulDiv255x8(v.val[2], v.val[3]);
+    vst4_u8(dst + i * 4, v);
+  }
+#endif
+
+  for(; i < count; ++i) {
+    const uint8_t* pixel = src + i * 4;
+    uint8_t* out = dst + i * 4;
+    uint32_t a = pixel[3];
+    out[0] = mulDiv255(pixel[0], a);
+    out[1] = mulDiv255(pixel[1], a);
+    out[2] = mulDiv255(pixel[2], a);
+    out[3] = static_cast<uint8_t>(a);
+  }
+}
+
+void premultiplyLA8(uint8_t* dst, const uint8_t* src, size_t count) {
+  size_t i = 0;
+
+#if defined(KERNELS_SSE2)
+  const __m128i alphaLanes = _mm_set_epi16(-1, 0, -1, 0, -1, 0, -1, 0);
+  const __m128i opaque = _mm_and_si128(alphaLanes, _mm_set1_epi16(255));
+  const __m128i zero = _mm_setzero_si128();
+  for(; i + 8 <= count; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    __m128i lo = _mm_unpacklo_epi8(v, zero);
+    __m128i hi = _mm_unpackhi_epi8(v, zero);
+    __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+    __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+    alphaLo = _mm_or_si128(_mm_andnot_si128(alphaLanes, alphaLo), opaque);
+    alphaHi = _mm_or_si128(_mm_andnot_si128(alphaLanes, alphaHi), opaque);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_packus_epi16(
+        mulDiv255x8(lo, alphaLo)
+      , mulDiv255x8(hi, alphaHi)));
+  }
+#elif defined(KERNELS_NEON)
+  for(; i + 8 <= count; i += 8) {
+    uint8x8x2_t v = vld2_u8(src + i * 2);
+    v.val[0] = mulDiv255x8(v.val[0], v.val[1]);
+    vst2_u8(dst + i * 2, v);
+  }
+#endif
+
+  for(; i < count; ++i) {
+    uint32_t a = src[i * 2 + 1];
+    dst[i * 2] = mulDiv255(src[i * 2], a);
+    dst[i * 2 + 1] = static_cast<uint8_t>(a);
+  }
+}
+
+void premultiplyRGBA4444(uint16_t* dst, const uint16_t* src, size_t count) {
+  //Nearest c * a / 15 as ((c * a + 7) * 4370) >> 16, exact for 4-bit inputs
+  for(size_t i = 0; i < count; ++i) {
+    uint32_t v = src[i];
+    uint32_t a = v & 0xf;
+    uint32_t r = ((((v >> 12) & 0xf) * a + 7) * 4370) >> 16;
+    uint32_t g = ((((v >> 8) & 0xf) * a + 7) * 4370) >> 16;
+    uint32_t b = ((((v >> 4) & 0xf) * a + 7) * 4370) >> 16;
+    dst[i] = static_cast<uint16_t>((r << 12) | (g << 8) | (b << 4) | a);
+  }
+}
+
+void premultiplyRGBA5551(uint16_t* dst, const uint16_t* src, size_t count) {
+  //One alpha bit, transparent pixels lose their color
+  for(size_t i = 0; i < count; ++i) {
+    dst[i] = (src[i] & 1) ? src[i] : 0;
+  }
+}
+
+void premultiplyRGBA32F(float* dst, const float* src, size_t count) {
+  for(size_t i = 0; i < count * 4; i += 4) {
+    float a = src[i + 3];
+    dst[i] = src[i] * a;
+    dst[i + 1] = src[i + 1] * a;
+    dst[i + 2] = src[i + 2] * a;
+    dst[i + 3] = a;
+  }
+}
+
+void premultiplyLA32F(float* dst, const float* src, size_t count) {
+  for(size_t i = 0; i < count * 2; i += 2) {
+    float a = src[i + 1];
+    dst[i] = src[i] * a;
+    dst[i + 1] = a;
+  }
+}
+
+static inline uint16_t floatToHalf(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint32_t sign = (bits >> 16) & 0x8000;
+  const uint32_t abs = bits & 0x7fffffff;
+  if(abs >= 0x7f800000) {
+    //Infinity, or a NaN keeping the top of its payload and staying quiet
+    return static_cast<uint16_t>(sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 | ((abs >> 13) & 0x3ff) : 0));
+  }
+  if(abs >= 0x477ff000) {
+    //65520 and above round past the largest half
+    return static_cast<uint16_t>(sign | 0x7c00);
+  }
+  if(abs < 0x38800000) {
+    //Below the smallest normal half, the mantissa is shifted into a subnormal
+    if(abs < 0x33000000) {
+      return static_cast<uint16_t>(sign);
+    }
+    const uint32_t shift = 126 - (abs >> 23);
+    const uint32_t mantissa = (abs & 0x7fffff) | 0x800000;
+    uint32_t half = mantissa >> shift;
+    const uint32_t rest = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if(rest > halfway || (rest == halfway && (half & 1))) {
+      ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+  }
+  //Rebiased exponent, a carry out of the mantissa bumps it as it should
+  uint32_t half = (abs - 0x38000000) >> 13;
+  const uint32_t rest = abs & 0x1fff;
+  if(rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+    ++half;
+  }
+  return static_cast<uint16_t>(sign | half);
+}
+
+static inline float halfToFloat(uint16_t half) {
+  const uint32_t sign = uint32_t(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+  uint32_t bits;
+  if(exponent == 0x1f) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if(exponent != 0) {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  } else if(mantissa == 0) {
+    bits = sign;
+  } else {
+    //Subnormals are normalized
+    exponent = 113;
+    while(!(mantissa & 0x400)) {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void premultiplyRGBA16F(uint16_t* dst, const uint16_t* src, size_t count) {
+  for(size_t i = 0; i < count * 4; i += 4) {
+    float a = halfToFloat(src[i + 3]);
+    dst[i] = floatToHalf(halfToFloat(src[i]) * a);
+    dst[i + 1] = floatToHalf(halfToFloat(src[i + 1]) * a);
+    dst[i + 2] = floatToHalf(halfToFloat(src[i + 2]) * a);
+    dst[i + 3] = src[i + 3];
+  }
+}
+
+void premultiplyLA16F(uint16_t* dst, const uint16_t* src, size_t count) {
+  for(size_t i = 0; i < count * 2; i += 2) {
+    float a = halfToFloat(src[i + 1]);
+    dst[i] = floatToHalf(halfToFloat(src[i]) * a);
+    dst[i + 1] = src[i + 1];
+  }
+}
+
+void convertFloat32ToFloat16(uint16_t* dst, const float* src, size_t count) {
+  size_t i = 0;
+
+#if defined(__F16C__)
+  for(; i + 8 <= count; i += 8) {
+    __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+  }
+#elif defined(KERNELS_NEON) && defined(__aarch64__)
+  for(; i + 4 <= count; i += 4) {
+    vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+#endif
+
+  for(; i < count; ++i) {
+    dst[i] = floatToHalf(src[i]);
+  }
+}
+
+void convertRGBAToRGB(uint8_t* dst, const uint8_t* src, size_t count) {
+  size_t i = 0;
+
+#if defined(KERNELS_NEON)
+  for(; i + 16 <= count; i += 16) {
+    uint8x16x4_t v = vld4q_u8(src + i * 4);
+    uint8x16x3_t rgb = {{ v.val[0], v.val[1], v.val[2] }};
+    vst3q_u8(dst + i * 3, rgb);
+  }
+#endif
+
+  //SSE2 has no byte shuffle, the compiler does better with the plain loop
+  for(; i < count; ++i) {
+    dst[i * 3] = src[i * 4];
+    dst[i * 3 + 1] = src[i * 4 + 1];
+    dst[i * 3 + 2] = src[i * 4 + 2];
+  }
+}
+
+void convertRGBAToBGRA(uint8_t* dst, const uint8_t* src, size_t count) {
+  size_t i = 0;
+
+#if defined(KERNELS_SSE2)
+  //Swap the red and blue bytes of each 32-bit pixel with shifts and masks
+  const __m128i greenAlpha = _mm_set1_epi32(static_cast<int32_t>(0xff00ff00));
+  const __m128i low = _mm_set1_epi32(0xff);
+  for(; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    __m128i red = _mm_slli_epi32(_mm_and_si128(v, low), 16);
+    __m128i blue = _mm_and_si128(_mm_srli_epi32(v, 16), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4),
+      _mm_or_si128(_mm_and_si128(v, greenAlpha), _mm_or_si128(red, blue)));
+  }
+#elif defined(KERNELS_NEON)
+  for(; i + 16 <= count; i += 16) {
+    uint8x16x4_t v = vld4q_u8(src + i * 4);
+    uint8x16_t red = v.val[0];
+    v.val[0] = v.val[2];
+    v.val[2] = red;
+    vst4q_u8(dst + i * 4, v);
+  }
+#endif
+
+  for(; i < count; ++i) {
+    dst[i * 4] = src[i * 4 + 2];
+    dst[i * 4 + 1] = src[i * 4 + 1];
+    dst[i * 4 + 2] = src[i * 4];
+    dst[i * 4 + 3] = src[i * 4 + 3];
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef KERNELS_H_
+#define KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Pixel and index processing loops shared by the rendering context.
+// They are vectorized with SSE2 or NEON when the target supports it and
+// fall back to plain C++ otherwise.
+
+//Largest value in an index array (0 for empty arrays)
+uint32_t maxIndexU8(const uint8_t* indices, size_t count);
+uint32_t maxIndexU16(const uint16_t* indices, size_t count);
+uint32_t maxIndexU32(const uint32_t* indices, size_t count);
+
+//Alpha premultiplication of a row of pixels from src to dst, which may be the
+//same row. 8-bit channels are rounded to the nearest c * a / 255.
+void premultiplyRGBA8(uint8_t* dst, const uint8_t* src, size_t count);
+void premultiplyLA8(uint8_t* dst, const uint8_t* src, size_t count);
+void premultiplyRGBA4444(uint16_t* dst, const uint16_t* src, size_t count);
+void premultiplyRGBA5551(uint16_t* dst, const uint16_t* src, size_t count);
+void premultiplyRGBA32F(float* dst, const float* src, size_t count);
+void premultiplyLA32F(float* dst, const float* src, size_t count);
+
+//Half float channels are premultiplied in single precision
+void premultiplyRGBA16F(uint16_t* dst, const uint16_t* src, size_t count);
+void premultiplyLA16F(uint16_t* dst, const uint16_t* src, size_t count);
+
+//Conversion of 32-bit floats to IEEE half floats, rounded to nearest even.
+//Out of range values become infinities and NaNs stay NaNs
+void convertFloat32ToFloat16(uint16_t* dst, const float* src, size_t count);
+
+//Conversions of a row of RGBA8 pixels read back from GL
+void convertRGBAToRGB(uint8_t* dst, const uint8_t* src, size_t count);
+void convertRGBAToBGRA(uint8_t* dst, const uint8_t* src, size_t count);
+
+#endif
@@ -19,6 +19,14 @@ void WebGLRenderingContext::initPointers(){
 	glUniform2i=reinterpret_cast<PFNGLUNIFORM2IPROC>(eglGetProcAddress("glUniform2i"));
 	glUniform3i=reinterpret_cast<PFNGLUNIFORM3IPROC>(eglGetProcAddress("glUniform3i"));
 	glUniform4i=reinterpret_cast<PFNGLUNIFORM4IPROC>(eglGetProcAddress("glUniform4i"));
+	glUniform1fv=reinterpret_cast<PFNGLUNIFORM1FVPROC>(eglGetProcAddress("glUniform1fv"));
+	glUniform2fv=reinterpret_cast<PFNGLUNIFORM2FVPROC>(eglGetProcAddress("glUniform2fv"));
+	glUniform3fv=reinterpret_cast<PFNGLUNIFORM3FVPROC>(eglGetProcAddress("glUniform3fv"));
+	glUniform4fv=reinterpret_cast<PFNGLUNIFORM4FVPROC>(eglGetProcAddress("glUniform4fv"));
+	glUniform1iv=reinterpret_cast<PFNGLUNIFORM1IVPROC>(eglGetProcAddress("glUniform1iv"));
+	glUniform2iv=reinterpret_cast<PFNGLUNIFORM2IVPROC>(eglGetProcAddress("glUniform2iv"));
+	glUniform3iv=reinterpret_cast<PFNGLUNIFORM3IVPROC>(eglGetProcAddress("glUniform3iv"));
+	glUniform4iv=reinterpret_cast<PFNGLUNIFORM4IVPROC>(eglGetProcAddress("glUniform4iv"));
 	glPixelStorei=reinterpret_cast<PFNGLPIXELSTOREIPROC>(eglGetProcAddress("glPixelStorei"));
 	glBindAttribLocation=reinterpret_cast<PFNGLBINDATTRIBLOCATIONPROC>(eglGetProcAddress("glBindAttribLocation"));
 	glDrawArrays=reinterpret_cast<PFNGLDRAWARRAYSPROC>(eglGetProcAddress("glDrawArrays"));
@@ -76,6 +84,8 @@ void WebGLRenderingContext::initPointers(){
 	glColorMask=reinterpret_cast<PFNGLCOLORMASKPROC>(eglGetProcAddress("glColorMask"));
 	glCopyTexImage2D=reinterpret_cast<PFNGLCOPYTEXIMAGE2DPROC>(eglGetProcAddress("glCopyTexImage2D"));
 	glCopyTexSubImage2D=reinterpret_cast<PFNGLCOPYTEXSUBIMAGE2DPROC>(eglGetProcAddress("glCopyTexSubImage2D"));
+	glCompressedTexImage2D=reinterpret_cast<PFNGLCOMPRESSEDTEXIMAGE2DPROC>(eglGetProcAddress("glCompressedTexImage2D"));
+	glCompressedTexSubImage2D=reinterpret_cast<PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC>(eglGetProcAddress("glCompressedTexSubImage2D"));
 	glCullFace=reinterpret_cast<PFNGLCULLFACEPROC>(eglGetProcAddress("glCullFace"));
 	glDepthMask=reinterpret_cast<PFNGLDEPTHMASKPROC>(eglGetProcAddress("glDepthMask"));
 	glDepthRangef=reinterpret_cast<PFNGLDEPTHRANGEFPROC>(eglGetProcAddress("glDepthRangef"));
@@ -153,6 +163,13 @@ void WebGLRenderingContext::initPointers(){
 	glGetVertexAttribPointerv=reinterpret_cast<PFNGLGETVERTEXATTRIBPOINTERVPROC>(eglGetProcAddress("glGetVertexAttribPointerv"));
 	glGetString=reinterpret_cast<PFNGLGETSTRINGPROC>(eglGetProcAddress("glGetString"));
 	glGetError=reinterpret_cast<PFNGLGETERRORPROC>(eglGetProcAddress("glGetError"));
+#if !defined(__vita__)
+	glDebugMessageCallbackKHR=reinterpret_cast<PFNGLDEBUGMESSAGECALLBACKKHRPROC>(eglGetProcAddress("glDebugMessageCallbackKHR"));
+	glDebugMessageControlKHR=reinterpret_cast<PFNGLDEBUGMESSAGECONTROLKHRPROC>(eglGetProcAddress("glDebugMessageControlKHR"));
+#else
+	glDebugMessageCallbackKHR=NULL;
+	glDebugMessageControlKHR=NULL;
+#endif
 #if !defined(__vita__)
 	glDrawBuffersEXT=reinterpret_cast<PFNGLDRAWBUFFERSEXTPROC>(eglGetProcAddress("glDrawBuffersEXT"));
 #endif
@@ -162,4 +179,18 @@ void WebGLRenderingContext::initPointers(){
 	glIsVertexArrayOES=reinterpret_cast<PFNGLISVERTEXARRAYOESPROC>(eglGetProcAddress("glIsVertexArrayOES"));
 #endif
 	glBindVertexArrayOES=reinterpret_cast<PFNGLBINDVERTEXARRAYOESPROC>(eglGetProcAddress("glBindVertexArrayOES"));
+#if !defined(__vita__)
+	//Core in GLES3, the extension entry points otherwise
+	glMapBufferRange=reinterpret_cast<PFNGLMAPBUFFERRANGEEXTPROC>(eglGetProcAddress("glMapBufferRange"));
+	if(!glMapBufferRange) {
+		glMapBufferRange=reinterpret_cast<PFNGLMAPBUFFERRANGEEXTPROC>(eglGetProcAddress("glMapBufferRangeEXT"));
+	}
+	glUnmapBuffer=reinterpret_cast<PFNGLUNMAPBUFFEROESPROC>(eglGetProcAddress("glUnmapBuffer"));
+	if(!glUnmapBuffer) {
+		glUnmapBuffer=reinterpret_cast<PFNGLUNMAPBUFFEROESPROC>(eglGetProcAddress("glUnmapBufferOES"));
+	}
+	eglCreateSyncKHR=reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+	eglDestroySyncKHR=reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+	eglClientWaitSyncKHR=reinterpret_cast<PFNEGLCLIENTWAITSYNCKHRPROC>(eglGetProcAddress("eglClientWaitSyncKHR"));
+#endif
 }
@@ -9,6 +9,14 @@
 	PFNGLUNIFORM2IPROC glUniform2i;
 	PFNGLUNIFORM3IPROC glUniform3i;
 	PFNGLUNIFORM4IPROC glUniform4i;
+	PFNGLUNIFORM1FVPROC glUniform1fv;
+	PFNGLUNIFORM2FVPROC glUniform2fv;
+	PFNGLUNIFORM3FVPROC glUniform3fv;
+	PFNGLUNIFORM4FVPROC glUniform4fv;
+	PFNGLUNIFORM1IVPROC glUniform1iv;
+	PFNGLUNIFORM2IVPROC glUniform2iv;
+	PFNGLUNIFORM3IVPROC glUniform3iv;
+	PFNGLUNIFORM4IVPROC glUniform4iv;
 	PFNGLPIXELSTOREIPROC glPixelStorei;
 	PFNGLBINDATTRIBLOCATIONPROC glBindAttribLocation;
 	PFNGLDRAWARRAYSPROC glDrawArrays;
@@ -64,6 +72,8 @@
 	PFNGLCOLORMASKPROC glColorMask;
 	PFNGLCOPYTEXIMAGE2DPROC glCopyTexImage2D;
 	PFNGLCOPYTEXSUBIMAGE2DPROC glCopyTexSubImage2D;
+	PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D;
+	PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC glCompressedTexSubImage2D;
 	PFNGLCULLFACEPROC glCullFace;
 	PFNGLDEPTHMASKPROC glDepthMask;
 	PFNGLDEPTHRANGEFPROC glDepthRangef;
@@ -125,8 +135,17 @@
 	PFNGLGETVERTEXATTRIBPOINTERVPROC glGetVertexAttribPointerv;
 	PFNGLGETSTRINGPROC glGetString;
 	PFNGLGETERRORPROC glGetError;
+	PFNGLDEBUGMESSAGECALLBACKKHRPROC glDebugMessageCallbackKHR;
+	PFNGLDEBUGMESSAGECONTROLKHRPROC glDebugMessageControlKHR;
 	PFNGLDRAWBUFFERSEXTPROC glDrawBuffersEXT;
 	PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOES;
 	PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOES;
 	PFNGLISVERTEXARRAYOESPROC glIsVertexArrayOES;
 	PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOES;
+#if !defined(__vita__)
+	PFNGLMAPBUFFERRANGEEXTPROC glMapBufferRange;
+	PFNGLUNMAPBUFFEROESPROC glUnmapBuffer;
+	PFNEGLCREATESYNCKHRPROC eglCreateSyncKHR;
+	PFNEGLDESTROYSYNCKHRPROC eglDestroySyncKHR;
+	PFNEGLCLIENTWAITSYNCKHRPROC eglClientWaitSyncKHR;
+#endif
@@ -0,0 +1,20 @@
+const HALF_FLOAT_OES = 0x8D61
+
+class OESTextureHalfFloat {
+  constructor () {
+    this.HALF_FLOAT_OES = HALF_FLOAT_OES
+  }
+}
+
+function getOESTextureHalfFloat (context) {
+  let result = null
+  const exts = context.getSupportedExtensions()
+
+  if (exts && exts.indexOf('OES_texture_half_float') >= 0) {
+    result = new OESTextureHalfFloat()
+  }
+
+  return result
+}
+
+export { getOESTextureHalfFloat, OESTextureHalfFloat, HALF_FLOAT_OES }
@@ -0,0 +1,27 @@
+class WebGLCompressedTextureETC {
+  constructor () {
+    this.COMPRESSED_R11_EAC = 0x9270
+    this.COMPRESSED_SIGNED_R11_EAC = 0x9271
+    this.COMPRESSED_RG11_EAC = 0x9272
+    this.COMPRESSED_SIGNED_RG11_EAC = 0x9273
+    this.COMPRESSED_RGB8_ETC2 = 0x9274
+    this.COMPRESSED_SRGB8_ETC2 = 0x9275
+    this.COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 = 0x9276
+    this.COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 = 0x9277
+    this.COMPRESSED_RGBA8_ETC2_EAC = 0x9278
+    this.COMPRESSED_SRGB8_ALPHA8_ETC2_EAC = 0x9279
+  }
+}
+
+function getWebGLCompressedTextureETC (context) {
+  let result = null
+  const exts = context.getSupportedExtensions()
+
+  if (exts && exts.indexOf('WEBGL_compressed_texture_etc') >= 0) {
+    result = new WebGLCompressedTextureETC()
+  }
+
+  return result
+}
+
+export { getWebGLCompressedTextureETC, WebGLCompressedTextureETC }
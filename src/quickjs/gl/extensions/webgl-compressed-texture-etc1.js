@@ -0,0 +1,18 @@
+class WebGLCompressedTextureETC1 {
+  constructor () {
+    this.COMPRESSED_RGB_ETC1_WEBGL = 0x8D64
+  }
+}
+
+function getWebGLCompressedTextureETC1 (context) {
+  let result = null
+  const exts = context.getSupportedExtensions()
+
+  if (exts && exts.indexOf('WEBGL_compressed_texture_etc1') >= 0) {
+    result = new WebGLCompressedTextureETC1()
+  }
+
+  return result
+}
+
+export { getWebGLCompressedTextureETC1, WebGLCompressedTextureETC1 }
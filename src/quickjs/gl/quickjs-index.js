@@ -3,6 +3,7 @@
 import bits from './bit-twiddle.js'
 import { WebGLContextAttributes } from './webgl-context-attributes.js'
 import { WebGLRenderingContext, wrapContext } from './webgl-rendering-context.js'
+import { WebGLTrustedRenderingContext } from './webgl-trusted-rendering-context.js'
 import { WebGLTextureUnit } from './webgl-texture-unit.js'
 import { WebGLVertexArrayObjectState, WebGLVertexArrayGlobalState } from './webgl-vertex-attribute.js'
 
@@ -130,9 +131,14 @@ function createContext (width, height, options) {
   const platformParameters = options && options.platform
   const currentPlatform = platformParameters && platformParameters.name
 
+  // Trusted contexts skip the WebGL validation layer on the hot paths
+  const Context = options && options.validation === 'none'
+    ? WebGLTrustedRenderingContext
+    : WebGLRenderingContext
+
   let ctx
   try {
-    ctx = new WebGLRenderingContext(
+    ctx = new Context(
       1,
       1,
       contextAttributes.alpha,
@@ -143,6 +149,7 @@ function createContext (width, height, options) {
       contextAttributes.preserveDrawingBuffer,
       contextAttributes.preferLowPowerToHighPerformance,
       contextAttributes.failIfMajorPerformanceCaveat,
+      flag(options, 'robustAccess', false),
       window,
       platformParameters)
   } catch (e) {}
@@ -152,11 +159,35 @@ function createContext (width, height, options) {
 
   ctx.drawingBufferWidth = width
   ctx.drawingBufferHeight = height
+  ctx._setDrawingBufferSize(width, height)
 
   ctx._ = CONTEXT_COUNTER++
 
   ctx._contextAttributes = contextAttributes
 
+  // Skip CPU-side buffer range checks when the driver guarantees robust access
+  ctx._robustAccess = ctx._isRobustAccess()
+
+  // Collect driver errors through GL_KHR_debug or once per frame
+  if (flag(options, 'deferredErrors', false)) {
+    ctx._deferErrors()
+  }
+
+  // Size of the native scratch arena, see getArenaStats()
+  if (options && typeof options.arenaSize === 'number' && options.arenaSize >= 0) {
+    ctx._setArenaSize(options.arenaSize)
+  }
+
+  // Microseconds of queued uploads sent per frame, see enqueueTexImage2D()
+  if (options && typeof options.uploadBudget === 'number' && options.uploadBudget >= 0) {
+    ctx._setUploadBudget(options.uploadBudget)
+  }
+
+  // Bytes of texture storage managed textures are evicted to stay under, see manageTexture()
+  if (options && typeof options.residencyBudget === 'number' && options.residencyBudget >= 0) {
+    ctx._setResidencyBudget(options.residencyBudget)
+  }
+
   ctx._extensions = {}
   ctx._programs = {}
   ctx._shaders = {}
@@ -168,13 +199,9 @@ function createContext (width, height, options) {
   ctx._activeProgram = null
   ctx._activeFramebuffer = null
   ctx._activeRenderbuffer = null
-  ctx._checkStencil = false
-  ctx._stencilState = true
 
   applyFeature(currentPlatform, PlatformFeature.TEXTURE_UNITS, ctx)
 
-  ctx._errorStack = []
-
   // Vertex array attributes that are in vertex array objects.
   ctx._defaultVertexObjectState = new WebGLVertexArrayObjectState(ctx)
   ctx._vertexObjectState = ctx._defaultVertexObjectState
@@ -192,12 +219,18 @@ function createContext (width, height, options) {
   ctx._unpackAlignment = 4
   ctx._packAlignment = 4
 
+  // Pending readPixelsAsync calls
+  ctx._readbacks = []
+
+  // Pending enqueueTexImage2D and enqueueBufferData calls by id
+  ctx._uploads = new Map()
+
+  // Called by swap() when the storage goes over the budget, see setMemoryBudget()
+  ctx._memoryBudgetCallback = null
+
   // Allocate framebuffer
   applyFeature(currentPlatform, PlatformFeature.ALLOCATE_DRAWING_BUFFER, ctx, hasWindow)
 
-  const attrib0Buffer = ctx.createBuffer()
-  ctx._attrib0Buffer = attrib0Buffer
-
   // Initialize defaults
   applyFeature(currentPlatform, PlatformFeature.DEFAULT_BINDINGS, ctx)
   
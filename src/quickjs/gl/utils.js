@@ -32,16 +32,10 @@ function checkUniform (program, location) {
     location._linkCount === program._linkCount
 }
 
-function isTypedArray (data) {
-  return data instanceof Uint8Array ||
-    data instanceof Uint8ClampedArray ||
-    data instanceof Int8Array ||
-    data instanceof Uint16Array ||
-    data instanceof Int16Array ||
-    data instanceof Uint32Array ||
-    data instanceof Int32Array ||
-    data instanceof Float32Array ||
-    data instanceof Float64Array
+// ArrayBuffers and every ArrayBufferView are handed to the bindings as they
+// are, the bytes are read in place
+function isBufferSource (data) {
+  return data instanceof ArrayBuffer || ArrayBuffer.isView(data)
 }
 
 // Don't allow: ", $, `, @, \, ', \0
@@ -121,12 +115,6 @@ function uniformTypeSize (type) {
   }
 }
 
-function unpackTypedArray (array) {
-  return (new Uint8Array(array.buffer)).subarray(
-    array.byteOffset,
-    array.byteLength + array.byteOffset)
-}
-
 function extractImageData (pixels) {
   if (typeof pixels === 'object' && typeof pixels.width !== 'undefined' && typeof pixels.height !== 'undefined') {
     if (typeof pixels.data !== 'undefined') {
@@ -174,22 +162,6 @@ function formatSize (internalFormat) {
   return 0
 }
 
-function convertPixels (pixels) {
-  if (typeof pixels === 'object' && pixels !== null) {
-    if (pixels instanceof ArrayBuffer) {
-      return new Uint8Array(pixels)
-    } else if (pixels instanceof Uint8Array ||
-      pixels instanceof Uint16Array ||
-      pixels instanceof Uint8ClampedArray ||
-      pixels instanceof Float32Array) {
-      return unpackTypedArray(pixels)
-    } else if (pixels instanceof Buffer) {
-      return new Uint8Array(pixels)
-    }
-  }
-  return null
-}
-
 function checkFormat (format) {
   return (
     format === gl.ALPHA ||
@@ -199,6 +171,52 @@ function checkFormat (format) {
     format === gl.RGBA)
 }
 
+// Block width, height and byte size of the compressed formats extensions expose
+const compressedBlocks = {
+  // WEBGL_compressed_texture_s3tc
+  0x83F0: [4, 4, 8],
+  0x83F1: [4, 4, 8],
+  0x83F2: [4, 4, 16],
+  0x83F3: [4, 4, 16],
+  // WEBGL_compressed_texture_etc1
+  0x8D64: [4, 4, 8],
+  // WEBGL_compressed_texture_etc
+  0x9270: [4, 4, 8],
+  0x9271: [4, 4, 8],
+  0x9272: [4, 4, 16],
+  0x9273: [4, 4, 16],
+  0x9274: [4, 4, 8],
+  0x9275: [4, 4, 8],
+  0x9276: [4, 4, 8],
+  0x9277: [4, 4, 8],
+  0x9278: [4, 4, 16],
+  0x9279: [4, 4, 16]
+}
+
+// WEBGL_compressed_texture_astc, RGBA and SRGB8_ALPHA8 variants share footprints
+const astcFootprints = [
+  [4, 4], [5, 4], [5, 5], [6, 5], [6, 6], [8, 5], [8, 6],
+  [8, 8], [10, 5], [10, 6], [10, 8], [10, 10], [12, 10], [12, 12]
+]
+astcFootprints.forEach(([width, height], i) => {
+  compressedBlocks[0x93B0 + i] = [width, height, 16]
+  compressedBlocks[0x93D0 + i] = [width, height, 16]
+})
+
+function compressedBlockSize (format) {
+  return compressedBlocks[format] || null
+}
+
+// Bytes a compressed image of this size takes, 0 for unknown formats
+function compressedImageSize (format, width, height) {
+  const block = compressedBlocks[format]
+  if (!block) {
+    return 0
+  }
+  const [blockWidth, blockHeight, blockBytes] = block
+  return Math.ceil(width / blockWidth) * Math.ceil(height / blockHeight) * blockBytes
+}
+
 function validCubeTarget (target) {
   return target === gl.TEXTURE_CUBE_MAP_POSITIVE_X ||
     target === gl.TEXTURE_CUBE_MAP_NEGATIVE_X ||
@@ -211,16 +229,16 @@ function validCubeTarget (target) {
 export {
   bindPublics,
   checkObject,
-  isTypedArray,
+  isBufferSource,
   isValidString,
   vertexCount,
   typeSize,
   uniformTypeSize,
-  unpackTypedArray,
   extractImageData,
   formatSize,
   checkFormat,
   checkUniform,
-  convertPixels,
+  compressedBlockSize,
+  compressedImageSize,
   validCubeTarget
 }
@@ -0,0 +1,152 @@
+import { gl } from './native-gl.js'
+import { formatSize, isBufferSource } from './utils.js'
+
+const DEFAULT_SIZE = 1024
+const DEFAULT_PADDING = 1
+
+// Region packed into an atlas page, in texels and in texture coordinates.
+// Rows go down from v0 to v1 like the rows of the pixels that were added
+class WebGLAtlasRegion {
+  constructor (atlas, values) {
+    this.page = values[0]
+    this.texture = atlas._pages[this.page]
+    this.x = values[1]
+    this.y = values[2]
+    this.width = values[3]
+    this.height = values[4]
+    this.u0 = values[5]
+    this.v0 = values[6]
+    this.u1 = values[7]
+    this.v1 = values[8]
+  }
+}
+
+// Texture atlas made by createAtlas. Regions are placed by a native skyline
+// packer and uploaded with texSubImage2D, a new page is allocated whenever
+// none of the current ones has room left
+class WebGLAtlas {
+  constructor (ctx, options) {
+    this._ctx = ctx
+    this._width = (options.width || DEFAULT_SIZE) | 0
+    this._height = (options.height || options.width || DEFAULT_SIZE) | 0
+    this._padding = options.padding !== undefined ? options.padding | 0 : DEFAULT_PADDING
+    this._format = (options.format || gl.RGBA) | 0
+    this._mipmaps = !!options.mipmaps
+    this._pages = []
+    this._dirtyPages = new Set()
+    this._id = 0
+
+    if (!formatSize(this._format) ||
+      this._width <= 0 || this._height <= 0 || this._padding < 0) {
+      throw new RangeError('createAtlas({ width, height, padding, format, mipmaps })')
+    }
+    this._id = gl._createAtlas.call(ctx, this._width, this._height, this._padding, this._format, this._mipmaps)
+  }
+
+  get pages () {
+    return this._pages.slice()
+  }
+
+  // Packs width x height pixels of the atlas format, unpacked with the current
+  // pixel storage state. Returns the region or null when it can't fit a page
+  add (width, height, pixels) {
+    width |= 0
+    height |= 0
+    if (!this._id) {
+      return null
+    }
+    if (pixels != null && !isBufferSource(pixels)) {
+      throw new TypeError('add(GLint, GLint, ArrayBufferView)')
+    }
+
+    const round = this._mipmaps ? 4 : 1
+    const paddedWidth = Math.ceil((width + 2 * this._padding) / round) * round
+    const paddedHeight = Math.ceil((height + 2 * this._padding) / round) * round
+    if (width <= 0 || height <= 0 ||
+      paddedWidth > this._width || paddedHeight > this._height) {
+      return null
+    }
+
+    const ctx = this._ctx
+    if (pixels) {
+      const rowStride = ctx._computeRowStride(width, formatSize(this._format))
+      if (pixels.byteLength < rowStride * height) {
+        ctx.setError(gl.INVALID_OPERATION)
+        return null
+      }
+    }
+
+    let values = gl._atlasInsert.call(ctx, this._id, width, height, pixels || null)
+    if (values.length === 0) {
+      if (!this._addPage()) {
+        return null
+      }
+      values = gl._atlasInsert.call(ctx, this._id, width, height, pixels || null)
+    }
+    if (values.length === 0) {
+      return null
+    }
+    if (this._mipmaps) {
+      this._dirtyPages.add(values[0])
+    }
+    return new WebGLAtlasRegion(this, values)
+  }
+
+  // Regenerates the mipmaps of the pages regions were added to since the
+  // last call
+  generateMipmaps () {
+    if (this._dirtyPages.size === 0) {
+      return
+    }
+    const ctx = this._ctx
+    const previous = ctx._getActiveTextureUnit()._bind2D
+    for (const page of this._dirtyPages) {
+      ctx.bindTexture(gl.TEXTURE_2D, this._pages[page])
+      ctx.generateMipmap(gl.TEXTURE_2D)
+    }
+    ctx.bindTexture(gl.TEXTURE_2D, previous)
+    this._dirtyPages.clear()
+  }
+
+  // Deletes the pages, regions handed out before are invalid afterwards
+  destroy () {
+    if (!this._id) {
+      return
+    }
+    gl._deleteAtlas.call(this._ctx, this._id)
+    for (const texture of this._pages) {
+      this._ctx.deleteTexture(texture)
+    }
+    this._pages = []
+    this._dirtyPages.clear()
+    this._id = 0
+  }
+
+  // Allocates a page with the regular texture calls, so the JS side of the
+  // context knows its storage, then hands it to the packer
+  _addPage () {
+    const ctx = this._ctx
+    const texture = ctx.createTexture()
+    if (!texture) {
+      return false
+    }
+    const previous = ctx._getActiveTextureUnit()._bind2D
+    ctx.bindTexture(gl.TEXTURE_2D, texture)
+    ctx.texImage2D(gl.TEXTURE_2D, 0, this._format, this._width, this._height, 0, this._format, gl.UNSIGNED_BYTE, null)
+    ctx.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MIN_FILTER, this._mipmaps ? gl.LINEAR_MIPMAP_LINEAR : gl.LINEAR)
+    ctx.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MAG_FILTER, gl.LINEAR)
+    ctx.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_S, gl.CLAMP_TO_EDGE)
+    ctx.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_T, gl.CLAMP_TO_EDGE)
+    ctx.bindTexture(gl.TEXTURE_2D, previous)
+
+    if (texture._levelWidth[0] !== this._width ||
+      !gl._atlasAddPage.call(ctx, this._id, texture._ | 0)) {
+      ctx.deleteTexture(texture)
+      return false
+    }
+    this._pages.push(texture)
+    return true
+  }
+}
+
+export { WebGLAtlas, WebGLAtlasRegion }
@@ -6,7 +6,6 @@ class WebGLBuffer extends Linkable {
     super(_)
     this._ctx = ctx
     this._size = 0
-    this._elements = new Uint8Array(0)
   }
 
   _performDelete () {
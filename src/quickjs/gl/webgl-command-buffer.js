@@ -0,0 +1,666 @@
+import { gl } from './native-gl.js'
+import { typeSize } from './utils.js'
+
+// Command opcodes, must match WebGLCommandOp in webgl.h
+const Op = {
+  ACTIVE_TEXTURE: 1,
+  BIND_BUFFER: 2,
+  BIND_FRAMEBUFFER: 3,
+  BIND_RENDERBUFFER: 4,
+  BIND_TEXTURE: 5,
+  BIND_VERTEX_ARRAY: 6,
+  BLEND_COLOR: 7,
+  BLEND_EQUATION: 8,
+  BLEND_EQUATION_SEPARATE: 9,
+  BLEND_FUNC: 10,
+  BLEND_FUNC_SEPARATE: 11,
+  CLEAR: 12,
+  CLEAR_COLOR: 13,
+  CLEAR_DEPTH: 14,
+  CLEAR_STENCIL: 15,
+  COLOR_MASK: 16,
+  CULL_FACE: 17,
+  DEPTH_FUNC: 18,
+  DEPTH_MASK: 19,
+  DEPTH_RANGE: 20,
+  DISABLE: 21,
+  DISABLE_VERTEX_ATTRIB_ARRAY: 22,
+  DRAW_ARRAYS: 23,
+  DRAW_ARRAYS_INSTANCED: 24,
+  DRAW_ELEMENTS: 25,
+  DRAW_ELEMENTS_INSTANCED: 26,
+  ENABLE: 27,
+  ENABLE_VERTEX_ATTRIB_ARRAY: 28,
+  FRONT_FACE: 29,
+  LINE_WIDTH: 30,
+  POLYGON_OFFSET: 31,
+  SCISSOR: 32,
+  STENCIL_FUNC: 33,
+  STENCIL_FUNC_SEPARATE: 34,
+  STENCIL_MASK: 35,
+  STENCIL_MASK_SEPARATE: 36,
+  STENCIL_OP: 37,
+  STENCIL_OP_SEPARATE: 38,
+  UNIFORM_1F: 39,
+  UNIFORM_2F: 40,
+  UNIFORM_3F: 41,
+  UNIFORM_4F: 42,
+  UNIFORM_1I: 43,
+  UNIFORM_2I: 44,
+  UNIFORM_3I: 45,
+  UNIFORM_4I: 46,
+  UNIFORM_MATRIX_2FV: 47,
+  UNIFORM_MATRIX_3FV: 48,
+  UNIFORM_MATRIX_4FV: 49,
+  USE_PROGRAM: 50,
+  VERTEX_ATTRIB_1F: 51,
+  VERTEX_ATTRIB_2F: 52,
+  VERTEX_ATTRIB_3F: 53,
+  VERTEX_ATTRIB_4F: 54,
+  VERTEX_ATTRIB_DIVISOR: 55,
+  VERTEX_ATTRIB_POINTER: 56,
+  VIEWPORT: 57
+}
+
+const DEFAULT_CAPACITY = 1024
+
+// Records WebGLRenderingContext calls into a flat Uint32Array stream that
+// is executed natively by a single ctx.submit(buffer) call.
+//
+// Commands are not validated the way the context methods are, except draw
+// calls which go through the same native validation, so render loops should
+// be debugged with the regular API first. Arguments JS state is indexed with
+// (vertex attributes, texture units, matrix lengths) are checked when they are
+// recorded, and a buffer referencing a deleted object is not submitted.
+// Binding changes are kept aside and
+// applied to the context's tracked state after every submit, which means a
+// buffer can be recorded once and submitted every frame.
+class WebGLCommandBuffer {
+  constructor (ctx, capacity) {
+    this._ctx = ctx
+    this._length = 0
+    this._u32 = null
+    this._f32 = null
+    this._bookkeeping = []
+    this._objects = new Set()
+    this._allocate(capacity > 0 ? capacity | 0 : DEFAULT_CAPACITY)
+  }
+
+  get length () {
+    return this._length
+  }
+
+  reset () {
+    this._length = 0
+    this._bookkeeping.length = 0
+    this._objects.clear()
+  }
+
+  // Objects whose names were recorded, they must still exist when submitted
+  _reference (object) {
+    if (object) {
+      this._objects.add(object)
+    }
+  }
+
+  _objectsAlive () {
+    for (const object of this._objects) {
+      if (object._ === 0) {
+        return false
+      }
+    }
+    return true
+  }
+
+  // Same checks as the context methods, nothing is recorded after an error
+  _checkAttribIndex (index) {
+    if (index < 0 || index >= this._ctx._vertexObjectState._attribs.length) {
+      this._ctx.setError(gl.INVALID_VALUE)
+      return false
+    }
+    return true
+  }
+
+  _allocate (capacity) {
+    const buffer = new ArrayBuffer(capacity * 4)
+    const u32 = new Uint32Array(buffer)
+    if (this._u32) {
+      u32.set(this._u32.subarray(0, this._length))
+    }
+    this._u32 = u32
+    this._f32 = new Float32Array(buffer)
+  }
+
+  // Reserves a command and returns the index of its first argument
+  _begin (op, argc) {
+    const end = this._length + argc + 1
+    if (end > this._u32.length) {
+      this._allocate(Math.max(end, this._u32.length * 2))
+    }
+    const at = this._length + 1
+    this._u32[this._length] = op | (argc << 16)
+    this._length = end
+    return at
+  }
+
+  _int1 (op, a) {
+    const at = this._begin(op, 1)
+    this._u32[at] = a
+  }
+
+  _int2 (op, a, b) {
+    const at = this._begin(op, 2)
+    const u32 = this._u32
+    u32[at] = a
+    u32[at + 1] = b
+  }
+
+  _int3 (op, a, b, c) {
+    const at = this._begin(op, 3)
+    const u32 = this._u32
+    u32[at] = a
+    u32[at + 1] = b
+    u32[at + 2] = c
+  }
+
+  _int4 (op, a, b, c, d) {
+    const at = this._begin(op, 4)
+    const u32 = this._u32
+    u32[at] = a
+    u32[at + 1] = b
+    u32[at + 2] = c
+    u32[at + 3] = d
+  }
+
+  _float4 (op, a, b, c, d) {
+    const at = this._begin(op, 4)
+    const f32 = this._f32
+    f32[at] = a
+    f32[at + 1] = b
+    f32[at + 2] = c
+    f32[at + 3] = d
+  }
+
+  // Index followed by up to four floats (uniforms, vertex attributes)
+  _indexFloats (op, index, count, x, y, z, w) {
+    const at = this._begin(op, count + 1)
+    const f32 = this._f32
+    this._u32[at] = index
+    f32[at + 1] = x
+    if (count > 1) f32[at + 2] = y
+    if (count > 2) f32[at + 3] = z
+    if (count > 3) f32[at + 4] = w
+  }
+
+  // Location followed by up to four integers
+  _indexInts (op, index, count, x, y, z, w) {
+    const at = this._begin(op, count + 1)
+    const u32 = this._u32
+    u32[at] = index
+    u32[at + 1] = x
+    if (count > 1) u32[at + 2] = y
+    if (count > 2) u32[at + 3] = z
+    if (count > 3) u32[at + 4] = w
+  }
+
+  _matrix (op, size, location, transpose, value) {
+    if (!location) return
+    if (!value || value.length === 0 || value.length % (size * size) !== 0) {
+      this._ctx.setError(gl.INVALID_VALUE)
+      return
+    }
+    this._reference(location._program)
+    const at = this._begin(op, value.length + 2)
+    this._u32[at] = location._ | 0
+    this._u32[at + 1] = transpose ? 1 : 0
+    this._f32.set(value, at + 2)
+  }
+
+  activeTexture (texture) {
+    const unit = (texture | 0) - gl.TEXTURE0
+    if (unit < 0 || unit >= this._ctx._textureUnits.length) {
+      this._ctx.setError(gl.INVALID_ENUM)
+      return
+    }
+    this._int1(Op.ACTIVE_TEXTURE, texture | 0)
+    this._bookkeeping.push([Op.ACTIVE_TEXTURE, texture | 0])
+  }
+
+  bindBuffer (target, buffer) {
+    this._reference(buffer)
+    this._int2(Op.BIND_BUFFER, target | 0, buffer ? buffer._ | 0 : 0)
+    this._bookkeeping.push([Op.BIND_BUFFER, target | 0, buffer || null])
+  }
+
+  bindFramebuffer (target, framebuffer) {
+    this._reference(framebuffer)
+    this._int2(
+      Op.BIND_FRAMEBUFFER,
+      target | 0,
+      framebuffer ? framebuffer._ | 0 : this._ctx._drawingBuffer._framebuffer | 0)
+    this._bookkeeping.push([Op.BIND_FRAMEBUFFER, target | 0, framebuffer || null])
+  }
+
+  bindRenderbuffer (target, renderbuffer) {
+    this._reference(renderbuffer)
+    this._int2(Op.BIND_RENDERBUFFER, target | 0, renderbuffer ? renderbuffer._ | 0 : 0)
+    this._bookkeeping.push([Op.BIND_RENDERBUFFER, target | 0, renderbuffer || null])
+  }
+
+  bindTexture (target, texture) {
+    this._reference(texture)
+    this._int2(Op.BIND_TEXTURE, target | 0, texture && texture._complete ? texture._ | 0 : 0)
+    this._bookkeeping.push([Op.BIND_TEXTURE, target | 0, texture || null])
+  }
+
+  bindVertexArrayOES (array) {
+    this._reference(array)
+    this._int1(Op.BIND_VERTEX_ARRAY, array ? array._ | 0 : 0)
+    this._bookkeeping.push([Op.BIND_VERTEX_ARRAY, array || null])
+  }
+
+  blendColor (red, green, blue, alpha) {
+    this._float4(Op.BLEND_COLOR, +red, +green, +blue, +alpha)
+  }
+
+  blendEquation (mode) {
+    this._int1(Op.BLEND_EQUATION, mode | 0)
+  }
+
+  blendEquationSeparate (modeRGB, modeAlpha) {
+    this._int2(Op.BLEND_EQUATION_SEPARATE, modeRGB | 0, modeAlpha | 0)
+  }
+
+  blendFunc (sfactor, dfactor) {
+    this._int2(Op.BLEND_FUNC, sfactor | 0, dfactor | 0)
+  }
+
+  blendFuncSeparate (srcRGB, dstRGB, srcAlpha, dstAlpha) {
+    this._int4(Op.BLEND_FUNC_SEPARATE, srcRGB | 0, dstRGB | 0, srcAlpha | 0, dstAlpha | 0)
+  }
+
+  clear (mask) {
+    this._int1(Op.CLEAR, mask | 0)
+  }
+
+  clearColor (red, green, blue, alpha) {
+    this._float4(Op.CLEAR_COLOR, +red, +green, +blue, +alpha)
+  }
+
+  clearDepth (depth) {
+    const at = this._begin(Op.CLEAR_DEPTH, 1)
+    this._f32[at] = +depth
+  }
+
+  clearStencil (s) {
+    this._int1(Op.CLEAR_STENCIL, s | 0)
+  }
+
+  colorMask (red, green, blue, alpha) {
+    this._int4(Op.COLOR_MASK, red ? 1 : 0, green ? 1 : 0, blue ? 1 : 0, alpha ? 1 : 0)
+  }
+
+  cullFace (mode) {
+    this._int1(Op.CULL_FACE, mode | 0)
+  }
+
+  depthFunc (func) {
+    this._int1(Op.DEPTH_FUNC, func | 0)
+  }
+
+  depthMask (flag) {
+    this._int1(Op.DEPTH_MASK, flag ? 1 : 0)
+  }
+
+  depthRange (zNear, zFar) {
+    const at = this._begin(Op.DEPTH_RANGE, 2)
+    this._f32[at] = +zNear
+    this._f32[at + 1] = +zFar
+  }
+
+  disable (cap) {
+    this._int1(Op.DISABLE, cap | 0)
+  }
+
+  disableVertexAttribArray (index) {
+    if (!this._checkAttribIndex(index | 0)) return
+    this._int1(Op.DISABLE_VERTEX_ATTRIB_ARRAY, index | 0)
+    this._bookkeeping.push([Op.DISABLE_VERTEX_ATTRIB_ARRAY, index | 0])
+  }
+
+  drawArrays (mode, first, count) {
+    this._int3(Op.DRAW_ARRAYS, mode | 0, first | 0, count | 0)
+  }
+
+  drawArraysInstancedANGLE (mode, first, count, primCount) {
+    this._int4(Op.DRAW_ARRAYS_INSTANCED, mode | 0, first | 0, count | 0, primCount | 0)
+  }
+
+  drawElements (mode, count, type, offset) {
+    this._int4(Op.DRAW_ELEMENTS, mode | 0, count | 0, type | 0, offset | 0)
+  }
+
+  drawElementsInstancedANGLE (mode, count, type, offset, primCount) {
+    const at = this._begin(Op.DRAW_ELEMENTS_INSTANCED, 5)
+    const u32 = this._u32
+    u32[at] = mode | 0
+    u32[at + 1] = count | 0
+    u32[at + 2] = type | 0
+    u32[at + 3] = offset | 0
+    u32[at + 4] = primCount | 0
+  }
+
+  enable (cap) {
+    this._int1(Op.ENABLE, cap | 0)
+  }
+
+  enableVertexAttribArray (index) {
+    if (!this._checkAttribIndex(index | 0)) return
+    this._int1(Op.ENABLE_VERTEX_ATTRIB_ARRAY, index | 0)
+    this._bookkeeping.push([Op.ENABLE_VERTEX_ATTRIB_ARRAY, index | 0])
+  }
+
+  frontFace (mode) {
+    this._int1(Op.FRONT_FACE, mode | 0)
+  }
+
+  lineWidth (width) {
+    const at = this._begin(Op.LINE_WIDTH, 1)
+    this._f32[at] = +width
+  }
+
+  polygonOffset (factor, units) {
+    const at = this._begin(Op.POLYGON_OFFSET, 2)
+    this._f32[at] = +factor
+    this._f32[at + 1] = +units
+  }
+
+  scissor (x, y, width, height) {
+    this._int4(Op.SCISSOR, x | 0, y | 0, width | 0, height | 0)
+  }
+
+  stencilFunc (func, ref, mask) {
+    this._int3(Op.STENCIL_FUNC, func | 0, ref | 0, mask >>> 0)
+  }
+
+  stencilFuncSeparate (face, func, ref, mask) {
+    this._int4(Op.STENCIL_FUNC_SEPARATE, face | 0, func | 0, ref | 0, mask >>> 0)
+  }
+
+  stencilMask (mask) {
+    this._int1(Op.STENCIL_MASK, mask >>> 0)
+  }
+
+  stencilMaskSeparate (face, mask) {
+    this._int2(Op.STENCIL_MASK_SEPARATE, face | 0, mask >>> 0)
+  }
+
+  stencilOp (fail, zfail, zpass) {
+    this._int3(Op.STENCIL_OP, fail | 0, zfail | 0, zpass | 0)
+  }
+
+  stencilOpSeparate (face, fail, zfail, zpass) {
+    this._int4(Op.STENCIL_OP_SEPARATE, face | 0, fail | 0, zfail | 0, zpass | 0)
+  }
+
+  uniform1f (location, x) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexFloats(Op.UNIFORM_1F, location._ | 0, 1, +x)
+  }
+
+  uniform2f (location, x, y) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexFloats(Op.UNIFORM_2F, location._ | 0, 2, +x, +y)
+  }
+
+  uniform3f (location, x, y, z) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexFloats(Op.UNIFORM_3F, location._ | 0, 3, +x, +y, +z)
+  }
+
+  uniform4f (location, x, y, z, w) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexFloats(Op.UNIFORM_4F, location._ | 0, 4, +x, +y, +z, +w)
+  }
+
+  uniform1i (location, x) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexInts(Op.UNIFORM_1I, location._ | 0, 1, x | 0)
+  }
+
+  uniform2i (location, x, y) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexInts(Op.UNIFORM_2I, location._ | 0, 2, x | 0, y | 0)
+  }
+
+  uniform3i (location, x, y, z) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexInts(Op.UNIFORM_3I, location._ | 0, 3, x | 0, y | 0, z | 0)
+  }
+
+  uniform4i (location, x, y, z, w) {
+    if (!location) return
+    this._reference(location._program)
+    this._indexInts(Op.UNIFORM_4I, location._ | 0, 4, x | 0, y | 0, z | 0, w | 0)
+  }
+
+  uniformMatrix2fv (location, transpose, value) {
+    this._matrix(Op.UNIFORM_MATRIX_2FV, 2, location, transpose, value)
+  }
+
+  uniformMatrix3fv (location, transpose, value) {
+    this._matrix(Op.UNIFORM_MATRIX_3FV, 3, location, transpose, value)
+  }
+
+  uniformMatrix4fv (location, transpose, value) {
+    this._matrix(Op.UNIFORM_MATRIX_4FV, 4, location, transpose, value)
+  }
+
+  useProgram (program) {
+    this._reference(program)
+    this._int1(Op.USE_PROGRAM, program ? program._ | 0 : 0)
+    this._bookkeeping.push([Op.USE_PROGRAM, program || null])
+  }
+
+  vertexAttrib1f (index, x) {
+    if (!this._checkAttribIndex(index | 0)) return
+    this._indexFloats(Op.VERTEX_ATTRIB_1F, index | 0, 1, +x)
+    this._bookkeeping.push([Op.VERTEX_ATTRIB_4F, index | 0, +x, 0, 0, 1])
+  }
+
+  vertexAttrib2f (index, x, y) {
+    if (!this._checkAttribIndex(index | 0)) return
+    this._indexFloats(Op.VERTEX_ATTRIB_2F, index | 0, 2, +x, +y)
+    this._bookkeeping.push([Op.VERTEX_ATTRIB_4F, index | 0, +x, +y, 0, 1])
+  }
+
+  vertexAttrib3f (index, x, y, z) {
+    if (!this._checkAttribIndex(index | 0)) return
+    this._indexFloats(Op.VERTEX_ATTRIB_3F, index | 0, 3, +x, +y, +z)
+    this._bookkeeping.push([Op.VERTEX_ATTRIB_4F, index | 0, +x, +y, +z, 1])
+  }
+
+  vertexAttrib4f (index, x, y, z, w) {
+    if (!this._checkAttribIndex(index | 0)) return
+    this._indexFloats(Op.VERTEX_ATTRIB_4F, index | 0, 4, +x, +y, +z, +w)
+    this._bookkeeping.push([Op.VERTEX_ATTRIB_4F, index | 0, +x, +y, +z, +w])
+  }
+
+  vertexAttribDivisorANGLE (index, divisor) {
+    if (!this._checkAttribIndex(index | 0)) return
+    this._int2(Op.VERTEX_ATTRIB_DIVISOR, index | 0, divisor | 0)
+    this._bookkeeping.push([Op.VERTEX_ATTRIB_DIVISOR, index | 0, divisor | 0])
+  }
+
+  vertexAttribPointer (index, size, type, normalized, stride, offset) {
+    if (!this._checkAttribIndex(index | 0)) return
+    const at = this._begin(Op.VERTEX_ATTRIB_POINTER, 6)
+    const u32 = this._u32
+    u32[at] = index | 0
+    u32[at + 1] = size | 0
+    u32[at + 2] = type | 0
+    u32[at + 3] = normalized ? 1 : 0
+    u32[at + 4] = stride | 0
+    u32[at + 5] = offset | 0
+    this._bookkeeping.push([Op.VERTEX_ATTRIB_POINTER, index | 0, size | 0, type | 0, !!normalized, stride | 0, offset | 0])
+  }
+
+  viewport (x, y, width, height) {
+    this._int4(Op.VIEWPORT, x | 0, y | 0, width | 0, height | 0)
+  }
+
+  // Applies the recorded binding changes to the context's tracked state,
+  // mirroring what the WebGLRenderingContext methods do after their GL call
+  _sync (ctx) {
+    const entries = this._bookkeeping
+    for (let i = 0; i < entries.length; ++i) {
+      const entry = entries[i]
+      switch (entry[0]) {
+        case Op.ACTIVE_TEXTURE:
+          ctx._activeTextureUnit = entry[1] - gl.TEXTURE0
+          break
+        case Op.BIND_BUFFER: {
+          const buffer = entry[2]
+          if (buffer) {
+            buffer._binding = entry[1]
+          }
+          if (entry[1] === gl.ARRAY_BUFFER) {
+            ctx._vertexGlobalState.setArrayBuffer(buffer)
+          } else {
+            ctx._vertexObjectState.setElementArrayBuffer(buffer)
+          }
+          break
+        }
+        case Op.BIND_FRAMEBUFFER: {
+          const framebuffer = entry[2]
+          const active = ctx._activeFramebuffer
+          if (active !== framebuffer) {
+            if (active) {
+              active._refCount -= 1
+              active._checkDelete()
+            }
+            if (framebuffer) {
+              framebuffer._refCount += 1
+            }
+          }
+          ctx._activeFramebuffer = framebuffer
+          if (framebuffer) {
+            ctx._updateFramebufferAttachments(framebuffer)
+          }
+          break
+        }
+        case Op.BIND_RENDERBUFFER: {
+          const renderbuffer = entry[2]
+          const active = ctx._activeRenderbuffer
+          if (active !== renderbuffer) {
+            if (active) {
+              active._refCount -= 1
+              active._checkDelete()
+            }
+            if (renderbuffer) {
+              renderbuffer._refCount += 1
+            }
+          }
+          ctx._activeRenderbuffer = renderbuffer
+          break
+        }
+        case Op.BIND_TEXTURE: {
+          const target = entry[1]
+          const texture = entry[2]
+          const active = ctx._getActiveTexture(target)
+          if (active !== texture) {
+            if (active) {
+              active._refCount -= 1
+              active._checkDelete()
+            }
+            if (texture) {
+              texture._refCount += 1
+            }
+          }
+          if (texture) {
+            texture._binding = target
+          }
+          const unit = ctx._getActiveTextureUnit()
+          if (target === gl.TEXTURE_2D) {
+            unit._bind2D = texture
+          } else if (target === gl.TEXTURE_CUBE_MAP) {
+            unit._bindCube = texture
+          }
+          break
+        }
+        case Op.BIND_VERTEX_ARRAY: {
+          const ext = ctx._extensions.oes_vertex_array_object
+          const array = entry[1]
+          if (ext) {
+            const active = ext._activeVertexArrayObject
+            if (active !== array) {
+              if (active) {
+                active._refCount -= 1
+                active._checkDelete()
+              }
+              if (array) {
+                array._refCount += 1
+              }
+            }
+            ext._activeVertexArrayObject = array
+          }
+          ctx._vertexObjectState = array ? array._vertexState : ctx._defaultVertexObjectState
+          break
+        }
+        case Op.DISABLE_VERTEX_ATTRIB_ARRAY:
+          ctx._vertexObjectState._attribs[entry[1]]._isPointer = false
+          break
+        case Op.ENABLE_VERTEX_ATTRIB_ARRAY:
+          ctx._vertexObjectState._attribs[entry[1]]._isPointer = true
+          break
+        case Op.USE_PROGRAM: {
+          const program = entry[1]
+          if (ctx._activeProgram !== program) {
+            ctx._switchActiveProgram(ctx._activeProgram)
+            ctx._activeProgram = program
+            if (program) {
+              program._refCount += 1
+            }
+          }
+          break
+        }
+        case Op.VERTEX_ATTRIB_4F: {
+          const data = ctx._vertexGlobalState._attribs[entry[1]]._data
+          data[0] = entry[2]
+          data[1] = entry[3]
+          data[2] = entry[4]
+          data[3] = entry[5]
+          break
+        }
+        case Op.VERTEX_ATTRIB_DIVISOR:
+          ctx._vertexObjectState._attribs[entry[1]]._divisor = entry[2]
+          break
+        case Op.VERTEX_ATTRIB_POINTER: {
+          const [, index, size, type, normalized, stride, offset] = entry
+          const byteSize = typeSize(type)
+          ctx._vertexObjectState.setVertexAttribPointer(
+            /* buffer */ ctx._vertexGlobalState._arrayBufferBinding,
+            /* index */ index,
+            /* pointerSize */ size * byteSize,
+            /* pointerOffset */ offset,
+            /* pointerStride */ stride || (size * byteSize),
+            /* pointerType */ type,
+            /* pointerNormal */ normalized,
+            /* inputStride */ stride,
+            /* inputSize */ size
+          )
+          break
+        }
+      }
+    }
+  }
+}
+
+export { WebGLCommandBuffer, Op as WebGLCommandOp }
@@ -7,8 +7,6 @@ class WebGLFramebuffer extends Linkable {
     this._ctx = ctx
     this._binding = 0
 
-    this._width = 0
-    this._height = 0
     this._status = null
 
     this._attachments = {}
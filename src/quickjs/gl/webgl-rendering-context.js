@@ -1,5 +1,6 @@
 /* eslint-disable */
 
+import * as os from 'os'
 import bits from './bit-twiddle.js'
 import tokenize from './glsl-tokenizer/string.js'
 import { gl, NativeWebGLRenderingContext } from './native-gl.js'
@@ -8,12 +9,19 @@ import { getOESElementIndexUint } from './extensions/oes-element-index-unit.js'
 import { getOESStandardDerivatives } from './extensions/oes-standard-derivatives.js'
 import { getOESTextureFloat } from './extensions/oes-texture-float.js'
 import { getOESTextureFloatLinear } from './extensions/oes-texture-float-linear.js'
+import { getOESTextureHalfFloat, HALF_FLOAT_OES } from './extensions/oes-texture-half-float.js'
+import { getOESTextureHalfFloatLinear } from './extensions/oes-texture-half-float-linear.js'
+import { getEXTColorBufferHalfFloat, RGBA16F_EXT, RGB16F_EXT } from './extensions/ext-color-buffer-half-float.js'
 import { getSTACKGLDestroyContext } from './extensions/stackgl-destroy-context.js'
 import { getSTACKGLResizeDrawingBuffer } from './extensions/stackgl-resize-drawing-buffer.js'
 import { getWebGLDrawBuffers } from './extensions/webgl-draw-buffers.js'
 import { getEXTBlendMinMax } from './extensions/ext-blend-minmax.js'
 import { getEXTTextureFilterAnisotropic } from './extensions/ext-texture-filter-anisotropic.js'
 import { getOESVertexArrayObject } from './extensions/oes-vertex-array-object.js'
+import { getWebGLCompressedTextureASTC } from './extensions/webgl-compressed-texture-astc.js'
+import { getWebGLCompressedTextureETC } from './extensions/webgl-compressed-texture-etc.js'
+import { getWebGLCompressedTextureETC1 } from './extensions/webgl-compressed-texture-etc1.js'
+import { getWebGLCompressedTextureS3TC } from './extensions/webgl-compressed-texture-s3tc.js'
 import {
   bindPublics,
   checkObject,
@@ -23,17 +31,18 @@ import {
   typeSize,
   uniformTypeSize,
   extractImageData,
-  vertexCount,
-  isTypedArray,
-  unpackTypedArray,
-  convertPixels,
+  isBufferSource,
   checkFormat,
+  compressedBlockSize,
+  compressedImageSize,
   validCubeTarget
 } from './utils.js'
 
 import { WebGLActiveInfo } from './webgl-active-info.js'
+import { WebGLAtlas } from './webgl-atlas.js'
 import { WebGLFramebuffer } from './webgl-framebuffer.js'
 import { WebGLBuffer } from './webgl-buffer.js'
+import { WebGLCommandBuffer } from './webgl-command-buffer.js'
 import { WebGLDrawingBufferWrapper } from './webgl-drawing-buffer-wrapper.js'
 import { WebGLProgram } from './webgl-program.js'
 import { WebGLRenderbuffer } from './webgl-renderbuffer.js'
@@ -48,6 +57,12 @@ const HEADLESS_VERSION = '6.0.2-1'
 const MAX_UNIFORM_LENGTH = 256
 const MAX_ATTRIBUTE_LENGTH = 256
 
+// Milliseconds between two checks of the pending readPixelsAsync fences
+const READBACK_POLL_INTERVAL = 1
+
+// Milliseconds between two checks of the images being decoded
+const DECODE_POLL_INTERVAL = 1
+
 const DEFAULT_ATTACHMENTS = [
   gl.COLOR_ATTACHMENT0,
   gl.DEPTH_ATTACHMENT,
@@ -57,18 +72,37 @@ const DEFAULT_ATTACHMENTS = [
 
 const DEFAULT_COLOR_ATTACHMENTS = [gl.COLOR_ATTACHMENT0]
 
+// Object types getMemoryUsage asks for, must match GLObjectType in webgl.h
+const GLObjectType = {
+  BUFFER: 0,
+  RENDERBUFFER: 3,
+  TEXTURE: 5
+}
+
+// Float32Array pixels of HALF_FLOAT_OES images are converted natively
+function isHalfFloat32 (type, pixels) {
+  return type === HALF_FLOAT_OES && pixels instanceof Float32Array
+}
+
 const availableExtensions = {
   // angle_instanced_arrays: getANGLEInstancedArrays,
   oes_element_index_uint: getOESElementIndexUint,
   oes_texture_float: getOESTextureFloat,
   oes_texture_float_linear: getOESTextureFloatLinear,
+  oes_texture_half_float: getOESTextureHalfFloat,
+  oes_texture_half_float_linear: getOESTextureHalfFloatLinear,
+  ext_color_buffer_half_float: getEXTColorBufferHalfFloat,
   oes_standard_derivatives: getOESStandardDerivatives,
   oes_vertex_array_object: getOESVertexArrayObject,
   stackgl_destroy_context: getSTACKGLDestroyContext,
   stackgl_resize_drawingbuffer: getSTACKGLResizeDrawingBuffer,
   webgl_draw_buffers: getWebGLDrawBuffers,
   ext_blend_minmax: getEXTBlendMinMax,
-  ext_texture_filter_anisotropic: getEXTTextureFilterAnisotropic
+  ext_texture_filter_anisotropic: getEXTTextureFilterAnisotropic,
+  webgl_compressed_texture_astc: getWebGLCompressedTextureASTC,
+  webgl_compressed_texture_etc: getWebGLCompressedTextureETC,
+  webgl_compressed_texture_etc1: getWebGLCompressedTextureETC1,
+  webgl_compressed_texture_s3tc: getWebGLCompressedTextureS3TC
 }
 
 const privateMethods = [
@@ -219,24 +253,6 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return !errorStatus
   }
 
-  _checkStencilState () {
-    if (!this._checkStencil) {
-      return this._stencilState
-    }
-    this._checkStencil = false
-    this._stencilState = true
-    if (this.getParameter(gl.STENCIL_WRITEMASK) !==
-      this.getParameter(gl.STENCIL_BACK_WRITEMASK) ||
-      this.getParameter(gl.STENCIL_VALUE_MASK) !==
-      this.getParameter(gl.STENCIL_BACK_VALUE_MASK) ||
-      this.getParameter(gl.STENCIL_REF) !==
-      this.getParameter(gl.STENCIL_BACK_REF)) {
-      this.setError(gl.INVALID_OPERATION)
-      this._stencilState = false
-    }
-    return this._stencilState
-  }
-
   _checkTextureTarget (target) {
     const unit = this._getActiveTextureUnit()
     let tex = null
@@ -270,41 +286,6 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return object instanceof Type && object._ !== 0
   }
 
-  _checkVertexAttribState (maxIndex) {
-    const program = this._activeProgram
-    if (!program) {
-      this.setError(gl.INVALID_OPERATION)
-      return false
-    }
-    const attribs = this._vertexObjectState._attribs
-    for (let i = 0; i < attribs.length; ++i) {
-      const attrib = attribs[i]
-      if (attrib._isPointer) {
-        const buffer = attrib._pointerBuffer
-        if (!buffer) {
-          this.setError(gl.INVALID_OPERATION)
-          return false
-        }
-        if (program._attributes.indexOf(i) >= 0) {
-          let maxByte = 0
-          if (attrib._divisor) {
-            maxByte = attrib._pointerSize +
-              attrib._pointerOffset
-          } else {
-            maxByte = attrib._pointerStride * maxIndex +
-              attrib._pointerSize +
-              attrib._pointerOffset
-          }
-          if (maxByte > buffer._size) {
-            this.setError(gl.INVALID_OPERATION)
-            return false
-          }
-        }
-      }
-    }
-    return true
-  }
-
   _checkVertexIndex (index) {
     if (index < 0 || index >= this._vertexObjectState._attribs.length) {
       this.setError(gl.INVALID_VALUE)
@@ -337,6 +318,8 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
         return 2
       case gl.FLOAT:
         return 1
+      case HALF_FLOAT_OES:
+        return pixelSize * 2
     }
     this.setError(gl.INVALID_ENUM)
     return 0
@@ -445,6 +428,20 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return super.getParameter(pname)
   }
 
+  // Storage of an attachment of the bound framebuffer changed
+  _attachmentChanged (object) {
+    const activeFramebuffer = this._activeFramebuffer
+    if (activeFramebuffer) {
+      const attachments = this._getAttachments()
+      for (let i = 0; i < attachments.length; ++i) {
+        if (activeFramebuffer._attachments[attachments[i]] === object) {
+          this._updateFramebufferAttachments(activeFramebuffer)
+          return
+        }
+      }
+    }
+  }
+
   _getTexImage (target) {
     const unit = this._getActiveTextureUnit()
     if (target === gl.TEXTURE_2D) {
@@ -457,110 +454,9 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
   }
 
   _preCheckFramebufferStatus (framebuffer) {
-    const attachments = framebuffer._attachments
-    const width = []
-    const height = []
-    const depthAttachment = attachments[gl.DEPTH_ATTACHMENT]
-    const depthStencilAttachment = attachments[gl.DEPTH_STENCIL_ATTACHMENT]
-    const stencilAttachment = attachments[gl.STENCIL_ATTACHMENT]
-
-    if ((depthStencilAttachment && (stencilAttachment || depthAttachment)) ||
-      (stencilAttachment && depthAttachment)) {
-      return gl.FRAMEBUFFER_UNSUPPORTED
-    }
-
-    const colorAttachments = this._getColorAttachments()
-    let colorAttachmentCount = 0
-    for (const attachmentEnum in attachments) {
-      if (attachments[attachmentEnum] && colorAttachments.indexOf(attachmentEnum * 1) !== -1) {
-        colorAttachmentCount++
-      }
-    }
-    if (colorAttachmentCount === 0) {
-      return gl.FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT
-    }
-
-    if (depthStencilAttachment instanceof WebGLTexture) {
-      return gl.FRAMEBUFFER_UNSUPPORTED
-    } else if (depthStencilAttachment instanceof WebGLRenderbuffer) {
-      if (depthStencilAttachment._format !== gl.DEPTH_STENCIL) {
-        return gl.FRAMEBUFFER_INCOMPLETE_ATTACHMENT
-      }
-      width.push(depthStencilAttachment._width)
-      height.push(depthStencilAttachment._height)
-    }
-
-    if (depthAttachment instanceof WebGLTexture) {
-      return gl.FRAMEBUFFER_UNSUPPORTED
-    } else if (depthAttachment instanceof WebGLRenderbuffer) {
-      if (depthAttachment._format !== gl.DEPTH_COMPONENT16) {
-        return gl.FRAMEBUFFER_INCOMPLETE_ATTACHMENT
-      }
-      width.push(depthAttachment._width)
-      height.push(depthAttachment._height)
-    }
-
-    if (stencilAttachment instanceof WebGLTexture) {
-      return gl.FRAMEBUFFER_UNSUPPORTED
-    } else if (stencilAttachment instanceof WebGLRenderbuffer) {
-      if (stencilAttachment._format !== gl.STENCIL_INDEX8) {
-        return gl.FRAMEBUFFER_INCOMPLETE_ATTACHMENT
-      }
-      width.push(stencilAttachment._width)
-      height.push(stencilAttachment._height)
-    }
-
-    let colorAttached = false
-    for (let i = 0; i < colorAttachments.length; ++i) {
-      const colorAttachment = attachments[colorAttachments[i]]
-      if (colorAttachment instanceof WebGLTexture) {
-        if (colorAttachment._format !== gl.RGBA ||
-          !(colorAttachment._type === gl.UNSIGNED_BYTE || colorAttachment._type === gl.FLOAT)) {
-          return gl.FRAMEBUFFER_INCOMPLETE_ATTACHMENT
-        }
-        colorAttached = true
-        const level = framebuffer._attachmentLevel[gl.COLOR_ATTACHMENT0]
-        width.push(colorAttachment._levelWidth[level])
-        height.push(colorAttachment._levelHeight[level])
-      } else if (colorAttachment instanceof WebGLRenderbuffer) {
-        const format = colorAttachment._format
-        if (format !== gl.RGBA4 &&
-          format !== gl.RGB565 &&
-          format !== gl.RGB5_A1) {
-          return gl.FRAMEBUFFER_INCOMPLETE_ATTACHMENT
-        }
-        colorAttached = true
-        width.push(colorAttachment._width)
-        height.push(colorAttachment._height)
-      }
-    }
-
-    if (!colorAttached &&
-      !stencilAttachment &&
-      !depthAttachment &&
-      !depthStencilAttachment) {
-      return gl.FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT
-    }
-
-    if (width.length <= 0 || height.length <= 0) {
-      return gl.FRAMEBUFFER_INCOMPLETE_ATTACHMENT
-    }
-
-    for (let i = 1; i < width.length; ++i) {
-      if (width[i - 1] !== width[i] ||
-        height[i - 1] !== height[i]) {
-        return gl.FRAMEBUFFER_INCOMPLETE_DIMENSIONS
-      }
-    }
-
-    if (width[0] === 0 || height[0] === 0) {
-      return gl.FRAMEBUFFER_INCOMPLETE_ATTACHMENT
-    }
-
-    framebuffer._width = width[0]
-    framebuffer._height = height[0]
-
-    return gl.FRAMEBUFFER_COMPLETE
+    // Checked natively against the attachments _updateFramebufferAttachments
+    // reports and the storage of the attached textures and renderbuffers
+    return super._framebufferStatus(framebuffer._ | 0)
   }
 
   _isConstantBlendFunc (factor) {
@@ -660,19 +556,6 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     this.bindRenderbuffer(gl.RENDERBUFFER, prevRenderbuffer)
   }
 
-  _restoreError (lastError) {
-    const topError = this._errorStack.pop()
-    if (topError === gl.NO_ERROR) {
-      this.setError(lastError)
-    } else {
-      this.setError(topError)
-    }
-  }
-
-  _saveError () {
-    this._errorStack.push(this.getError())
-  }
-
   _switchActiveProgram (active) {
     if (active) {
       active._refCount -= 1
@@ -701,6 +584,18 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
   _updateFramebufferAttachments (framebuffer) {
     const prevStatus = framebuffer._status
     const attachments = this._getAttachments()
+    for (let i = 0; i < attachments.length; ++i) {
+      const attachmentEnum = attachments[i]
+      const attachment = framebuffer._attachments[attachmentEnum]
+      super._framebufferAttachment(
+        framebuffer._ | 0,
+        attachmentEnum,
+        attachment instanceof WebGLTexture
+          ? gl.TEXTURE
+          : attachment instanceof WebGLRenderbuffer ? gl.RENDERBUFFER : gl.NONE,
+        attachment ? attachment._ | 0 : 0,
+        framebuffer._attachmentLevel[attachmentEnum] | 0)
+    }
     framebuffer._status = this._preCheckFramebufferStatus(framebuffer)
     if (framebuffer._status !== gl.FRAMEBUFFER_COMPLETE) {
       if (prevStatus === gl.FRAMEBUFFER_COMPLETE) {
@@ -820,8 +715,10 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       texture = unit._bindCube
     }
 
-    // oes_texture_float but not oes_texture_float_linear
-    if (this._extensions.oes_texture_float && !this._extensions.oes_texture_float_linear && texture && texture._type === gl.FLOAT && (pname === gl.TEXTURE_MAG_FILTER || pname === gl.TEXTURE_MIN_FILTER) && (param === gl.LINEAR || param === gl.LINEAR_MIPMAP_NEAREST || param === gl.NEAREST_MIPMAP_LINEAR || param === gl.LINEAR_MIPMAP_LINEAR)) {
+    // oes_texture_float but not oes_texture_float_linear, same for half floats
+    if (((this._extensions.oes_texture_float && !this._extensions.oes_texture_float_linear && texture && texture._type === gl.FLOAT) ||
+      (this._extensions.oes_texture_half_float && !this._extensions.oes_texture_half_float_linear && texture && texture._type === HALF_FLOAT_OES)) &&
+      (pname === gl.TEXTURE_MAG_FILTER || pname === gl.TEXTURE_MIN_FILTER) && (param === gl.LINEAR || param === gl.LINEAR_MIPMAP_NEAREST || param === gl.NEAREST_MIPMAP_LINEAR || param === gl.LINEAR_MIPMAP_LINEAR)) {
       texture._complete = false
       this.bindTexture(target, texture)
       return
@@ -844,40 +741,6 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return this._extensions.webgl_draw_buffers ? source : '#define gl_MaxDrawBuffers 1\n' + source // eslint-disable-line
   }
 
-  _beginAttrib0Hack () {
-    super.bindBuffer(gl.ARRAY_BUFFER, this._attrib0Buffer._)
-    super.bufferData(
-      gl.ARRAY_BUFFER,
-      this._vertexGlobalState._attribs[0]._data,
-      gl.STREAM_DRAW)
-    super.enableVertexAttribArray(0)
-    super.vertexAttribPointer(0, 4, gl.FLOAT, false, 0, 0)
-    super._vertexAttribDivisor(0, 1)
-  }
-
-  _endAttrib0Hack () {
-    const attrib = this._vertexObjectState._attribs[0]
-    if (attrib._pointerBuffer) {
-      super.bindBuffer(gl.ARRAY_BUFFER, attrib._pointerBuffer._)
-    } else {
-      super.bindBuffer(gl.ARRAY_BUFFER, 0)
-    }
-    super.vertexAttribPointer(
-      0,
-      attrib._inputSize,
-      attrib._pointerType,
-      attrib._pointerNormal,
-      attrib._inputStride,
-      attrib._pointerOffset)
-    super._vertexAttribDivisor(0, attrib._divisor)
-    super.disableVertexAttribArray(0)
-    if (this._vertexGlobalState._arrayBufferBinding) {
-      super.bindBuffer(gl.ARRAY_BUFFER, this._vertexGlobalState._arrayBufferBinding._)
-    } else {
-      super.bindBuffer(gl.ARRAY_BUFFER, 0)
-    }
-  }
-
   activeTexture (texture) {
     texture |= 0
     const texNum = texture - gl.TEXTURE0
@@ -901,16 +764,13 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       shader instanceof WebGLShader &&
       this._checkOwns(program) &&
       this._checkOwns(shader)) {
-      if (!program._linked(shader)) {
-        this._saveError()
+      // GL refuses a second shader of the same type, the program must not
+      // keep a reference to it
+      if (!program._references.some(attached => attached._type === shader._type)) {
         super.attachShader(
           program._ | 0,
           shader._ | 0)
-        const error = this.getError()
-        this._restoreError(error)
-        if (error === gl.NO_ERROR) {
-          program._link(shader)
-        }
+        program._link(shader)
         return
       }
     }
@@ -1080,16 +940,9 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       return
     }
 
-    this._saveError()
     super.bindTexture(
       target,
       textureId)
-    const error = this.getError()
-    this._restoreError(error)
-
-    if (error !== gl.NO_ERROR) {
-      return
-    }
 
     const activeUnit = this._getActiveTextureUnit()
     const activeTex = this._getActiveTexture(target)
@@ -1110,6 +963,11 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     } else if (target === gl.TEXTURE_CUBE_MAP) {
       activeUnit._bindCube = texture
     }
+
+    // Evicted textures without kept pixels are reloaded once bound
+    if (texture && texture._reload && super._textureEvicted(textureId)) {
+      texture._reload(this, target)
+    }
   }
 
   blendColor (red, green, blue, alpha) {
@@ -1141,6 +999,15 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return webGLBuffer
   }
 
+  // Non-standard, texture atlas packing images into shared pages
+  createAtlas (options) {
+    return new WebGLAtlas(this, options || {})
+  }
+
+  createCommandBuffer (capacity) {
+    return new WebGLCommandBuffer(this, capacity)
+  }
+
   createFramebuffer () {
     const id = super.createFramebuffer()
     if (id <= 0) return null
@@ -1185,6 +1052,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     const ext = availableExtensions[str] ? availableExtensions[str](this) : null
     if (ext) {
       this._extensions[str] = ext
+      super._enableExtension(str)
     }
     return ext
   }
@@ -1214,6 +1082,18 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       exts.push('OES_texture_float_linear')
     }
 
+    if (supportedExts.indexOf('GL_OES_texture_half_float') >= 0) {
+      exts.push('OES_texture_half_float')
+    }
+
+    if (supportedExts.indexOf('GL_OES_texture_half_float_linear') >= 0) {
+      exts.push('OES_texture_half_float_linear')
+    }
+
+    if (supportedExts.indexOf('GL_EXT_color_buffer_half_float') >= 0) {
+      exts.push('EXT_color_buffer_half_float')
+    }
+
     if (supportedExts.indexOf('EXT_draw_buffers') >= 0) {
       exts.push('WEBGL_draw_buffers')
     }
@@ -1230,9 +1110,48 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       exts.push('OES_vertex_array_object')
     }
 
+    if (supportedExts.indexOf('GL_OES_compressed_ETC1_RGB8_texture') >= 0) {
+      exts.push('WEBGL_compressed_texture_etc1')
+    }
+
+    // ETC2 and EAC are core in GLES3
+    if (supportedExts.indexOf('GL_ANGLE_compressed_texture_etc') >= 0 ||
+      String(super.getParameter(gl.VERSION)).startsWith('OpenGL ES 3')) {
+      exts.push('WEBGL_compressed_texture_etc')
+    }
+
+    if (supportedExts.indexOf('GL_EXT_texture_compression_s3tc') >= 0 ||
+      (supportedExts.indexOf('GL_EXT_texture_compression_dxt1') >= 0 &&
+        supportedExts.indexOf('GL_ANGLE_texture_compression_dxt3') >= 0 &&
+        supportedExts.indexOf('GL_ANGLE_texture_compression_dxt5') >= 0)) {
+      exts.push('WEBGL_compressed_texture_s3tc')
+    }
+
+    if (supportedExts.indexOf('GL_KHR_texture_compression_astc_ldr') >= 0) {
+      exts.push('WEBGL_compressed_texture_astc')
+    }
+
     return exts
   }
 
+  _hasDriverExtension (name) {
+    return super.getSupportedExtensions().indexOf(name) >= 0
+  }
+
+  // Formats of the compressed texture extensions enabled so far
+  _compressedTextureFormats () {
+    const formats = []
+    for (const name in this._extensions) {
+      const ext = this._extensions[name]
+      for (const key in ext) {
+        if (key.startsWith('COMPRESSED_')) {
+          formats.push(ext[key])
+        }
+      }
+    }
+    return formats
+  }
+
   setError (error) {
     gl.setError.call(this, error | 0)
   }
@@ -1306,31 +1225,20 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     }
 
     if (typeof data === 'object') {
-      let u8Data = null
-      if (isTypedArray(data) || data instanceof DataView) {
-        u8Data = unpackTypedArray(data)
-      } else if (data instanceof ArrayBuffer) {
-        u8Data = new Uint8Array(data)
-      } else {
+      if (!isBufferSource(data)) {
         this.setError(gl.INVALID_VALUE)
         return
       }
 
-      this._saveError()
-      super.bufferData(
+      // Storage errors are kept natively for getError
+      if (!super.bufferData(
         target,
-        u8Data,
-        usage)
-      const error = this.getError()
-      this._restoreError(error)
-      if (error !== gl.NO_ERROR) {
+        data,
+        usage)) {
         return
       }
 
-      active._size = u8Data.length
-      if (target === gl.ELEMENT_ARRAY_BUFFER) {
-        active._elements = new Uint8Array(u8Data)
-      }
+      active._size = data.byteLength
     } else if (typeof data === 'number') {
       const size = data | 0
       if (size < 0) {
@@ -1338,21 +1246,14 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
         return
       }
 
-      this._saveError()
-      super.bufferData(
+      if (!super.bufferData(
         target,
         size,
-        usage)
-      const error = this.getError()
-      this._restoreError(error)
-      if (error !== gl.NO_ERROR) {
+        usage)) {
         return
       }
 
       active._size = size
-      if (target === gl.ELEMENT_ARRAY_BUFFER) {
-        active._elements = new Uint8Array(size)
-      }
     } else {
       this.setError(gl.INVALID_VALUE)
     }
@@ -1388,29 +1289,20 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       return
     }
 
-    let u8Data = null
-    if (isTypedArray(data) || data instanceof DataView) {
-      u8Data = unpackTypedArray(data)
-    } else if (data instanceof ArrayBuffer) {
-      u8Data = new Uint8Array(data)
-    } else {
+    if (!isBufferSource(data)) {
       this.setError(gl.INVALID_VALUE)
       return
     }
 
-    if (offset + u8Data.length > active._size) {
+    if (offset + data.byteLength > active._size) {
       this.setError(gl.INVALID_VALUE)
       return
     }
 
-    if (target === gl.ELEMENT_ARRAY_BUFFER) {
-      active._elements.set(u8Data, offset)
-    }
-
     super.bufferSubData(
       target,
       offset,
-      u8Data)
+      data)
   }
 
   checkFramebufferStatus (target) {
@@ -1443,7 +1335,6 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
   }
 
   clearStencil (s) {
-    this._checkStencil = false
     return super.clearStencil(s | 0)
   }
 
@@ -1457,15 +1348,11 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     }
     if (this._checkWrapper(shader, WebGLShader) &&
       this._checkShaderSource(shader)) {
-      const prevError = this.getError()
       super.compileShader(shader._ | 0)
-      const error = this.getError()
       shader._compileStatus = !!super.getShaderParameter(
         shader._ | 0,
         gl.COMPILE_STATUS)
       shader._compileInfo = super.getShaderInfoLog(shader._ | 0)
-      this.getError()
-      this.setError(prevError || error)
     }
   }
 
@@ -1509,8 +1396,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       return
     }
 
-    this._saveError()
-    super.copyTexImage2D(
+    if (super.copyTexImage2D(
       target,
       level,
       internalFormat,
@@ -1518,11 +1404,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       y,
       width,
       height,
-      border)
-    const error = this.getError()
-    this._restoreError(error)
-
-    if (error === gl.NO_ERROR) {
+      border)) {
       texture._levelWidth[level] = width
       texture._levelHeight[level] = height
       texture._format = gl.RGBA
@@ -1777,6 +1659,16 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   destroy () {
     super.destroy()
+    const readbacks = this._readbacks
+    this._readbacks = []
+    for (const readback of readbacks) {
+      readback.reject(new Error('readPixelsAsync: context destroyed'))
+    }
+    const uploads = this._uploads
+    this._uploads = new Map()
+    for (const upload of uploads.values()) {
+      upload.reject(new Error('upload cancelled'))
+    }
   }
 
   detachShader (program, shader) {
@@ -1817,175 +1709,14 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     this._vertexObjectState._attribs[index]._isPointer = false
   }
 
+  // Validated natively, see WebGLRenderingContext::validateDrawArrays
   drawArrays (mode, first, count) {
-    mode |= 0
-    first |= 0
-    count |= 0
-
-    if (first < 0 || count < 0) {
-      this.setError(gl.INVALID_VALUE)
-      return
-    }
-
-    if (!this._checkStencilState()) {
-      return
-    }
-
-    const reducedCount = vertexCount(mode, count)
-    if (reducedCount < 0) {
-      this.setError(gl.INVALID_ENUM)
-      return
-    }
-
-    if (!this._framebufferOk()) {
-      return
-    }
-
-    if (count === 0) {
-      return
-    }
-
-    let maxIndex = first
-    if (count > 0) {
-      maxIndex = (count + first - 1) >>> 0
-    }
-    if (this._checkVertexAttribState(maxIndex)) {
-      if (
-        this._vertexObjectState._attribs[0]._isPointer || (
-          this._extensions.webgl_draw_buffers &&
-          this._extensions.webgl_draw_buffers._buffersState &&
-          this._extensions.webgl_draw_buffers._buffersState.length > 0
-        )
-      ) {
-        return super.drawArrays(mode, first, reducedCount)
-      } else {
-        this._beginAttrib0Hack()
-        super._drawArraysInstanced(mode, first, reducedCount, 1)
-        this._endAttrib0Hack()
-      }
-    }
+    return super.drawArrays(mode | 0, first | 0, count | 0)
   }
 
+  // Validated natively, see WebGLRenderingContext::validateDrawElements
   drawElements (mode, count, type, ioffset) {
-    mode |= 0
-    count |= 0
-    type |= 0
-    ioffset |= 0
-
-    if (count < 0 || ioffset < 0) {
-      this.setError(gl.INVALID_VALUE)
-      return
-    }
-
-    if (!this._checkStencilState()) {
-      return
-    }
-
-    const elementBuffer = this._vertexObjectState._elementArrayBufferBinding
-    if (!elementBuffer) {
-      this.setError(gl.INVALID_OPERATION)
-      return
-    }
-
-    // Unpack element data
-    let elementData = null
-    let offset = ioffset
-    if (type === gl.UNSIGNED_SHORT) {
-      if (offset % 2) {
-        this.setError(gl.INVALID_OPERATION)
-        return
-      }
-      offset >>= 1
-      elementData = new Uint16Array(elementBuffer._elements.buffer)
-    } else if (this._extensions.oes_element_index_uint && type === gl.UNSIGNED_INT) {
-      if (offset % 4) {
-        this.setError(gl.INVALID_OPERATION)
-        return
-      }
-      offset >>= 2
-      elementData = new Uint32Array(elementBuffer._elements.buffer)
-    } else if (type === gl.UNSIGNED_BYTE) {
-      elementData = elementBuffer._elements
-    } else {
-      this.setError(gl.INVALID_ENUM)
-      return
-    }
-
-    let reducedCount = count
-    switch (mode) {
-      case gl.TRIANGLES:
-        if (count % 3) {
-          reducedCount -= (count % 3)
-        }
-        break
-      case gl.LINES:
-        if (count % 2) {
-          reducedCount -= (count % 2)
-        }
-        break
-      case gl.POINTS:
-        break
-      case gl.LINE_LOOP:
-      case gl.LINE_STRIP:
-        if (count < 2) {
-          this.setError(gl.INVALID_OPERATION)
-          return
-        }
-        break
-      case gl.TRIANGLE_FAN:
-      case gl.TRIANGLE_STRIP:
-        if (count < 3) {
-          this.setError(gl.INVALID_OPERATION)
-          return
-        }
-        break
-      default:
-        this.setError(gl.INVALID_ENUM)
-        return
-    }
-
-    if (!this._framebufferOk()) {
-      return
-    }
-
-    if (count === 0) {
-      this._checkVertexAttribState(0)
-      return
-    }
-
-    if ((count + offset) >>> 0 > elementData.length) {
-      this.setError(gl.INVALID_OPERATION)
-      return
-    }
-
-    // Compute max index
-    let maxIndex = -1
-    for (let i = offset; i < offset + count; ++i) {
-      maxIndex = Math.max(maxIndex, elementData[i])
-    }
-
-    if (maxIndex < 0) {
-      this._checkVertexAttribState(0)
-      return
-    }
-
-    if (this._checkVertexAttribState(maxIndex)) {
-      if (reducedCount > 0) {
-        if (
-          this._vertexObjectState._attribs[0]._isPointer || (
-            this._extensions.webgl_draw_buffers &&
-            this._extensions.webgl_draw_buffers._buffersState &&
-            this._extensions.webgl_draw_buffers._buffersState.length > 0
-          )
-        ) {
-          return super.drawElements(mode, reducedCount, type, ioffset)
-        } else {
-          this._beginAttrib0Hack()
-          super._drawElementsInstanced(mode, reducedCount, type, ioffset, 1)
-          this._endAttrib0Hack()
-        }
-      }
-    }
+    return super.drawElements(mode | 0, count | 0, type | 0, ioffset | 0)
   }
 
   enable (cap) {
@@ -2206,7 +1937,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
         return 'WebGL GLSL ES 1.0 stack-gl'
 
       case gl.COMPRESSED_TEXTURE_FORMATS:
-        return new Uint32Array(0)
+        return new Uint32Array(this._compressedTextureFormats())
 
       // Int arrays
       case gl.MAX_VIEWPORT_DIMS:
@@ -2243,6 +1974,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       case gl.STENCIL_TEST:
       case gl.UNPACK_FLIP_Y_WEBGL:
       case gl.UNPACK_PREMULTIPLY_ALPHA_WEBGL:
+      case gl.PACK_REVERSE_ROW_ORDER_ANGLE:
         return !!super.getParameter(pname)
 
       case gl.ACTIVE_TEXTURE:
@@ -2346,6 +2078,32 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     }
   }
 
+  // Writes an array-valued parameter into dst without allocating, returns dst
+  getParameterInto (pname, dst) {
+    pname |= 0
+    if (!(dst instanceof Float32Array ||
+      dst instanceof Int32Array ||
+      dst instanceof Uint8Array)) {
+      throw new TypeError('getParameterInto(GLenum, Float32Array | Int32Array | Uint8Array)')
+    }
+    switch (pname) {
+      case gl.MAX_VIEWPORT_DIMS:
+      case gl.SCISSOR_BOX:
+      case gl.VIEWPORT:
+      case gl.ALIASED_LINE_WIDTH_RANGE:
+      case gl.ALIASED_POINT_SIZE_RANGE:
+      case gl.DEPTH_RANGE:
+      case gl.BLEND_COLOR:
+      case gl.COLOR_CLEAR_VALUE:
+      case gl.COLOR_WRITEMASK:
+        super.getParameterInto(pname, dst)
+        return dst
+      default:
+        this.setError(gl.INVALID_ENUM)
+        return null
+    }
+  }
+
   getShaderPrecisionFormat (
     shaderType,
     precisionType) {
@@ -2686,17 +2444,15 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
           //   return null
           // }
 
-          this._saveError()
-          for (let i = 0; this.getError() === gl.NO_ERROR; ++i) {
+          for (let i = 0; i < info.size; ++i) {
             const xloc = super.getUniformLocation(
               program._ | 0,
               baseName + '[' + i + ']')
-            if (this.getError() !== gl.NO_ERROR || xloc < 0) {
+            if (xloc < 0) {
               break
             }
             arrayLocs.push(xloc)
           }
-          this._restoreError(gl.NO_ERROR)
 
           result._array = arrayLocs
         } else if (/\[(\d+)\]$/.test(name)) {
@@ -2711,6 +2467,57 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return null
   }
 
+  // Uniform calls sent to GL and dropped because the value was unchanged
+  getUniformStats () {
+    const stats = super._getUniformStats()
+    return {
+      issued: stats[0],
+      skipped: stats[1]
+    }
+  }
+
+  // Native scratch memory: block size, bytes in use, peak bytes in a frame,
+  // allocations that didn't fit in the block and peak bytes of those
+  getArenaStats () {
+    const stats = super._getArenaStats()
+    return {
+      capacity: stats[0],
+      used: stats[1],
+      highWater: stats[2],
+      fallbacks: stats[3],
+      fallbackHighWater: stats[4]
+    }
+  }
+
+  // Non-standard, bytes of driver storage allocated through the context by
+  // type. The drawing buffer includes the EGL surface
+  getMemoryStats () {
+    const stats = super._getMemoryStats()
+    return {
+      textures: stats[0],
+      renderbuffers: stats[1],
+      buffers: stats[2],
+      drawingBuffer: stats[3],
+      total: stats[4],
+      budget: stats[5]
+    }
+  }
+
+  // Non-standard, bytes of storage of a texture, renderbuffer or buffer
+  getMemoryUsage (object) {
+    if (!checkObject(object)) {
+      throw new TypeError('getMemoryUsage(WebGLTexture | WebGLRenderbuffer | WebGLBuffer)')
+    }
+    if (object instanceof WebGLTexture && this._checkOwns(object)) {
+      return super._getObjectMemory(GLObjectType.TEXTURE, object._ | 0)
+    } else if (object instanceof WebGLRenderbuffer && this._checkOwns(object)) {
+      return super._getObjectMemory(GLObjectType.RENDERBUFFER, object._ | 0)
+    } else if (object instanceof WebGLBuffer && this._checkOwns(object)) {
+      return super._getObjectMemory(GLObjectType.BUFFER, object._ | 0)
+    }
+    return 0
+  }
+
   getVertexAttrib (index, pname) {
     index |= 0
     pname |= 0
@@ -2837,14 +2644,8 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     if (this._checkWrapper(program, WebGLProgram)) {
       program._linkCount += 1
       program._attributes = []
-      const prevError = this.getError()
       super.linkProgram(program._ | 0)
-      const error = this.getError()
-      if (error === gl.NO_ERROR) {
-        program._linkStatus = this._fixupLink(program)
-      }
-      this.getError()
-      this.setError(prevError || error)
+      program._linkStatus = this._fixupLink(program)
     }
   }
 
@@ -2884,124 +2685,122 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return super.polygonOffset(+factor, +units)
   }
 
-  readPixels (x, y, width, height, format, type, pixels) {
-    x |= 0
-    y |= 0
-    width |= 0
-    height |= 0
-
-    if (!(this._extensions.oes_texture_float && type === gl.FLOAT && format === gl.RGBA)) {
-      if (format === gl.RGB ||
-        format === gl.ALPHA ||
-        type !== gl.UNSIGNED_BYTE) {
-        this.setError(gl.INVALID_OPERATION)
-        return
-      } else if (format !== gl.RGBA) {
-        this.setError(gl.INVALID_ENUM)
-        return
-      } else if (
-        width < 0 ||
-        height < 0 ||
-        !(pixels instanceof Uint8Array)) {
+  // Size in bytes readPixels writes to pixels, -1 after raising an error
+  _readPixelsSize (width, height, format, type, pixels) {
+    // RGB and BGRA_EXT are non-standard, converted natively from RGBA
+    let pixelSize = 4
+    if (this._extensions.oes_texture_float && type === gl.FLOAT && format === gl.RGBA) {
+      pixelSize = 16
+      if (!(pixels instanceof Float32Array)) {
         this.setError(gl.INVALID_VALUE)
-        return
+        return -1
       }
+    } else if (format === gl.ALPHA ||
+      type !== gl.UNSIGNED_BYTE) {
+      this.setError(gl.INVALID_OPERATION)
+      return -1
+    } else if (format !== gl.RGBA &&
+      format !== gl.RGB &&
+      format !== gl.BGRA_EXT) {
+      this.setError(gl.INVALID_ENUM)
+      return -1
+    } else if (
+      width < 0 ||
+      height < 0 ||
+      !(pixels instanceof Uint8Array || pixels instanceof Uint8ClampedArray)) {
+      this.setError(gl.INVALID_VALUE)
+      return -1
+    } else if (format === gl.RGB) {
+      pixelSize = 3
     }
 
-    if (!this._framebufferOk()) {
-      return
-    }
-
-    let rowStride = width * 4
+    let rowStride = width * pixelSize
     if (rowStride % this._packAlignment !== 0) {
       rowStride += this._packAlignment - (rowStride % this._packAlignment)
     }
 
-    const imageSize = rowStride * (height - 1) + width * 4
+    const imageSize = rowStride * (height - 1) + width * pixelSize
     if (imageSize <= 0) {
-      return
+      return 0
     }
-    if (pixels.length < imageSize) {
+    if (pixels.byteLength < imageSize) {
       this.setError(gl.INVALID_VALUE)
-      return
+      return -1
     }
+    return imageSize
+  }
 
-    // Handle reading outside the window
-    let viewWidth = this.drawingBufferWidth
-    let viewHeight = this.drawingBufferHeight
+  readPixels (x, y, width, height, format, type, pixels) {
+    x |= 0
+    y |= 0
+    width |= 0
+    height |= 0
+    format |= 0
+    type |= 0
 
-    if (this._activeFramebuffer) {
-      viewWidth = this._activeFramebuffer._width
-      viewHeight = this._activeFramebuffer._height
+    if (this._readPixelsSize(width, height, format, type, pixels) <= 0) {
+      return
     }
 
-    const pixelData = unpackTypedArray(pixels)
+    // Clipping to the framebuffer, zero fill, row order and format
+    // conversion are done natively, straight into pixels
+    super.readPixels(
+      x,
+      y,
+      width,
+      height,
+      format,
+      type,
+      pixels)
+  }
 
-    if (x >= viewWidth || x + width <= 0 ||
-      y >= viewHeight || y + height <= 0) {
-      for (let i = 0; i < pixelData.length; ++i) {
-        pixelData[i] = 0
-      }
-    } else if (x < 0 || x + width > viewWidth ||
-      y < 0 || y + height > viewHeight) {
-      for (let i = 0; i < pixelData.length; ++i) {
-        pixelData[i] = 0
-      }
+  // Non-standard, readPixels without waiting for the GPU. The promise resolves
+  // with pixels once the fence after the read signaled, it is polled from the
+  // event loop. Reads that can't be deferred are done right away
+  readPixelsAsync (x, y, width, height, format, type, pixels) {
+    x |= 0
+    y |= 0
+    width |= 0
+    height |= 0
+    format |= 0
+    type |= 0
 
-      let nx = x
-      let nWidth = width
-      if (x < 0) {
-        nWidth += x
-        nx = 0
-      }
-      if (nx + width > viewWidth) {
-        nWidth = viewWidth - nx
-      }
-      let ny = y
-      let nHeight = height
-      if (y < 0) {
-        nHeight += y
-        ny = 0
-      }
-      if (ny + height > viewHeight) {
-        nHeight = viewHeight - ny
-      }
+    const imageSize = this._readPixelsSize(width, height, format, type, pixels)
+    if (imageSize < 0) {
+      return Promise.reject(new Error('readPixelsAsync: invalid arguments'))
+    }
+    if (imageSize === 0) {
+      return Promise.resolve(pixels)
+    }
 
-      let nRowStride = nWidth * 4
-      if (nRowStride % this._packAlignment !== 0) {
-        nRowStride += this._packAlignment - (nRowStride % this._packAlignment)
+    const id = super._readPixelsAsync(x, y, width, height, format, type)
+    if (id === 0) {
+      super.readPixels(x, y, width, height, format, type, pixels)
+      return Promise.resolve(pixels)
+    }
+    return new Promise((resolve, reject) => {
+      this._readbacks.push({ id, pixels, resolve, reject })
+      if (this._readbacks.length === 1) {
+        os.setTimeout(() => this._pollReadbacks(), READBACK_POLL_INTERVAL)
       }
+    })
+  }
 
-      if (nWidth > 0 && nHeight > 0) {
-        const subPixels = new Uint8Array(nRowStride * nHeight)
-        super.readPixels(
-          nx,
-          ny,
-          nWidth,
-          nHeight,
-          format,
-          type,
-          subPixels)
-
-        const offset = 4 * (nx - x) + (ny - y) * rowStride
-        for (let j = 0; j < nHeight; ++j) {
-          for (let i = 0; i < nWidth; ++i) {
-            for (let k = 0; k < 4; ++k) {
-              pixelData[offset + j * rowStride + 4 * i + k] =
-                subPixels[j * nRowStride + 4 * i + k]
-            }
-          }
-        }
+  _pollReadbacks () {
+    const pending = []
+    for (const readback of this._readbacks) {
+      const status = super._readPixelsAsyncResult(readback.id, readback.pixels)
+      if (status === 0) {
+        pending.push(readback)
+      } else if (status > 0) {
+        readback.resolve(readback.pixels)
+      } else {
+        readback.reject(new Error('readPixelsAsync: read failed'))
       }
-    } else {
-      super.readPixels(
-        x,
-        y,
-        width,
-        height,
-        format,
-        type,
-        pixelData)
+    }
+    this._readbacks = pending
+    if (pending.length > 0) {
+      os.setTimeout(() => this._pollReadbacks(), READBACK_POLL_INTERVAL)
     }
   }
 
@@ -3026,26 +2825,25 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       return
     }
 
+    const halfFloat = this._extensions.ext_color_buffer_half_float &&
+      (internalFormat === RGBA16F_EXT || internalFormat === RGB16F_EXT)
     if (internalFormat !== gl.RGBA4 &&
       internalFormat !== gl.RGB565 &&
       internalFormat !== gl.RGB5_A1 &&
       internalFormat !== gl.DEPTH_COMPONENT16 &&
       internalFormat !== gl.STENCIL_INDEX &&
       internalFormat !== gl.STENCIL_INDEX8 &&
-      internalFormat !== gl.DEPTH_STENCIL) {
+      internalFormat !== gl.DEPTH_STENCIL &&
+      !halfFloat) {
       this.setError(gl.INVALID_ENUM)
       return
     }
 
-    this._saveError()
-    super.renderbufferStorage(
+    if (!super.renderbufferStorage(
       target,
       internalFormat,
       width,
-      height)
-    const error = this.getError()
-    this._restoreError(error)
-    if (error !== gl.NO_ERROR) {
+      height)) {
       return
     }
 
@@ -3053,20 +2851,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     renderbuffer._height = height
     renderbuffer._format = internalFormat
 
-    const activeFramebuffer = this._activeFramebuffer
-    if (activeFramebuffer) {
-      let needsUpdate = false
-      const attachments = this._getAttachments()
-      for (let i = 0; i < attachments.length; ++i) {
-        if (activeFramebuffer._attachments[attachments[i]] === renderbuffer) {
-          needsUpdate = true
-          break
-        }
-      }
-      if (needsUpdate) {
-        this._updateFramebufferAttachments(this._activeFramebuffer)
-      }
-    }
+    this._attachmentChanged(renderbuffer)
   }
 
   resize (width, height) {
@@ -3079,6 +2864,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       this._resizeDrawingBuffer(width, height)
       this.drawingBufferWidth = width
       this.drawingBufferHeight = height
+      super._setDrawingBufferSize(width, height)
     }
   }
 
@@ -3108,35 +2894,46 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
   }
 
   stencilFunc (func, ref, mask) {
-    this._checkStencil = true
     return super.stencilFunc(func | 0, ref | 0, mask | 0)
   }
 
   stencilFuncSeparate (face, func, ref, mask) {
-    this._checkStencil = true
     return super.stencilFuncSeparate(face | 0, func | 0, ref | 0, mask | 0)
   }
 
   stencilMask (mask) {
-    this._checkStencil = true
     return super.stencilMask(mask | 0)
   }
 
   stencilMaskSeparate (face, mask) {
-    this._checkStencil = true
     return super.stencilMaskSeparate(face | 0, mask | 0)
   }
 
   stencilOp (fail, zfail, zpass) {
-    this._checkStencil = true
     return super.stencilOp(fail | 0, zfail | 0, zpass | 0)
   }
 
   stencilOpSeparate (face, fail, zfail, zpass) {
-    this._checkStencil = true
     return super.stencilOpSeparate(face | 0, fail | 0, zfail | 0, zpass | 0)
   }
 
+  submit (commandBuffer) {
+    if (!(commandBuffer instanceof WebGLCommandBuffer) ||
+      commandBuffer._ctx !== this) {
+      throw new TypeError('submit(WebGLCommandBuffer)')
+    }
+    if (commandBuffer._length === 0) {
+      return
+    }
+    // Names of deleted objects may have been reused by GL
+    if (!commandBuffer._objectsAlive()) {
+      this.setError(gl.INVALID_OPERATION)
+      return
+    }
+    super._submit(commandBuffer._u32, commandBuffer._length)
+    commandBuffer._sync(this)
+  }
+
   texImage2D (
     target,
     level,
@@ -3176,25 +2973,54 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       throw new TypeError('texImage2D(GLenum, GLint, GLenum, GLint, GLint, GLint, GLenum, GLenum, Uint8Array)')
     }
 
+    const texture = this._checkTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels)
+    if (!texture) {
+      return
+    }
+
+    // Out of memory errors are kept natively for getError
+    if (isHalfFloat32(type, pixels)) {
+      if (!super._texImage2DFloat32(target, level, internalFormat, width, height, border, format, pixels)) {
+        return
+      }
+    } else if (!super.texImage2D(
+      target,
+      level,
+      internalFormat,
+      width,
+      height,
+      border,
+      format,
+      type,
+      isBufferSource(pixels) ? pixels : null)) {
+      return
+    }
+
+    this._texImageSpecified(texture, level, width, height, format, type)
+  }
+
+  // Texture texImage2D and enqueueTexImage2D specify, null after raising an error
+  _checkTexImage2D (target, level, internalFormat, width, height, border, format, type, pixels) {
     if (!checkFormat(format) || !checkFormat(internalFormat)) {
       this.setError(gl.INVALID_ENUM)
-      return
+      return null
     }
 
-    if (type === gl.FLOAT && !this._extensions.oes_texture_float) {
+    if ((type === gl.FLOAT && !this._extensions.oes_texture_float) ||
+      (type === HALF_FLOAT_OES && !this._extensions.oes_texture_half_float)) {
       this.setError(gl.INVALID_ENUM)
-      return
+      return null
     }
 
     const texture = this._getTexImage(target)
     if (!texture || format !== internalFormat) {
       this.setError(gl.INVALID_OPERATION)
-      return
+      return null
     }
 
     const pixelSize = this._computePixelSize(type, format)
     if (pixelSize === 0) {
-      return
+      return null
     }
 
     if (!this._checkDimensions(
@@ -3202,63 +3028,273 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       width,
       height,
       level)) {
-      return
+      return null
     }
 
-    const data = convertPixels(pixels)
-    const rowStride = this._computeRowStride(width, pixelSize)
+    const data = isBufferSource(pixels) ? pixels : null
+    const rowStride = this._computeRowStride(width, isHalfFloat32(type, data) ? pixelSize * 2 : pixelSize)
     const imageSize = rowStride * height
 
-    if (data && data.length < imageSize) {
+    if (data && data.byteLength < imageSize) {
       this.setError(gl.INVALID_OPERATION)
-      return
+      return null
     }
 
     if (border !== 0 ||
       (validCubeTarget(target) && width !== height)) {
       this.setError(gl.INVALID_VALUE)
-      return
-    }
-    // Need to check for out of memory error
-    this._saveError()
-    super.texImage2D(
-      target,
-      level,
-      internalFormat,
-      width,
-      height,
-      border,
-      format,
-      type,
-      data)
-    const error = this.getError()
-    this._restoreError(error)
-    if (error !== gl.NO_ERROR) {
-      return
+      return null
     }
+    return texture
+  }
 
-    // Save width and height at level
+  // Save width and height at level
+  _texImageSpecified (texture, level, width, height, format, type) {
     texture._levelWidth[level] = width
     texture._levelHeight[level] = height
     texture._format = format
     texture._type = type
 
-    const activeFramebuffer = this._activeFramebuffer
-    if (activeFramebuffer) {
-      let needsUpdate = false
-      const attachments = this._getAttachments()
-      for (let i = 0; i < attachments.length; ++i) {
-        if (activeFramebuffer._attachments[attachments[i]] === texture) {
-          needsUpdate = true
-          break
-        }
+    this._attachmentChanged(texture)
+  }
+
+  // Non-standard, texImage2D spread over frames. The level is allocated right
+  // away, its pixels are copied and sent in strips of rows by swap() and
+  // processUploads() within the upload budget, unpacked with the pixel storage
+  // state of this call. The promise resolves once every row was sent and is
+  // rejected when the texture is deleted or respecified first
+  enqueueTexImage2D (target, level, internalFormat, width, height, border, format, type, pixels) {
+    target |= 0
+    level |= 0
+    internalFormat |= 0
+    width |= 0
+    height |= 0
+    border |= 0
+    format |= 0
+    type |= 0
+
+    if (!isBufferSource(pixels)) {
+      throw new TypeError('enqueueTexImage2D(GLenum, GLint, GLenum, GLint, GLint, GLint, GLenum, GLenum, ArrayBufferView)')
+    }
+    // Queued rows are sent as they are, half floats have to be 16 bit already
+    if (isHalfFloat32(type, pixels)) {
+      this.setError(gl.INVALID_OPERATION)
+      return Promise.reject(new Error('enqueueTexImage2D: Float32Array pixels for HALF_FLOAT_OES'))
+    }
+
+    const texture = this._checkTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels)
+    if (!texture) {
+      return Promise.reject(new Error('enqueueTexImage2D: invalid arguments'))
+    }
+    const id = super._enqueueTexImage2D(target, level, internalFormat, width, height, format, type, pixels)
+    if (id === 0) {
+      return Promise.reject(new Error('enqueueTexImage2D: allocation failed'))
+    }
+
+    this._texImageSpecified(texture, level, width, height, format, type)
+    return this._queueUpload(id)
+  }
+
+  // Non-standard, bufferData spread over frames like enqueueTexImage2D, the
+  // buffer is allocated right away and filled in chunks
+  enqueueBufferData (target, data, usage) {
+    target |= 0
+    usage |= 0
+
+    if (!isBufferSource(data)) {
+      throw new TypeError('enqueueBufferData(GLenum, ArrayBufferView, GLenum)')
+    }
+    if ((usage !== gl.STREAM_DRAW &&
+      usage !== gl.STATIC_DRAW &&
+      usage !== gl.DYNAMIC_DRAW) ||
+      (target !== gl.ARRAY_BUFFER &&
+      target !== gl.ELEMENT_ARRAY_BUFFER)) {
+      this.setError(gl.INVALID_ENUM)
+      return Promise.reject(new Error('enqueueBufferData: invalid arguments'))
+    }
+
+    const active = this._getActiveBuffer(target)
+    if (!active) {
+      this.setError(gl.INVALID_OPERATION)
+      return Promise.reject(new Error('enqueueBufferData: no buffer bound'))
+    }
+    const id = super._enqueueBufferData(target, data, usage)
+    if (id === 0) {
+      return Promise.reject(new Error('enqueueBufferData: allocation failed'))
+    }
+
+    active._size = data.byteLength
+    return this._queueUpload(id)
+  }
+
+  _queueUpload (id) {
+    return new Promise((resolve, reject) => {
+      this._uploads.set(id, { resolve, reject })
+    })
+  }
+
+  // Settles the promises of the uploads that were sent or dropped
+  _settleUploads () {
+    if (this._uploads.size === 0) {
+      return
+    }
+    for (const id of super._takeFinishedUploads()) {
+      const upload = this._uploads.get(Math.abs(id))
+      if (!upload) {
+        continue
       }
-      if (needsUpdate) {
-        this._updateFramebufferAttachments(this._activeFramebuffer)
+      this._uploads.delete(Math.abs(id))
+      if (id > 0) {
+        upload.resolve()
+      } else {
+        upload.reject(new Error('upload cancelled'))
       }
     }
   }
 
+  // Non-standard, sends queued uploads within the budget. swap() does it too
+  processUploads () {
+    super._processUploads()
+    this._settleUploads()
+  }
+
+  // Non-standard, microseconds of queued uploads sent per swap() or
+  // processUploads() call, at least one strip is always sent
+  setUploadBudget (microseconds) {
+    super._setUploadBudget(microseconds | 0)
+  }
+
+  // Non-standard, bytes of storage after which callback is called with the
+  // memory stats, once per crossing and from swap(). 0 removes the budget
+  setMemoryBudget (bytes, callback) {
+    this._memoryBudgetCallback = typeof callback === 'function' ? callback : null
+    super._setMemoryBudget(Math.max(+bytes || 0, 0))
+  }
+
+  // Non-standard, puts a texture under the residency manager. Its pixels are
+  // kept from the next texImage2D calls so that it can be evicted and
+  // restored transparently, unless reload is given: reload(gl, target) is then
+  // called with the evicted texture bound and specifies its images again
+  manageTexture (texture, reload) {
+    if (!checkObject(texture) || !(texture instanceof WebGLTexture)) {
+      throw new TypeError('manageTexture(WebGLTexture, Function)')
+    }
+    if (!this._checkOwns(texture) || texture._pendingDelete) {
+      this.setError(gl.INVALID_OPERATION)
+      return
+    }
+    texture._reload = typeof reload === 'function' ? reload : null
+    super._manageTexture(texture._ | 0, !texture._reload)
+  }
+
+  unmanageTexture (texture) {
+    if (!checkObject(texture) || !(texture instanceof WebGLTexture)) {
+      throw new TypeError('unmanageTexture(WebGLTexture)')
+    }
+    if (this._checkOwns(texture)) {
+      texture._reload = null
+      super._unmanageTexture(texture._ | 0)
+    }
+  }
+
+  // Non-standard, bytes of texture storage managed textures are evicted to
+  // stay under, least recently bound first. 0 disables eviction
+  setResidencyBudget (bytes) {
+    super._setResidencyBudget(Math.max(+bytes || 0, 0))
+  }
+
+  // Non-standard, managed textures by state, bytes of pixels kept on the CPU,
+  // evictions and restores so far
+  getResidencyStats () {
+    const stats = super._getResidencyStats()
+    return {
+      managed: stats[0],
+      resident: stats[1],
+      evicted: stats[2],
+      keptBytes: stats[3],
+      evictions: stats[4],
+      restores: stats[5],
+      budget: stats[6]
+    }
+  }
+
+  swap () {
+    super.swap()
+    this._settleUploads()
+    if (this._memoryBudgetCallback && super._takeMemoryBudgetCrossed()) {
+      this._memoryBudgetCallback(this.getMemoryStats())
+    }
+  }
+
+  // Non-standard, decodes a PNG, JPEG, BMP or TGA image on a native thread and
+  // uploads it to level of the texture bound to target when the call is made.
+  // options.format is RGBA (default), RGB, LUMINANCE or LUMINANCE_ALPHA,
+  // options.flipY and options.premultiplyAlpha default to the unpack state.
+  // The promise resolves with the texture once the image is uploaded
+  texImage2DFromEncoded (target, level, bytes, options) {
+    target |= 0
+    level |= 0
+    options = options || {}
+    const format = options.format === undefined ? gl.RGBA : options.format | 0
+    const flipY = options.flipY === undefined
+      ? this.getParameter(gl.UNPACK_FLIP_Y_WEBGL) : !!options.flipY
+    const premultiply = options.premultiplyAlpha === undefined
+      ? this.getParameter(gl.UNPACK_PREMULTIPLY_ALPHA_WEBGL) : !!options.premultiplyAlpha
+
+    if (!isBufferSource(bytes)) {
+      throw new TypeError('texImage2DFromEncoded(GLenum, GLint, ArrayBuffer | ArrayBufferView, Object)')
+    }
+    if (format !== gl.RGBA &&
+      format !== gl.RGB &&
+      format !== gl.LUMINANCE &&
+      format !== gl.LUMINANCE_ALPHA) {
+      this.setError(gl.INVALID_ENUM)
+      return Promise.reject(new Error('texImage2DFromEncoded: invalid format'))
+    }
+    const texture = this._getTexImage(target)
+    if (!texture) {
+      this.setError(gl.INVALID_OPERATION)
+      return Promise.reject(new Error('texImage2DFromEncoded: no texture bound'))
+    }
+
+    const id = super._decodeImage(bytes, format, flipY, premultiply)
+    if (id === 0) {
+      return Promise.reject(new Error('texImage2DFromEncoded: built without an image decoder'))
+    }
+    return new Promise((resolve, reject) => {
+      const poll = () => {
+        const [status, width, height] = super._getDecodedImage(id)
+        if (status === 0) {
+          os.setTimeout(poll, DECODE_POLL_INTERVAL)
+          return
+        }
+        if (status < 0) {
+          reject(new Error('texImage2DFromEncoded: decoding failed'))
+          return
+        }
+        if (texture._ === 0) {
+          super._releaseDecodedImage(id)
+          reject(new Error('texImage2DFromEncoded: texture deleted'))
+          return
+        }
+        if (!this._checkDimensions(target, width, height, level) ||
+          (validCubeTarget(target) && width !== height)) {
+          super._releaseDecodedImage(id)
+          reject(new Error('texImage2DFromEncoded: invalid image size'))
+          return
+        }
+        if (!super._texImage2DDecoded(id, texture._, target, level)) {
+          reject(new Error('texImage2DFromEncoded: upload failed'))
+          return
+        }
+
+        this._texImageSpecified(texture, level, width, height, format, gl.UNSIGNED_BYTE)
+        resolve(texture)
+      }
+      os.setTimeout(poll, 0)
+    })
+  }
+
   texSubImage2D (
     target,
     level,
@@ -3304,7 +3340,8 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       return
     }
 
-    if (type === gl.FLOAT && !this._extensions.oes_texture_float) {
+    if ((type === gl.FLOAT && !this._extensions.oes_texture_float) ||
+      (type === HALF_FLOAT_OES && !this._extensions.oes_texture_half_float)) {
       this.setError(gl.INVALID_ENUM)
       return
     }
@@ -3327,15 +3364,20 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
       return
     }
 
-    const data = convertPixels(pixels)
-    const rowStride = this._computeRowStride(width, pixelSize)
+    const data = isBufferSource(pixels) ? pixels : null
+    const rowStride = this._computeRowStride(width, isHalfFloat32(type, data) ? pixelSize * 2 : pixelSize)
     const imageSize = rowStride * height
 
-    if (!data || data.length < imageSize) {
+    if (!data || data.byteLength < imageSize) {
       this.setError(gl.INVALID_OPERATION)
       return
     }
 
+    if (isHalfFloat32(type, data)) {
+      super._texSubImage2DFloat32(target, level, xoffset, yoffset, width, height, format, data)
+      return
+    }
+
     super.texSubImage2D(
       target,
       level,
@@ -3414,12 +3456,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
   validateProgram (program) {
     if (this._checkWrapper(program, WebGLProgram)) {
       super.validateProgram(program._ | 0)
-      const error = this.getError()
-      if (error === gl.NO_ERROR) {
-        program._linkInfoLog = super.getProgramInfoLog(program._ | 0)
-      }
-      this.getError()
-      this.setError(error)
+      program._linkInfoLog = super.getProgramInfoLog(program._ | 0)
     }
   }
 
@@ -3505,6 +3542,8 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
         super.createFramebuffer(),
         super.createTexture(),
         super.createRenderbuffer())
+    super._setDrawingBuffer(this._drawingBuffer._framebuffer)
+    super._setDrawingBufferStorage(this._drawingBuffer._color, this._drawingBuffer._depthStencil)
     if(resizeBuffer)
       this._resizeDrawingBuffer(width, height)
   }
@@ -3513,12 +3552,132 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return false
   }
 
-  compressedTexImage2D () {
-    // TODO not yet implemented
+  compressedTexImage2D (target, level, internalFormat, width, height, border, data) {
+    target |= 0
+    level |= 0
+    internalFormat |= 0
+    width |= 0
+    height |= 0
+    border |= 0
+
+    if (!isBufferSource(data)) {
+      throw new TypeError('compressedTexImage2D(GLenum, GLint, GLenum, GLint, GLint, GLint, ArrayBufferView)')
+    }
+
+    if (this._compressedTextureFormats().indexOf(internalFormat) < 0) {
+      this.setError(gl.INVALID_ENUM)
+      return
+    }
+
+    const texture = this._getTexImage(target)
+    if (!texture) {
+      this.setError(gl.INVALID_OPERATION)
+      return
+    }
+
+    if (!this._checkDimensions(
+      target,
+      width,
+      height,
+      level)) {
+      return
+    }
+
+    if (border !== 0 ||
+      (validCubeTarget(target) && width !== height)) {
+      this.setError(gl.INVALID_VALUE)
+      return
+    }
+
+    if (!this._checkCompressedLevel(internalFormat, level, width, height) ||
+      data.byteLength !== compressedImageSize(internalFormat, width, height)) {
+      this.setError(gl.INVALID_VALUE)
+      return
+    }
+
+    // Out of memory errors are kept natively for getError
+    if (!super.compressedTexImage2D(
+      target,
+      level,
+      internalFormat,
+      width,
+      height,
+      border,
+      data)) {
+      return
+    }
+
+    this._texImageSpecified(texture, level, width, height, internalFormat, 0)
+  }
+
+  compressedTexSubImage2D (target, level, xoffset, yoffset, width, height, format, data) {
+    target |= 0
+    level |= 0
+    xoffset |= 0
+    yoffset |= 0
+    width |= 0
+    height |= 0
+    format |= 0
+
+    if (!isBufferSource(data)) {
+      throw new TypeError('compressedTexSubImage2D(GLenum, GLint, GLint, GLint, GLint, GLint, GLenum, ArrayBufferView)')
+    }
+
+    if (this._compressedTextureFormats().indexOf(format) < 0) {
+      this.setError(gl.INVALID_ENUM)
+      return
+    }
+
+    const texture = this._getTexImage(target)
+    // ETC1 images can only be replaced whole
+    if (!texture || texture._format !== format || format === 0x8D64) {
+      this.setError(gl.INVALID_OPERATION)
+      return
+    }
+
+    if (!this._checkDimensions(
+      target,
+      width,
+      height,
+      level)) {
+      return
+    }
+
+    const levelWidth = texture._levelWidth[level] | 0
+    const levelHeight = texture._levelHeight[level] | 0
+    if (xoffset < 0 || yoffset < 0 ||
+      xoffset + width > levelWidth ||
+      yoffset + height > levelHeight) {
+      this.setError(gl.INVALID_VALUE)
+      return
+    }
+
+    // Whole blocks only, the last ones may be cut by the edge of the level
+    const [blockWidth, blockHeight] = compressedBlockSize(format)
+    if (xoffset % blockWidth !== 0 || yoffset % blockHeight !== 0 ||
+      (width % blockWidth !== 0 && xoffset + width !== levelWidth) ||
+      (height % blockHeight !== 0 && yoffset + height !== levelHeight)) {
+      this.setError(gl.INVALID_OPERATION)
+      return
+    }
+
+    if (data.byteLength !== compressedImageSize(format, width, height)) {
+      this.setError(gl.INVALID_VALUE)
+      return
+    }
+
+    super.compressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, data)
   }
 
-  compressedTexSubImage2D () {
-    // TODO not yet implemented
+  // S3TC level 0 is made of whole blocks, smaller levels can be 1 or 2 texels wide
+  _checkCompressedLevel (format, level, width, height) {
+    if (format < 0x83F0 || format > 0x83F3) {
+      return true
+    }
+    if (level === 0) {
+      return width % 4 === 0 && height % 4 === 0
+    }
+    return (width <= 2 || width % 4 === 0) && (height <= 2 || height % 4 === 0)
   }
 
   _checkUniformValid (location, v0, name, count, type) {
@@ -3578,6 +3737,14 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
     return false
   }
 
+  // Number of elements to upload, array uniforms are set with a single call
+  _uniformCount (location, value, size) {
+    if (location._array) {
+      return Math.min(location._array.length, value.length / size)
+    }
+    return 1
+  }
+
   uniform1f (location, v0) {
     if (!this._checkUniformValid(location, v0, 'uniform1f', 1, 'f')) return
     super.uniform1f(location._ | 0, v0)
@@ -3585,15 +3752,10 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform1fv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform1fv', 1, 'f')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform1f(loc, value[i])
-      }
-      return
-    }
-    super.uniform1f(location._ | 0, value[0])
+    super.uniform1fv(
+      location._ | 0,
+      this._uniformCount(location, value, 1),
+      value instanceof Float32Array ? value : new Float32Array(value))
   }
 
   uniform1i (location, v0) {
@@ -3603,15 +3765,11 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform1iv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform1iv', 1, 'i')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform1i(loc, value[i])
-      }
-      return
-    }
-    this.uniform1i(location, value[0])
+    if (!location._array && !this._checkUniformValid(location, value[0], 'uniform1iv', 1, 'i')) return
+    super.uniform1iv(
+      location._ | 0,
+      this._uniformCount(location, value, 1),
+      value instanceof Int32Array ? value : new Int32Array(value))
   }
 
   uniform2f (location, v0, v1) {
@@ -3621,15 +3779,10 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform2fv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform2fv', 2, 'f')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && 2 * i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform2f(loc, value[2 * i], value[(2 * i) + 1])
-      }
-      return
-    }
-    super.uniform2f(location._ | 0, value[0], value[1])
+    super.uniform2fv(
+      location._ | 0,
+      this._uniformCount(location, value, 2),
+      value instanceof Float32Array ? value : new Float32Array(value))
   }
 
   uniform2i (location, v0, v1) {
@@ -3639,15 +3792,11 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform2iv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform2iv', 2, 'i')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && 2 * i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform2i(loc, value[2 * i], value[2 * i + 1])
-      }
-      return
-    }
-    this.uniform2i(location, value[0], value[1])
+    if (!location._array && !this._checkUniformValid(location, value[0], 'uniform2iv', 2, 'i')) return
+    super.uniform2iv(
+      location._ | 0,
+      this._uniformCount(location, value, 2),
+      value instanceof Int32Array ? value : new Int32Array(value))
   }
 
   uniform3f (location, v0, v1, v2) {
@@ -3657,15 +3806,10 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform3fv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform3fv', 3, 'f')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && 3 * i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform3f(loc, value[3 * i], value[3 * i + 1], value[3 * i + 2])
-      }
-      return
-    }
-    super.uniform3f(location._ | 0, value[0], value[1], value[2])
+    super.uniform3fv(
+      location._ | 0,
+      this._uniformCount(location, value, 3),
+      value instanceof Float32Array ? value : new Float32Array(value))
   }
 
   uniform3i (location, v0, v1, v2) {
@@ -3675,15 +3819,11 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform3iv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform3iv', 3, 'i')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && 3 * i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform3i(loc, value[3 * i], value[3 * i + 1], value[3 * i + 2])
-      }
-      return
-    }
-    this.uniform3i(location, value[0], value[1], value[2])
+    if (!location._array && !this._checkUniformValid(location, value[0], 'uniform3iv', 3, 'i')) return
+    super.uniform3iv(
+      location._ | 0,
+      this._uniformCount(location, value, 3),
+      value instanceof Int32Array ? value : new Int32Array(value))
   }
 
   uniform4f (location, v0, v1, v2, v3) {
@@ -3693,15 +3833,10 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform4fv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform4fv', 4, 'f')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && 4 * i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform4f(loc, value[4 * i], value[4 * i + 1], value[4 * i + 2], value[4 * i + 3])
-      }
-      return
-    }
-    super.uniform4f(location._ | 0, value[0], value[1], value[2], value[3])
+    super.uniform4fv(
+      location._ | 0,
+      this._uniformCount(location, value, 4),
+      value instanceof Float32Array ? value : new Float32Array(value))
   }
 
   uniform4i (location, v0, v1, v2, v3) {
@@ -3711,15 +3846,11 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniform4iv (location, value) {
     if (!this._checkUniformValueValid(location, value, 'uniform4iv', 4, 'i')) return
-    if (location._array) {
-      const locs = location._array
-      for (let i = 0; i < locs.length && 4 * i < value.length; ++i) {
-        const loc = locs[i]
-        super.uniform4i(loc, value[4 * i], value[4 * i + 1], value[4 * i + 2], value[4 * i + 3])
-      }
-      return
-    }
-    this.uniform4i(location, value[0], value[1], value[2], value[3])
+    if (!location._array && !this._checkUniformValid(location, value[0], 'uniform4iv', 4, 'i')) return
+    super.uniform4iv(
+      location._ | 0,
+      this._uniformCount(location, value, 4),
+      value instanceof Int32Array ? value : new Int32Array(value))
   }
 
   _checkUniformMatrix (location, transpose, value, name, count) {
@@ -3752,7 +3883,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniformMatrix2fv (location, transpose, value) {
     if (!this._checkUniformMatrix(location, transpose, value, 'uniformMatrix2fv', 2)) return
-    const data = new Float32Array(value)
+    const data = value instanceof Float32Array ? value : new Float32Array(value)
     super.uniformMatrix2fv(
       location._ | 0,
       !!transpose,
@@ -3761,7 +3892,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniformMatrix3fv (location, transpose, value) {
     if (!this._checkUniformMatrix(location, transpose, value, 'uniformMatrix3fv', 3)) return
-    const data = new Float32Array(value)
+    const data = value instanceof Float32Array ? value : new Float32Array(value)
     super.uniformMatrix3fv(
       location._ | 0,
       !!transpose,
@@ -3770,7 +3901,7 @@ class WebGLRenderingContext extends NativeWebGLRenderingContext {
 
   uniformMatrix4fv (location, transpose, value) {
     if (!this._checkUniformMatrix(location, transpose, value, 'uniformMatrix4fv', 4)) return
-    const data = new Float32Array(value)
+    const data = value instanceof Float32Array ? value : new Float32Array(value)
     super.uniformMatrix4fv(
       location._ | 0,
       !!transpose,
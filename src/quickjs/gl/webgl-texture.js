@@ -11,6 +11,7 @@ class WebGLTexture extends Linkable {
     this._format = 0
     this._type = 0
     this._complete = true
+    this._reload = null
   }
 
   _performDelete () {
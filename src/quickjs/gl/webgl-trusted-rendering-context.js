@@ -0,0 +1,276 @@
+import { gl } from './native-gl.js'
+import { typeSize } from './utils.js'
+import { WebGLRenderingContext } from './webgl-rendering-context.js'
+
+// Methods taking only numbers are used straight from the native prototype, the
+// bindings coerce the arguments and the native state shadow drops redundant calls
+const nativeMethods = [
+  'blendColor',
+  'blendEquation',
+  'blendEquationSeparate',
+  'blendFunc',
+  'blendFuncSeparate',
+  'clear',
+  'clearColor',
+  'clearDepth',
+  'clearStencil',
+  'colorMask',
+  'cullFace',
+  'depthFunc',
+  'depthMask',
+  'depthRange',
+  'disable',
+  'drawArrays',
+  'drawElements',
+  'enable',
+  'finish',
+  'flush',
+  'frontFace',
+  'hint',
+  'isEnabled',
+  'lineWidth',
+  'polygonOffset',
+  'sampleCoverage',
+  'scissor',
+  'stencilFunc',
+  'stencilFuncSeparate',
+  'stencilMask',
+  'stencilMaskSeparate',
+  'stencilOp',
+  'stencilOpSeparate',
+  'viewport'
+]
+
+// Context returned by createContext(..., { validation: 'none' }). Arguments are
+// trusted: wrappers are unwrapped without type, ownership or deletion checks and
+// WebGL-only errors are not raised, only the bookkeeping the validated methods
+// and object lifetimes depend on is kept. Overrides call the native methods
+// directly, everything not overridden here still goes through
+// WebGLRenderingContext.
+class WebGLTrustedRenderingContext extends WebGLRenderingContext {
+  activeTexture (texture) {
+    this._activeTextureUnit = texture - gl.TEXTURE0
+    gl.activeTexture.call(this, texture)
+  }
+
+  bindBuffer (target, buffer) {
+    if (!buffer) {
+      buffer = null
+      gl.bindBuffer.call(this, target, 0)
+    } else {
+      buffer._binding = target
+      gl.bindBuffer.call(this, target, buffer._)
+    }
+
+    if (target === gl.ARRAY_BUFFER) {
+      this._vertexGlobalState.setArrayBuffer(buffer)
+    } else {
+      this._vertexObjectState.setElementArrayBuffer(buffer)
+    }
+  }
+
+  bindTexture (target, texture) {
+    if (!texture) {
+      texture = null
+      gl.bindTexture.call(this, target, 0)
+    } else {
+      texture._binding = target
+      gl.bindTexture.call(this, target, texture._complete ? texture._ : 0)
+    }
+
+    const activeUnit = this._textureUnits[this._activeTextureUnit]
+    const activeTex = target === gl.TEXTURE_2D ? activeUnit._bind2D : activeUnit._bindCube
+    if (activeTex !== texture) {
+      if (activeTex) {
+        activeTex._refCount -= 1
+        activeTex._checkDelete()
+      }
+      if (texture) {
+        texture._refCount += 1
+      }
+    }
+
+    if (target === gl.TEXTURE_2D) {
+      activeUnit._bind2D = texture
+    } else {
+      activeUnit._bindCube = texture
+    }
+  }
+
+  useProgram (program) {
+    if (this._activeProgram !== program) {
+      this._switchActiveProgram(this._activeProgram)
+      this._activeProgram = program || null
+      if (program) {
+        program._refCount += 1
+      }
+    }
+    gl.useProgram.call(this, program ? program._ : 0)
+  }
+
+  disableVertexAttribArray (index) {
+    gl.disableVertexAttribArray.call(this, index)
+    this._vertexObjectState._attribs[index]._isPointer = false
+  }
+
+  enableVertexAttribArray (index) {
+    gl.enableVertexAttribArray.call(this, index)
+    this._vertexObjectState._attribs[index]._isPointer = true
+  }
+
+  vertexAttribPointer (index, size, type, normalized, stride, offset) {
+    gl.vertexAttribPointer.call(this, index, size, type, !!normalized, stride, offset)
+
+    const byteSize = typeSize(type)
+    this._vertexObjectState.setVertexAttribPointer(
+      this._vertexGlobalState._arrayBufferBinding,
+      index,
+      size * byteSize,
+      offset,
+      stride || (size * byteSize),
+      type,
+      !!normalized,
+      stride,
+      size
+    )
+  }
+
+  vertexAttrib1f (index, v0) {
+    const data = this._vertexGlobalState._attribs[index]._data
+    data[0] = v0
+    data[1] = data[2] = 0
+    data[3] = 1
+    gl.vertexAttrib1f.call(this, index, v0)
+  }
+
+  vertexAttrib2f (index, v0, v1) {
+    const data = this._vertexGlobalState._attribs[index]._data
+    data[0] = v0
+    data[1] = v1
+    data[2] = 0
+    data[3] = 1
+    gl.vertexAttrib2f.call(this, index, v0, v1)
+  }
+
+  vertexAttrib3f (index, v0, v1, v2) {
+    const data = this._vertexGlobalState._attribs[index]._data
+    data[0] = v0
+    data[1] = v1
+    data[2] = v2
+    data[3] = 1
+    gl.vertexAttrib3f.call(this, index, v0, v1, v2)
+  }
+
+  vertexAttrib4f (index, v0, v1, v2, v3) {
+    const data = this._vertexGlobalState._attribs[index]._data
+    data[0] = v0
+    data[1] = v1
+    data[2] = v2
+    data[3] = v3
+    gl.vertexAttrib4f.call(this, index, v0, v1, v2, v3)
+  }
+
+  uniform1f (location, v0) {
+    if (location) gl.uniform1f.call(this, location._, v0)
+  }
+
+  uniform2f (location, v0, v1) {
+    if (location) gl.uniform2f.call(this, location._, v0, v1)
+  }
+
+  uniform3f (location, v0, v1, v2) {
+    if (location) gl.uniform3f.call(this, location._, v0, v1, v2)
+  }
+
+  uniform4f (location, v0, v1, v2, v3) {
+    if (location) gl.uniform4f.call(this, location._, v0, v1, v2, v3)
+  }
+
+  uniform1i (location, v0) {
+    if (location) gl.uniform1i.call(this, location._, v0)
+  }
+
+  uniform2i (location, v0, v1) {
+    if (location) gl.uniform2i.call(this, location._, v0, v1)
+  }
+
+  uniform3i (location, v0, v1, v2) {
+    if (location) gl.uniform3i.call(this, location._, v0, v1, v2)
+  }
+
+  uniform4i (location, v0, v1, v2, v3) {
+    if (location) gl.uniform4i.call(this, location._, v0, v1, v2, v3)
+  }
+
+  uniform1fv (location, value) {
+    if (!location) return
+    gl.uniform1fv.call(this, location._, this._uniformCount(location, value, 1),
+      value instanceof Float32Array ? value : new Float32Array(value))
+  }
+
+  uniform2fv (location, value) {
+    if (!location) return
+    gl.uniform2fv.call(this, location._, this._uniformCount(location, value, 2),
+      value instanceof Float32Array ? value : new Float32Array(value))
+  }
+
+  uniform3fv (location, value) {
+    if (!location) return
+    gl.uniform3fv.call(this, location._, this._uniformCount(location, value, 3),
+      value instanceof Float32Array ? value : new Float32Array(value))
+  }
+
+  uniform4fv (location, value) {
+    if (!location) return
+    gl.uniform4fv.call(this, location._, this._uniformCount(location, value, 4),
+      value instanceof Float32Array ? value : new Float32Array(value))
+  }
+
+  uniform1iv (location, value) {
+    if (!location) return
+    gl.uniform1iv.call(this, location._, this._uniformCount(location, value, 1),
+      value instanceof Int32Array ? value : new Int32Array(value))
+  }
+
+  uniform2iv (location, value) {
+    if (!location) return
+    gl.uniform2iv.call(this, location._, this._uniformCount(location, value, 2),
+      value instanceof Int32Array ? value : new Int32Array(value))
+  }
+
+  uniform3iv (location, value) {
+    if (!location) return
+    gl.uniform3iv.call(this, location._, this._uniformCount(location, value, 3),
+      value instanceof Int32Array ? value : new Int32Array(value))
+  }
+
+  uniform4iv (location, value) {
+    if (!location) return
+    gl.uniform4iv.call(this, location._, this._uniformCount(location, value, 4),
+      value instanceof Int32Array ? value : new Int32Array(value))
+  }
+
+  uniformMatrix2fv (location, transpose, value) {
+    if (!location) return
+    gl.uniformMatrix2fv.call(this, location._, !!transpose,
+      value instanceof Float32Array ? value : new Float32Array(value))
+  }
+
+  uniformMatrix3fv (location, transpose, value) {
+    if (!location) return
+    gl.uniformMatrix3fv.call(this, location._, !!transpose,
+      value instanceof Float32Array ? value : new Float32Array(value))
+  }
+
+  uniformMatrix4fv (location, transpose, value) {
+    if (!location) return
+    gl.uniformMatrix4fv.call(this, location._, !!transpose,
+      value instanceof Float32Array ? value : new Float32Array(value))
+  }
+}
+
+for (const name of nativeMethods) {
+  WebGLTrustedRenderingContext.prototype[name] = gl[name]
+}
+
+export { WebGLTrustedRenderingContext }
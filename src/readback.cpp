@@ -0,0 +1,128 @@
+#include "readback.h"
+
+#if !defined(__vita__)
+
+WebGLReadbackWorker::WebGLReadbackWorker(EGLDisplay display, EGLConfig config, EGLContext share)
+    : display(display),
+      context(EGL_NO_CONTEXT),
+      surface(EGL_NO_SURFACE),
+      stopping(false) {
+  eglClientWaitSyncKHR=reinterpret_cast<PFNEGLCLIENTWAITSYNCKHRPROC>(eglGetProcAddress("eglClientWaitSyncKHR"));
+  glGenFramebuffers=reinterpret_cast<PFNGLGENFRAMEBUFFERSPROC>(eglGetProcAddress("glGenFramebuffers"));
+  glDeleteFramebuffers=reinterpret_cast<PFNGLDELETEFRAMEBUFFERSPROC>(eglGetProcAddress("glDeleteFramebuffers"));
+  glBindFramebuffer=reinterpret_cast<PFNGLBINDFRAMEBUFFERPROC>(eglGetProcAddress("glBindFramebuffer"));
+  glFramebufferTexture2D=reinterpret_cast<PFNGLFRAMEBUFFERTEXTURE2DPROC>(eglGetProcAddress("glFramebufferTexture2D"));
+  glCheckFramebufferStatus=reinterpret_cast<PFNGLCHECKFRAMEBUFFERSTATUSPROC>(eglGetProcAddress("glCheckFramebufferStatus"));
+  glPixelStorei=reinterpret_cast<PFNGLPIXELSTOREIPROC>(eglGetProcAddress("glPixelStorei"));
+  glReadPixels=reinterpret_cast<PFNGLREADPIXELSPROC>(eglGetProcAddress("glReadPixels"));
+  if(!eglClientWaitSyncKHR) {
+    return;
+  }
+
+  //The context only reads textures, a 1x1 pbuffer is enough to make it current
+  const EGLint contextAttribs[] = {
+    EGL_CONTEXT_CLIENT_VERSION, 2,
+    EGL_NONE
+  };
+  const EGLint surfaceAttribs[] = {
+    EGL_WIDTH,  1,
+    EGL_HEIGHT, 1,
+    EGL_NONE
+  };
+  surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+  if(surface == EGL_NO_SURFACE) {
+    return;
+  }
+  context = eglCreateContext(display, config, share, contextAttribs);
+  if(context == EGL_NO_CONTEXT) {
+    eglDestroySurface(display, surface);
+    surface = EGL_NO_SURFACE;
+    return;
+  }
+
+  thread = std::thread(&WebGLReadbackWorker::run, this);
+}
+
+WebGLReadbackWorker::~WebGLReadbackWorker() {
+  if(thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+  }
+  if(context != EGL_NO_CONTEXT) {
+    eglDestroyContext(display, context);
+  }
+  if(surface != EGL_NO_SURFACE) {
+    eglDestroySurface(display, surface);
+  }
+}
+
+void WebGLReadbackWorker::submit(std::shared_ptr<WebGLReadback> readback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(std::move(readback));
+  }
+  wake.notify_one();
+}
+
+void WebGLReadbackWorker::run() {
+  if(!eglMakeCurrent(display, surface, surface, context)) {
+    //Nothing can be read, fail whatever comes until the worker is stopped
+    std::unique_lock<std::mutex> lock(mutex);
+    for(;;) {
+      wake.wait(lock, [this] { return stopping || !queue.empty(); });
+      if(queue.empty()) {
+        return;
+      }
+      queue.front()->status.store(WEBGL_READBACK_FAILED, std::memory_order_release);
+      queue.pop_front();
+    }
+  }
+
+  GLuint framebuffer;
+  (this->glGenFramebuffers)(1, &framebuffer);
+  for(;;) {
+    std::shared_ptr<WebGLReadback> readback;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this] { return stopping || !queue.empty(); });
+      //Readbacks already queued are finished before stopping, their fences
+      //are flushed and signal
+      if(queue.empty()) {
+        break;
+      }
+      readback = std::move(queue.front());
+      queue.pop_front();
+    }
+    read(*readback, framebuffer);
+  }
+  (this->glDeleteFramebuffers)(1, &framebuffer);
+  eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+void WebGLReadbackWorker::read(WebGLReadback& readback, GLuint framebuffer) {
+  const WebGLReadRegion& region = readback.region;
+  if((this->eglClientWaitSyncKHR)(display, readback.fence, 0, EGL_FOREVER_KHR) != EGL_CONDITION_SATISFIED_KHR) {
+    readback.status.store(WEBGL_READBACK_FAILED, std::memory_order_release);
+    return;
+  }
+
+  //Attaching the texture after the fence makes the copy done by the rendering
+  //context visible here
+  (this->glBindFramebuffer)(GL_FRAMEBUFFER, framebuffer);
+  (this->glFramebufferTexture2D)(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, readback.texture, 0);
+  int status = WEBGL_READBACK_FAILED;
+  if((this->glCheckFramebufferStatus)(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE) {
+    readback.pixels.resize(region.visibleSize());
+    (this->glPixelStorei)(GL_PACK_ALIGNMENT, region.alignment);
+    (this->glReadPixels)(0, 0, region.visibleWidth, region.visibleHeight, GL_RGBA, region.type, readback.pixels.data());
+    status = WEBGL_READBACK_READY;
+  }
+  (this->glFramebufferTexture2D)(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+  readback.status.store(status, std::memory_order_release);
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef READBACK_H_
+#define READBACK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __vita__
+#include "platform/vita/egl.h"
+#else
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#endif
+
+// GLES3 names, the GLES2 headers don't have them
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_MAP_READ_BIT
+#define GL_MAP_READ_BIT 0x0001
+#endif
+
+// Rectangle asked for by readPixels, the part of it inside the framebuffer and
+// the pack state it was issued with. Pixels are always read as RGBA, visible
+// rows use the pack alignment like the rows written out
+struct WebGLReadRegion {
+  GLint   x             = 0;
+  GLint   y             = 0;
+  GLsizei width         = 0;
+  GLsizei height        = 0;
+  GLenum  format        = GL_RGBA;
+  GLenum  type          = GL_UNSIGNED_BYTE;
+  GLint   left          = 0;
+  GLint   bottom        = 0;
+  GLsizei visibleWidth  = 0;
+  GLsizei visibleHeight = 0;
+  GLint   alignment     = 4;
+  bool    flipY         = false;
+
+  size_t stride(size_t rowSize) const {
+    return alignment > 1 ? (rowSize + alignment - 1) / alignment * alignment : rowSize;
+  }
+  size_t readSize() const {
+    return type == GL_FLOAT ? 16 : 4;
+  }
+  size_t pixelSize() const {
+    return format == GL_RGB ? 3 : readSize();
+  }
+  size_t rowSize() const {
+    return width * pixelSize();
+  }
+  size_t imageSize() const {
+    return stride(rowSize()) * (height - 1) + rowSize();
+  }
+  bool empty() const {
+    return visibleWidth <= 0 || visibleHeight <= 0;
+  }
+  size_t visibleStride() const {
+    return stride(visibleWidth * readSize());
+  }
+  size_t visibleSize() const {
+    return empty() ? 0 : visibleStride() * (visibleHeight - 1) + visibleWidth * readSize();
+  }
+};
+
+enum WebGLReadbackStatus {
+  WEBGL_READBACK_PENDING,
+  WEBGL_READBACK_READY,
+  WEBGL_READBACK_FAILED
+};
+
+// Read started by readPixelsAsync. The region went either into a pixel pack
+// buffer or into a texture the helper thread reads into pixels, the fence
+// signals once the GPU is done with it
+struct WebGLReadback {
+  WebGLReadRegion region;
+#if !defined(__vita__)
+  EGLSyncKHR fence = EGL_NO_SYNC_KHR;
+#endif
+  GLuint buffer  = 0;
+  GLuint texture = 0;
+  std::vector<uint8_t> pixels;
+  std::atomic<int> status{WEBGL_READBACK_PENDING};
+};
+
+#if !defined(__vita__)
+// Helper thread owning a pbuffer context shared with a rendering context, for
+// drivers without pixel pack buffers. It waits on the fence of each readback
+// and reads its texture through a framebuffer of its own, the rendering
+// context keeps going meanwhile and only copies the pixels out
+class WebGLReadbackWorker {
+public:
+  WebGLReadbackWorker(EGLDisplay display, EGLConfig config, EGLContext share);
+  ~WebGLReadbackWorker();
+
+  WebGLReadbackWorker(const WebGLReadbackWorker&) = delete;
+  WebGLReadbackWorker& operator=(const WebGLReadbackWorker&) = delete;
+
+  // False when the shared context couldn't be created
+  bool ok() const {
+    return context != EGL_NO_CONTEXT;
+  }
+
+  void submit(std::shared_ptr<WebGLReadback> readback);
+
+private:
+  void run();
+  void read(WebGLReadback& readback, GLuint framebuffer);
+
+  EGLDisplay display;
+  EGLContext context;
+  EGLSurface surface;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<std::shared_ptr<WebGLReadback>> queue;
+  bool stopping;
+  std::thread thread;
+
+  PFNEGLCLIENTWAITSYNCKHRPROC eglClientWaitSyncKHR;
+  PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+  PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
+  PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+  PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D;
+  PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus;
+  PFNGLPIXELSTOREIPROC glPixelStorei;
+  PFNGLREADPIXELSPROC glReadPixels;
+};
+#endif
+
+#endif
@@ -1,9 +1,12 @@
+#include <chrono>
+#include <cmath>
 #include <cstring>
 #include <vector>
 #include <iostream>
 #include <exception>
 
 #include "webgl.h"
+#include "kernels.h"
 
 #include <quickjs/quickjspp.hpp>
 #include <quickjs/quickjspp-arraybuffer.hpp>
@@ -13,6 +16,18 @@ EGLDisplay             WebGLRenderingContext::DISPLAY;
 WebGLRenderingContext* WebGLRenderingContext::ACTIVE = NULL;
 WebGLRenderingContext* WebGLRenderingContext::CONTEXT_LIST_HEAD = NULL;
 
+//Bits of a float stored in the state shadow
+static inline uint32_t floatBits(GLfloat value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+//Clamped values (colors, depths) are shadowed the way GL stores them
+static inline uint32_t clampBits(GLfloat value) {
+  return floatBits(std::min(std::max(value, 0.0f), 1.0f));
+}
+
 const char* REQUIRED_EXTENSIONS[] = {
   "GL_OES_packed_depth_stencil",
   //TODO: add when angle is ported
@@ -31,6 +46,7 @@ WebGLRenderingContext::WebGLRenderingContext(
     bool preserveDrawingBuffer,
     bool preferLowPowerToHighPerformance,
     bool failIfMajorPerformanceCaveat,
+    bool robustAccess,
     std::optional<intptr_t> uWindow,
     qjs::Value platformOptions)
     : state(GLCONTEXT_STATE_INIT),
@@ -38,9 +54,49 @@ WebGLRenderingContext::WebGLRenderingContext(
       unpack_premultiply_alpha(false),
       unpack_colorspace_conversion(0x9244),
       unpack_alignment(4),
+      pack_alignment(4),
+      pack_flip_y(false),
+      robustAccess(false),
+      activeVertexArray(0),
+      elementArrayBufferBinding(0),
+      activeProgram(0),
+      uniformCallsIssued(0),
+      uniformCallsSkipped(0),
+      framebufferBinding(0),
+      drawingBuffer(0),
+      drawingBufferWidth(0),
+      drawingBufferHeight(0),
+      renderbufferBinding(0),
+      elementIndexUint(false),
+      drawBuffers(false),
+      blendMinmax(false),
+      colorBufferHalfFloat(false),
+      attrib0Buffer(0),
+      memoryBytes{},
+      surfaceBytes(0),
+      windowSurface(false),
+      memoryBudget(0),
+      overMemoryBudget(false),
+      memoryBudgetCrossed(false),
+      drawingBufferTexture(0),
+      drawingBufferRenderbuffer(0),
       next(nullptr),
       prev(nullptr),
-      lastError(GL_NO_ERROR) {
+      scratch(SCRATCH_ARENA_SIZE),
+      uploadBudget(DEFAULT_UPLOAD_BUDGET),
+      nextUpload(1),
+      fenceSync(false),
+      pixelPackBuffer(false),
+      nextReadback(1),
+      nextDecodedImage(1),
+      residencyBudget(0),
+      frame(0),
+      evictions(0),
+      restores(0),
+      nextAtlas(1),
+      errorMode(WEBGL_ERRORS_SYNC),
+      debugErrorRaised(false),
+      outOfMemoryRaised(false) {
   EGLNativeWindowType* window = 
     uWindow.has_value()
       ? reinterpret_cast<EGLNativeWindowType*>(uWindow.value())
@@ -86,9 +142,26 @@ WebGLRenderingContext::WebGLRenderingContext(
    //Create context
   EGLint contextAttribs[] = {
     EGL_CONTEXT_CLIENT_VERSION, 2,
+    EGL_NONE, EGL_NONE,
     EGL_NONE
   };
-  context = eglCreateContext(DISPLAY, config, EGL_NO_CONTEXT, contextAttribs);
+  //Request robust buffer access when asked to, falling back to a regular context
+  const char *eglExtensionString = eglQueryString(DISPLAY, EGL_EXTENSIONS);
+  bool robustRequested = robustAccess && eglExtensionString &&
+    strstr(eglExtensionString, "EGL_EXT_create_context_robustness");
+  if (robustRequested) {
+    contextAttribs[2] = CONTEXT_OPENGL_ROBUST_ACCESS_EXT;
+    contextAttribs[3] = EGL_TRUE;
+    context = eglCreateContext(DISPLAY, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+      robustRequested = false;
+      contextAttribs[2] = EGL_NONE;
+      contextAttribs[3] = EGL_NONE;
+    }
+  }
+  if (!robustRequested) {
+    context = eglCreateContext(DISPLAY, config, EGL_NO_CONTEXT, contextAttribs);
+  }
   if (context == EGL_NO_CONTEXT) {
     throw std::runtime_error("Error creating WebGLContext: couldn't create context");
   }
@@ -97,17 +170,20 @@ WebGLRenderingContext::WebGLRenderingContext(
     surface = eglCreateWindowSurface(DISPLAY, config, *window, nullptr);
   } else {
   #ifdef __vita__
-    std::vector<EGLint> surfaceAttribs {{
-          EGL_WIDTH,  (EGLint)width
-        , EGL_HEIGHT, (EGLint)height
-    }};
+    ScratchArena::Scope scope(scratch);
+    EGLint* surfaceAttribs = scratch.allocate<EGLint>(7);
+    size_t attribCount = 0;
+    surfaceAttribs[attribCount++] = EGL_WIDTH;
+    surfaceAttribs[attribCount++] = (EGLint)width;
+    surfaceAttribs[attribCount++] = EGL_HEIGHT;
+    surfaceAttribs[attribCount++] = (EGLint)height;
     if(platformOptions) {
       if(platformOptions.contains("msaa")) {
-        surfaceAttribs.push_back(EGL_VITA_MULTISAMPLE_MODE);
-        surfaceAttribs.push_back(platformOptions["msaa"].as<EGLint>());
+        surfaceAttribs[attribCount++] = EGL_VITA_MULTISAMPLE_MODE;
+        surfaceAttribs[attribCount++] = platformOptions["msaa"].as<EGLint>();
       }
     }
-    surfaceAttribs.push_back(EGL_NONE);
+    surfaceAttribs[attribCount++] = EGL_NONE;
   #else
     std::array<EGLint, 5> surfaceAttribs = {
           EGL_WIDTH,  (EGLint)width
@@ -115,7 +191,11 @@ WebGLRenderingContext::WebGLRenderingContext(
         , EGL_NONE
     };
   #endif
+  #ifdef __vita__
+    surface = eglCreatePbufferSurface(DISPLAY, config, surfaceAttribs);
+  #else
     surface = eglCreatePbufferSurface(DISPLAY, config, surfaceAttribs.data());
+  #endif
   }
 
   if (surface == EGL_NO_SURFACE) {
@@ -127,6 +207,9 @@ WebGLRenderingContext::WebGLRenderingContext(
     throw std::runtime_error("Error creating WebGLContext: couldn't set current context surface");
   }
 
+  windowSurface = window != nullptr;
+  measureSurface();
+
   //Success
   state = GLCONTEXT_STATE_OK;
   registerContext();
@@ -146,6 +229,15 @@ WebGLRenderingContext::WebGLRenderingContext(
     }
   }
 
+  //Robust access is only relied on when the context was actually created robust,
+  //GL_EXT_robustness lets the driver confirm it
+  this->robustAccess = robustRequested;
+  if (robustRequested && strstr(extensionString, "GL_EXT_robustness")) {
+    GLint robustContext = GL_FALSE;
+    (this->glGetIntegerv)(CONTEXT_ROBUST_ACCESS_EXT, &robustContext);
+    this->robustAccess = robustContext == GL_TRUE;
+  }
+
   //Select best preferred depth
   preferredDepth = GL_DEPTH_COMPONENT16;
   if(strstr(extensionString, "GL_OES_depth32")) {
@@ -153,16 +245,56 @@ WebGLRenderingContext::WebGLRenderingContext(
   } else if(strstr(extensionString, "GL_OES_depth24")) {
     preferredDepth = GL_DEPTH_COMPONENT24_OES;
   }
+
+  //Asynchronous reads need fences, pixel pack buffers are core in GLES3
+#if !defined(__vita__)
+  const char *versionString = (const char*)((glGetString)(GL_VERSION));
+  fenceSync = eglExtensionString && strstr(eglExtensionString, "EGL_KHR_fence_sync") &&
+    eglCreateSyncKHR && eglDestroySyncKHR && eglClientWaitSyncKHR;
+  pixelPackBuffer = fenceSync && versionString && strncmp(versionString, "OpenGL ES 3", 11) == 0 &&
+    glMapBufferRange && glUnmapBuffer;
+#endif
+
+  //Limits never change and a new context starts with the default GL state
+  initLimits(extensionString);
+  initStateShadow();
 }
 
 bool WebGLRenderingContext::swap() {
   if (state != GLCONTEXT_STATE_OK) {
     return false;
   }
+  //Deferred errors are collected once per frame, uniform values cached while
+  //an error was pending may have been rejected
+  flushUniforms();
+  if (errorMode == WEBGL_ERRORS_DEFERRED || debugErrorRaised) {
+    if (collectErrors() != GL_NO_ERROR && errorMode == WEBGL_ERRORS_DEFERRED) {
+      uniformValues.clear();
+    }
+  }
+  //Any of the buffers sized during the frame may have failed to allocate,
+  //draws are not validated against sizes they may not have
+  if (outOfMemoryRaised) {
+    for (GLuint buffer : pendingBufferSizes) {
+      auto size = bufferSizes.find(buffer);
+      if (size != bufferSizes.end()) {
+        memoryChanged(WEBGL_MEMORY_BUFFER, size->second, 0);
+        size->second = 0;
+      }
+    }
+    outOfMemoryRaised = false;
+  }
+  pendingBufferSizes.clear();
+  scratch.reset();
   if (!eglSwapBuffers(DISPLAY, surface)) {
     state = GLCONTEXT_STATE_ERROR;
     return false;
   }
+  //Queued uploads go out at the start of the next frame
+  ProcessUploads();
+  //Textures used in the frame that ended are the last ones evicted
+  enforceResidency();
+  ++frame;
   return true;
 }
 
@@ -182,13 +314,88 @@ bool WebGLRenderingContext::setActive() {
 }
 
 void WebGLRenderingContext::setError(GLenum error) {
-  if (error == GL_NO_ERROR || lastError != GL_NO_ERROR) {
-    return;
+  //Driver errors raised before stay in front of this one
+  if (errorMode == WEBGL_ERRORS_SYNC || debugErrorRaised) {
+    collectErrors();
+  }
+  recordError(error);
+}
+
+void WebGLRenderingContext::recordError(GLenum error) {
+  if (error != GL_NO_ERROR && std::find(errors.begin(), errors.end(), error) == errors.end()) {
+    errors.push_back(error);
+  }
+}
+
+//Queues the errors raised by the driver and returns the first of them
+GLenum WebGLRenderingContext::collectErrors() {
+  debugErrorRaised = false;
+  const GLenum first = (this->glGetError)();
+  GLenum error = first;
+  //A lost context may keep reporting errors, there are only a few codes
+  for (int i = 0; error != GL_NO_ERROR && i < 8; ++i) {
+    recordError(error);
+    outOfMemoryRaised = outOfMemoryRaised || error == GL_OUT_OF_MEMORY;
+    error = (this->glGetError)();
+  }
+  return first;
+}
+
+//Drops the errors raised by calls the context made on its own, true when
+//there were any
+bool WebGLRenderingContext::discardErrors() {
+  debugErrorRaised = false;
+  GLenum error = (this->glGetError)();
+  const bool raised = error != GL_NO_ERROR;
+  for (int i = 0; error != GL_NO_ERROR && i < 8; ++i) {
+    error = (this->glGetError)();
+  }
+  return raised;
+}
+
+//Errors reported before a storage call are not blamed on it
+void WebGLRenderingContext::beginStorage() {
+  if (debugErrorRaised) {
+    collectErrors();
+  }
+}
+
+void GL_APIENTRY WebGLRenderingContext::debugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam) {
+  if (type == GL_DEBUG_TYPE_ERROR_KHR) {
+    static_cast<WebGLRenderingContext*>(const_cast<void*>(userParam))->debugErrorRaised = true;
+  }
+}
+
+bool WebGLRenderingContext::DeferErrors() {
+  collectErrors();
+  errorMode = WEBGL_ERRORS_DEFERRED;
+
+  const char *extensionString = (const char*)((this->glGetString)(GL_EXTENSIONS));
+  if (!this->glDebugMessageCallbackKHR || !this->glDebugMessageControlKHR ||
+      !strstr(extensionString, "GL_KHR_debug")) {
+    return false;
   }
-  GLenum prevError = glGetError();
-  if (prevError == GL_NO_ERROR) {
-    lastError = error;
+
+  //Only errors are reported, synchronously so they are seen by the call that raised them
+  (this->glDebugMessageCallbackKHR)(&WebGLRenderingContext::debugMessage, this);
+  (this->glDebugMessageControlKHR)(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+  (this->glDebugMessageControlKHR)(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR_KHR, GL_DONT_CARE, 0, NULL, GL_TRUE);
+  (this->glEnable)(GL_DEBUG_OUTPUT_KHR);
+  (this->glEnable)(GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR);
+
+  //Non-debug contexts are allowed to stay silent, check with a known error
+  (this->glEnable)(GL_NONE);
+  const bool reported = debugErrorRaised;
+  (this->glGetError)();
+  debugErrorRaised = false;
+
+  if (reported) {
+    errorMode = WEBGL_ERRORS_DEBUG;
+  } else {
+    (this->glDisable)(GL_DEBUG_OUTPUT_KHR);
+    (this->glDebugMessageCallbackKHR)(NULL, NULL);
   }
+  return reported;
 }
 
 void WebGLRenderingContext::dispose() {
@@ -203,6 +410,21 @@ void WebGLRenderingContext::dispose() {
   // Update state
   state = GLCONTEXT_STATE_DESTROY;
 
+  // Pending readbacks, the helper thread is done with them once joined
+#if !defined(__vita__)
+  readbackWorker.reset();
+#endif
+  for (auto& readback : readbacks) {
+    releaseReadback(*readback.second);
+  }
+  readbacks.clear();
+
+  // Images being decoded are dropped
+  imageDecoder.reset();
+  decodedImages.clear();
+  atlases.clear();
+  residentTextures.clear();
+
   // Destroy all object references
   for (auto iter = objects.begin(); iter != objects.end(); ++iter) {
     GLuint obj = iter->first.first;
@@ -269,35 +491,80 @@ void WebGLRenderingContext::Swap() {
 }
 
 void WebGLRenderingContext::Uniform1f(GLint location, GLfloat x) {
-  (this->glUniform1f)(location, x);
+  const GLfloat value[] = { x };
+  this->setUniform(WEBGL_UNIFORM_1F, location, 1, GL_FALSE, value);
 }
 
 void WebGLRenderingContext::Uniform2f(GLint location, GLfloat x, GLfloat y) {
-  (this->glUniform2f)(location, x, y);
+  const GLfloat value[] = { x, y };
+  this->setUniform(WEBGL_UNIFORM_2F, location, 1, GL_FALSE, value);
 }
 
 void WebGLRenderingContext::Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z) {
-  (this->glUniform3f)(location, x, y, z);
+  const GLfloat value[] = { x, y, z };
+  this->setUniform(WEBGL_UNIFORM_3F, location, 1, GL_FALSE, value);
 }
 
 void WebGLRenderingContext::Uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
-  (this->glUniform4f)(location, x, y, z, w);
+  const GLfloat value[] = { x, y, z, w };
+  this->setUniform(WEBGL_UNIFORM_4F, location, 1, GL_FALSE, value);
 }
 
 void WebGLRenderingContext::Uniform1i(GLint location, GLint x) {
-  (this->glUniform1i)(location, x);
+  const GLint value[] = { x };
+  this->setUniform(WEBGL_UNIFORM_1I, location, 1, GL_FALSE, value);
 }
 
 void WebGLRenderingContext::Uniform2i(GLint location, GLint x, GLint y) {
-  (this->glUniform2i)(location, x, y);
+  const GLint value[] = { x, y };
+  this->setUniform(WEBGL_UNIFORM_2I, location, 1, GL_FALSE, value);
 }
 
 void WebGLRenderingContext::Uniform3i(GLint location, GLint x, GLint y, GLint z) {
-  (this->glUniform3i)(location, x, y, z);
+  const GLint value[] = { x, y, z };
+  this->setUniform(WEBGL_UNIFORM_3I, location, 1, GL_FALSE, value);
 }
 
 void WebGLRenderingContext::Uniform4i(GLint location, GLint x, GLint y, GLint z, GLint w) {
-  (this->glUniform4i)(location, x, y, z, w);
+  const GLint value[] = { x, y, z, w };
+  this->setUniform(WEBGL_UNIFORM_4I, location, 1, GL_FALSE, value);
+}
+
+//Array uploads never read past the end of the typed array
+static inline GLsizei uniformCount(GLsizei count, size_t size, size_t components) {
+  return static_cast<GLsizei>(std::min<size_t>(std::max<GLsizei>(count, 0), size / components));
+}
+
+void WebGLRenderingContext::Uniform1fv(GLint location, GLsizei count, qjs::Float32Array value) {
+  this->setUniform(WEBGL_UNIFORM_1F, location, uniformCount(count, value.size(), 1), GL_FALSE, value.data());
+}
+
+void WebGLRenderingContext::Uniform2fv(GLint location, GLsizei count, qjs::Float32Array value) {
+  this->setUniform(WEBGL_UNIFORM_2F, location, uniformCount(count, value.size(), 2), GL_FALSE, value.data());
+}
+
+void WebGLRenderingContext::Uniform3fv(GLint location, GLsizei count, qjs::Float32Array value) {
+  this->setUniform(WEBGL_UNIFORM_3F, location, uniformCount(count, value.size(), 3), GL_FALSE, value.data());
+}
+
+void WebGLRenderingContext::Uniform4fv(GLint location, GLsizei count, qjs::Float32Array value) {
+  this->setUniform(WEBGL_UNIFORM_4F, location, uniformCount(count, value.size(), 4), GL_FALSE, value.data());
+}
+
+void WebGLRenderingContext::Uniform1iv(GLint location, GLsizei count, qjs::Int32Array value) {
+  this->setUniform(WEBGL_UNIFORM_1I, location, uniformCount(count, value.size(), 1), GL_FALSE, value.data());
+}
+
+void WebGLRenderingContext::Uniform2iv(GLint location, GLsizei count, qjs::Int32Array value) {
+  this->setUniform(WEBGL_UNIFORM_2I, location, uniformCount(count, value.size(), 2), GL_FALSE, value.data());
+}
+
+void WebGLRenderingContext::Uniform3iv(GLint location, GLsizei count, qjs::Int32Array value) {
+  this->setUniform(WEBGL_UNIFORM_3I, location, uniformCount(count, value.size(), 3), GL_FALSE, value.data());
+}
+
+void WebGLRenderingContext::Uniform4iv(GLint location, GLsizei count, qjs::Int32Array value) {
+  this->setUniform(WEBGL_UNIFORM_4I, location, uniformCount(count, value.size(), 4), GL_FALSE, value.data());
 }
 
 void WebGLRenderingContext::PixelStorei(GLenum pname, GLenum param) {
@@ -320,6 +587,16 @@ void WebGLRenderingContext::PixelStorei(GLenum pname, GLenum param) {
       (this->glPixelStorei)(pname, param);
     break;
 
+    case GL_PACK_ALIGNMENT:
+      this->pack_alignment = param;
+      (this->glPixelStorei)(pname, param);
+    break;
+
+    //ANGLE_reverse_row_order, readPixels returns rows top-down
+    case 0x93A4:
+      this->pack_flip_y = param != 0;
+    break;
+
     case GL_MAX_DRAW_BUFFERS_EXT:
       (this->glPixelStorei)(pname, param);
     break;
@@ -335,11 +612,17 @@ void WebGLRenderingContext::BindAttribLocation(GLint program, GLint index, const
 }
 
 GLenum WebGLRenderingContext::getError() {
-  GLenum error = (this->glGetError)();
-  if (lastError != GL_NO_ERROR) {
-    error = lastError;
+  //Pending uniforms are sent so their errors are reported
+  this->flushUniforms();
+  //Deferred errors are only collected when the buffers are swapped
+  if (this->errorMode == WEBGL_ERRORS_SYNC || this->debugErrorRaised) {
+    this->collectErrors();
+  }
+  if (this->errors.empty()) {
+    return GL_NO_ERROR;
   }
-  lastError = GL_NO_ERROR;
+  const GLenum error = this->errors.front();
+  this->errors.erase(this->errors.begin());
   return error;
 }
 
@@ -348,6 +631,9 @@ GLenum WebGLRenderingContext::GetError() {
 }
 
 void WebGLRenderingContext::VertexAttribDivisor(GLuint index, GLuint divisor) {
+  if(index < this->parameterValue(GL_MAX_VERTEX_ATTRIBS).words[0]) {
+    this->vertexAttrib(index).divisor = divisor;
+  }
 #if !defined(__vita__)
   (this->glVertexAttribDivisor)(index, divisor);
 #else
@@ -355,37 +641,68 @@ void WebGLRenderingContext::VertexAttribDivisor(GLuint index, GLuint divisor) {
 #endif
 }
 
-void WebGLRenderingContext::DrawArraysInstanced(GLenum mode, GLint first, GLuint count, GLuint icount) {
-  (this->glDrawArraysInstanced)(mode, first, count, icount);
+void WebGLRenderingContext::DrawArraysInstanced(GLenum mode, GLint first, GLint count, GLint icount) {
+  GLsizei reducedCount = this->validateDrawArrays(mode, first, count, icount, true);
+  if(reducedCount <= 0) {
+    return;
+  }
+  this->flushUniforms();
+  (this->glDrawArraysInstanced)(mode, first, reducedCount, icount);
 }
 
-void WebGLRenderingContext::DrawElementsInstanced(GLenum mode, GLint count, GLenum type, GLint offset, GLuint icount) {
+void WebGLRenderingContext::DrawElementsInstanced(GLenum mode, GLint count, GLenum type, GLint offset, GLint icount) {
+  GLsizei reducedCount = this->validateDrawElements(mode, count, type, offset, icount, true);
+  if(reducedCount <= 0) {
+    return;
+  }
+  this->flushUniforms();
   (this->glDrawElementsInstanced)(
     mode,
-    count,
+    reducedCount,
     type,
-    reinterpret_cast<GLvoid*>(offset),
+    reinterpret_cast<GLvoid*>(static_cast<intptr_t>(offset)),
     icount);
 }
 
 void WebGLRenderingContext::DrawArrays(GLenum mode, GLint first, GLint count) {
-  (this->glDrawArrays)(mode, first, count);
+  GLsizei reducedCount = this->validateDrawArrays(mode, first, count, 1, false);
+  if(reducedCount <= 0) {
+    return;
+  }
+  this->flushUniforms();
+  if(this->beginAttrib0()) {
+    (this->glDrawArraysInstanced)(mode, first, reducedCount, 1);
+    this->endAttrib0();
+  } else {
+    (this->glDrawArrays)(mode, first, reducedCount);
+  }
 }
 
-void WebGLRenderingContext::UniformMatrix2fv(GLint location, GLboolean transpose, const std::vector<GLfloat> data) {
-  (this->glUniformMatrix2fv)(location, data.size() / 4, transpose, data.data());
+void WebGLRenderingContext::UniformMatrix2fv(GLint location, GLboolean transpose, qjs::Float32Array data) {
+  this->setUniform(WEBGL_UNIFORM_MATRIX_2FV, location, data.size() / 4, transpose, data.data());
 }
 
-void WebGLRenderingContext::UniformMatrix3fv(GLint location, GLboolean transpose, const std::vector<GLfloat> data) {
-  (this->glUniformMatrix3fv)(location, data.size() / 9, transpose, data.data());
+void WebGLRenderingContext::UniformMatrix3fv(GLint location, GLboolean transpose, qjs::Float32Array data) {
+  this->setUniform(WEBGL_UNIFORM_MATRIX_3FV, location, data.size() / 9, transpose, data.data());
 }
 
-void WebGLRenderingContext::UniformMatrix4fv(GLint location, GLboolean transpose, const std::vector<GLfloat> data) {
-  (this->glUniformMatrix4fv)(location, data.size() / 16, transpose, data.data());
+void WebGLRenderingContext::UniformMatrix4fv(GLint location, GLboolean transpose, qjs::Float32Array data) {
+  this->setUniform(WEBGL_UNIFORM_MATRIX_4FV, location, data.size() / 16, transpose, data.data());
 }
 
 void WebGLRenderingContext::GenerateMipmap(GLint target) {
+  if(!this->uploads.empty()) {
+    this->flushUploads(true, this->textureBinding(target));
+  }
   (this->glGenerateMipmap)(target);
+  this->mipmapsGenerated(this->textureBinding(target), target);
+  //Restored textures generate their mipmaps again
+  if(!this->residentTextures.empty()) {
+    auto iter = this->residentTextures.find(this->textureBinding(target));
+    if(iter != this->residentTextures.end()) {
+      iter->second.mipmaps = true;
+    }
+  }
 }
 
 GLint WebGLRenderingContext::GetAttribLocation(GLint program, const std::string& name) {
@@ -394,11 +711,28 @@ GLint WebGLRenderingContext::GetAttribLocation(GLint program, const std::string&
 
 
 void WebGLRenderingContext::DepthFunc(GLenum func) {
+  if(func >= GL_NEVER && func <= GL_ALWAYS &&
+     !this->stateChanged(GL_DEPTH_FUNC, func)) {
+    return;
+  }
   (this->glDepthFunc)(func);
 }
 
 
 void WebGLRenderingContext::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  if(width < 0 || height < 0) {
+    (this->glViewport)(x, y, width, height);
+    return;
+  }
+  //GL clamps the size to MAX_VIEWPORT_DIMS, getParameter reports it clamped
+  const WebGLParameterValue& maxDims = this->limits[GL_MAX_VIEWPORT_DIMS];
+  if(maxDims.words[0] > 0 && maxDims.words[1] > 0) {
+    width = std::min<GLsizei>(width, maxDims.words[0]);
+    height = std::min<GLsizei>(height, maxDims.words[1]);
+  }
+  if(!this->stateChanged(GL_VIEWPORT, x, y, width, height)) {
+    return;
+  }
   (this->glViewport)(x, y, width, height);
 }
 
@@ -422,6 +756,9 @@ void WebGLRenderingContext::CompileShader(GLuint shader) {
 }
 
 void WebGLRenderingContext::FrontFace(GLenum mode) {
+  if((mode == GL_CW || mode == GL_CCW) && !this->stateChanged(GL_FRONT_FACE, mode)) {
+    return;
+  }
   (this->glFrontFace)(mode);
 }
 
@@ -437,14 +774,12 @@ std::string WebGLRenderingContext::GetShaderInfoLog(GLint id) {
   GLint infoLogLength;
   (this->glGetShaderiv)(id, GL_INFO_LOG_LENGTH, &infoLogLength);
 
-  char* _error = new char[infoLogLength+1];
+  ScratchArena::Scope scope(scratch);
+  char* _error = scratch.allocate<char>(infoLogLength+1);
+  _error[0] = '\0';
   (this->glGetShaderInfoLog)(id, infoLogLength+1, &infoLogLength, _error);
 
-  std::string error(_error);
-
-  delete[] _error;
-
-  return error;
+  return std::string(_error);
 }
 
 
@@ -469,7 +804,33 @@ void WebGLRenderingContext::ValidateProgram(GLuint program) {
 }
 
 void WebGLRenderingContext::LinkProgram(GLuint program) {
+  if(program == this->activeProgram) {
+    this->flushUniforms();
+  }
   (this->glLinkProgram)(program);
+
+  //Linking resets every uniform of the program
+  this->uniformValues.erase(program);
+
+  //Locations of the active attributes, draws check the arrays feeding them
+  std::vector<GLint>& attributes = this->programAttributes[program];
+  attributes.clear();
+  GLint linked = GL_FALSE;
+  (this->glGetProgramiv)(program, GL_LINK_STATUS, &linked);
+  if(!linked) {
+    return;
+  }
+  GLint count = 0;
+  GLint maxLength = 0;
+  (this->glGetProgramiv)(program, GL_ACTIVE_ATTRIBUTES, &count);
+  (this->glGetProgramiv)(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+  std::vector<GLchar> name(std::max(maxLength, 1));
+  for(GLint i = 0; i < count; ++i) {
+    GLint size = 0;
+    GLenum type = 0;
+    (this->glGetActiveAttrib)(program, i, name.size(), NULL, &size, &type, name.data());
+    attributes.push_back((this->glGetAttribLocation)(program, name.data()));
+  }
 }
 
 
@@ -486,19 +847,49 @@ GLint WebGLRenderingContext::GetUniformLocation(GLint program, const std::string
 
 
 void WebGLRenderingContext::ClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+  if(!this->stateChanged(GL_COLOR_CLEAR_VALUE, clampBits(red), clampBits(green), clampBits(blue), clampBits(alpha))) {
+    return;
+  }
   (this->glClearColor)(red, green, blue, alpha);
 }
 
 
 void WebGLRenderingContext::ClearDepth(GLfloat depth) {
+  if(!this->stateChanged(GL_DEPTH_CLEAR_VALUE, clampBits(depth))) {
+    return;
+  }
   (this->glClearDepthf)(depth);
 }
 
+//Capabilities tracked by the state shadow
+static bool isShadowedCapability(GLenum cap) {
+  switch(cap) {
+    case GL_BLEND:
+    case GL_CULL_FACE:
+    case GL_DEPTH_TEST:
+    case GL_DITHER:
+    case GL_POLYGON_OFFSET_FILL:
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    case GL_SAMPLE_COVERAGE:
+    case GL_SCISSOR_TEST:
+    case GL_STENCIL_TEST:
+      return true;
+    default:
+      return false;
+  }
+}
+
 void WebGLRenderingContext::Disable(GLenum cap) {
+  if(isShadowedCapability(cap) && !this->stateChanged(cap, GL_FALSE)) {
+    return;
+  }
   (this->glDisable)(cap);
 }
 
 void WebGLRenderingContext::Enable(GLenum cap) {
+  if(isShadowedCapability(cap) && !this->stateChanged(cap, GL_TRUE)) {
+    return;
+  }
   (this->glEnable)(cap);
 }
 
@@ -513,21 +904,41 @@ GLuint WebGLRenderingContext::CreateTexture() {
 
 
 void WebGLRenderingContext::BindTexture(GLenum target, GLint texture) {
+  WebGLResidentTexture* resident = nullptr;
+  if(!this->residentTextures.empty()) {
+    auto iter = this->residentTextures.find(texture);
+    if(iter != this->residentTextures.end()) {
+      resident = &iter->second;
+      resident->lastUse = this->frame;
+    }
+  }
+
+  //Bindings are per texture unit, only known once the active unit was set
+  auto unit = this->stateShadow.find(GL_ACTIVE_TEXTURE);
+  if(unit != this->stateShadow.end()) {
+    auto binding = this->textureBindings.emplace(std::make_pair(unit->second[0], target), texture);
+    if(!binding.second) {
+      if(binding.first->second == static_cast<GLuint>(texture)) {
+        return;
+      }
+      binding.first->second = texture;
+    }
+  }
   (this->glBindTexture)(target, texture);
-}
 
-unsigned char* WebGLRenderingContext::unpackPixels(
-  GLenum type,
-  GLenum format,
-  GLint width,
-  GLint height,
-  unsigned char* pixels) {
+  //Evicted textures come back when they are used again
+  if(resident && !resident->resident && this->restoreTexture(texture, *resident)) {
+    this->enforceResidency();
+  }
+}
 
-  //Compute pixel size
+static GLint unpackPixelSize(GLenum type, GLenum format) {
   GLint pixelSize = 1;
-  if(type == GL_UNSIGNED_BYTE || type == GL_FLOAT) {
+  if(type == GL_UNSIGNED_BYTE || type == GL_FLOAT || type == GL_HALF_FLOAT_OES) {
     if(type == GL_FLOAT) {
       pixelSize = 4;
+    } else if(type == GL_HALF_FLOAT_OES) {
+      pixelSize = 2;
     }
     switch(format) {
       case GL_ALPHA:
@@ -546,64 +957,74 @@ unsigned char* WebGLRenderingContext::unpackPixels(
   } else {
     pixelSize = 2;
   }
+  return pixelSize;
+}
 
-  //Compute row stride
-  GLint rowStride = pixelSize * width;
-  if((rowStride % unpack_alignment) != 0) {
-    rowStride += unpack_alignment - (rowStride % unpack_alignment);
-  }
+WebGLUnpackState WebGLRenderingContext::unpackState() const {
+  WebGLUnpackState unpack;
+  unpack.alignment = this->unpack_alignment;
+  unpack.flipY = this->unpack_flip_y;
+  unpack.premultiply = this->unpack_premultiply_alpha;
+  return unpack;
+}
 
-  GLint imageSize = rowStride * height;
-  unsigned char* unpacked = new unsigned char[imageSize];
+unsigned char* WebGLRenderingContext::unpackPixels(
+  GLenum type,
+  GLenum format,
+  GLint width,
+  GLint height,
+  unsigned char* pixels) {
+  return this->unpackPixels(this->unpackState(), type, format, width, height, pixels);
+}
 
-  if(unpack_flip_y) {
-    for(int i=0,j=height-1; j>=0; ++i, --j) {
-      memcpy(
-          reinterpret_cast<void*>(unpacked + j*rowStride)
-        , reinterpret_cast<void*>(pixels   + i*rowStride)
-        , width * pixelSize);
-    }
-  } else {
-    memcpy(
-        reinterpret_cast<void*>(unpacked)
-      , reinterpret_cast<void*>(pixels)
-      , imageSize);
-  }
-
-  //Premultiply alpha unpacking
-  if(unpack_premultiply_alpha &&
-     (format == GL_LUMINANCE_ALPHA ||
-      format == GL_RGBA)) {
-
-    for(int row=0; row<height; ++row) {
-      for(int col=0; col<width; ++col) {
-        unsigned char* pixel = unpacked + (row * rowStride) + (col * pixelSize);
-        if(format == GL_LUMINANCE_ALPHA) {
-          pixel[0] *= pixel[1] / 255.0;
-        } else if(type == GL_UNSIGNED_BYTE) {
-          float scale = pixel[3] / 255.0;
-          pixel[0] *= scale;
-          pixel[1] *= scale;
-          pixel[2] *= scale;
-        } else if(type == GL_UNSIGNED_SHORT_4_4_4_4) {
-          int r = pixel[0]&0x0f;
-          int g = pixel[0]>>4;
-          int b = pixel[1]&0x0f;
-          int a = pixel[1]>>4;
-
-          float scale = a / 15.0;
-          r *= scale;
-          g *= scale;
-          b *= scale;
-
-          pixel[0] = r + (g<<4);
-          pixel[1] = b + (a<<4);
-        } else if(type == GL_UNSIGNED_SHORT_5_5_5_1) {
-          if((pixel[0]&1) == 0) {
-            pixel[0] = 1; //why does this get set to 1?!?!?!
-            pixel[1] = 0;
-          }
+unsigned char* WebGLRenderingContext::unpackPixels(
+  const WebGLUnpackState& unpack,
+  GLenum type,
+  GLenum format,
+  GLint width,
+  GLint height,
+  const unsigned char* pixels) {
+
+  const GLint pixelSize = unpackPixelSize(type, format);
+
+  const size_t rowStride = unpack.stride(pixelSize * width);
+  const size_t imageSize = rowStride * height;
+  unsigned char* unpacked = scratch.allocate<unsigned char>(imageSize);
+
+  //Rows are flipped and premultiplied in a single pass, each one is still in
+  //cache when the kernel runs on it
+  bool premultiply = unpack.premultiply &&
+    (format == GL_LUMINANCE_ALPHA || format == GL_RGBA);
+  for(GLint row=0; row<height; ++row) {
+    unsigned char* dst = unpacked + (unpack.flipY ? height - 1 - row : row) * rowStride;
+    const unsigned char* src = pixels + row * rowStride;
+    if(!premultiply) {
+      memcpy(dst, src, width * pixelSize);
+    } else if(type == GL_UNSIGNED_BYTE) {
+      if(format == GL_RGBA) {
+        premultiplyRGBA8(dst, src, width);
+      } else {
+        premultiplyLA8(dst, src, width);
+      }
+    } else {
+      //Wider channels are premultiplied in place, the source may be unaligned
+      memcpy(dst, src, width * pixelSize);
+      if(type == GL_FLOAT) {
+        if(format == GL_RGBA) {
+          premultiplyRGBA32F(reinterpret_cast<float*>(dst), reinterpret_cast<float*>(dst), width);
+        } else {
+          premultiplyLA32F(reinterpret_cast<float*>(dst), reinterpret_cast<float*>(dst), width);
+        }
+      } else if(type == GL_HALF_FLOAT_OES) {
+        if(format == GL_RGBA) {
+          premultiplyRGBA16F(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<uint16_t*>(dst), width);
+        } else {
+          premultiplyLA16F(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<uint16_t*>(dst), width);
         }
+      } else if(type == GL_UNSIGNED_SHORT_4_4_4_4) {
+        premultiplyRGBA4444(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<uint16_t*>(dst), width);
+      } else if(type == GL_UNSIGNED_SHORT_5_5_5_1) {
+        premultiplyRGBA5551(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<uint16_t*>(dst), width);
       }
     }
   }
@@ -611,93 +1032,147 @@ unsigned char* WebGLRenderingContext::unpackPixels(
   return unpacked;
 }
 
-void WebGLRenderingContext::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLint type, WebGLByteArray pixels) {
+GLboolean WebGLRenderingContext::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLint type, WebGLByteArray pixels) {
+  ScratchArena::Scope scope(scratch);
+  const GLuint texture = this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP);
+  if(!this->uploads.empty()) {
+    this->cancelUploads(true, texture, target, level);
+  }
+  const unsigned char* data = nullptr;
   if(pixels.has_value() && !pixels.value().empty()) {
+    data = pixels.value().data();
     if(this->unpack_flip_y || this->unpack_premultiply_alpha) {
-      unsigned char* unpacked = this->unpackPixels(
+      data = this->unpackPixels(
           type
         , format
         , width
         , height
         , pixels.value().data());
-      (this->glTexImage2D)(
-          target
-        , level
-        , internalformat
-        , width
-        , height
-        , border
-        , format
-        , type
-        , unpacked);
-      delete[] unpacked;
-    } else {
-      (this->glTexImage2D)(
-          target
-        , level
-        , internalformat
-        , width
-        , height
-        , border
-        , format
-        , type
-        , pixels.value().data());
     }
-  } else {
+  }
+  if(!this->texImage(target, level, internalformat, width, height, border, format, type, data)) {
+    return GL_FALSE;
+  }
+  if(!this->residentTextures.empty()) {
+    this->residentImageSpecified(texture, target, level, internalformat, width, height, format, type, data);
+  }
+  return GL_TRUE;
+}
+
+//Allocates a texture image from unpacked pixels, zeroed when there are none.
+//Evicted textures are restored through it as well
+GLboolean WebGLRenderingContext::texImage(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const unsigned char* pixels) {
+  ScratchArena::Scope scope(scratch);
+  if(!pixels) {
     size_t length = width * height * 4;
     if(type == GL_FLOAT) {
       length *= 4;
+    } else if(type == GL_HALF_FLOAT_OES) {
+      length *= 2;
     }
-    char* data = new char[length];
-    memset(data, 0, length);
-    (this->glTexImage2D)(
-        target
-      , level
-      , internalformat
-      , width
-      , height
-      , border
-      , format
-      , type
-      , data);
-    delete[] data;
+    unsigned char* zeros = scratch.allocate<unsigned char>(length);
+    memset(zeros, 0, length);
+    pixels = zeros;
+  }
+
+  this->beginStorage();
+  (this->glTexImage2D)(
+      target
+    , level
+    , internalformat
+    , width
+    , height
+    , border
+    , format
+    , type
+    , pixels);
+  if(!this->storageSucceeded()) {
+    return GL_FALSE;
   }
+  this->textureSpecified(target, level, format, type, width, height);
+  return GL_TRUE;
 }
 
 void WebGLRenderingContext::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, WebGLByteArray pixels) {
+  ScratchArena::Scope scope(scratch);
+  //Queued strips would be sent over the new pixels later on
+  if(!this->uploads.empty()) {
+    this->flushUploads(true, this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
   if(pixels.has_value()) {
+    const unsigned char* data = pixels.value().data();
     if(this->unpack_flip_y ||
      this->unpack_premultiply_alpha) {
-      unsigned char* unpacked = this->unpackPixels(
+      data = this->unpackPixels(
           type
         , format
         , width
         , height
         , pixels.value().data());
-      (this->glTexSubImage2D)(
-          target
-        , level
-        , xoffset
-        , yoffset
-        , width
-        , height
-        , format
-        , type
-        , unpacked);
-      delete[] unpacked;
-    } else {
-      (this->glTexSubImage2D)(
-          target
-        , level
-        , xoffset
-        , yoffset
-        , width
-        , height
-        , format
-        , type
-        , pixels.value().data());
     }
+    (this->glTexSubImage2D)(
+        target
+      , level
+      , xoffset
+      , yoffset
+      , width
+      , height
+      , format
+      , type
+      , data);
+    if(!this->residentTextures.empty()) {
+      this->residentSubImage(this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP),
+        target, level, xoffset, yoffset, width, height, format, type, this->unpack_alignment, data);
+    }
+  }
+}
+
+//Half float images given as Float32Array. Rows are converted into scratch
+//memory with the unpack alignment applied to both layouts, flipY and
+//premultiplyAlpha then run on the half floats as usual
+unsigned char* WebGLRenderingContext::halfFloatPixels(GLenum format, GLsizei width, GLsizei height, const unsigned char* pixels) {
+  const WebGLUnpackState unpack = this->unpackState();
+  const size_t count = size_t(width) * unpackPixelSize(GL_UNSIGNED_BYTE, format);
+  const size_t srcStride = unpack.stride(count * sizeof(float));
+  const size_t dstStride = unpack.stride(count * sizeof(uint16_t));
+  unsigned char* converted = scratch.allocate<unsigned char>(dstStride * height);
+  //Rows that aren't float aligned are copied first
+  float* aligned = nullptr;
+  for(GLsizei row=0; row<height; ++row) {
+    const unsigned char* src = pixels + row * srcStride;
+    const float* floats = reinterpret_cast<const float*>(src);
+    if(reinterpret_cast<uintptr_t>(src) % alignof(float) != 0) {
+      if(!aligned) {
+        aligned = scratch.allocate<float>(count);
+      }
+      memcpy(aligned, src, count * sizeof(float));
+      floats = aligned;
+    }
+    convertFloat32ToFloat16(reinterpret_cast<uint16_t*>(converted + row * dstStride), floats, count);
+  }
+  return converted;
+}
+
+GLboolean WebGLRenderingContext::TexImage2DFloat32(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, WebGLByteArray pixels) {
+  ScratchArena::Scope scope(scratch);
+  if(!pixels.has_value() || pixels.value().empty()) {
+    return this->TexImage2D(target, level, internalformat, width, height, border, format, GL_HALF_FLOAT_OES, pixels);
+  }
+  unsigned char* data = this->halfFloatPixels(format, width, height, pixels.value().data());
+  const size_t size = this->unpackState().stride(size_t(width) * unpackPixelSize(GL_HALF_FLOAT_OES, format)) * height;
+  return this->TexImage2D(target, level, internalformat, width, height, border, format, GL_HALF_FLOAT_OES,
+    WebGLArrayView{data, size});
+}
+
+void WebGLRenderingContext::TexSubImage2DFloat32(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, WebGLByteArray pixels) {
+  ScratchArena::Scope scope(scratch);
+  if(!pixels.has_value()) {
+    return;
   }
+  unsigned char* data = this->halfFloatPixels(format, width, height, pixels.value().data());
+  const size_t size = this->unpackState().stride(size_t(width) * unpackPixelSize(GL_HALF_FLOAT_OES, format)) * height;
+  this->TexSubImage2D(target, level, xoffset, yoffset, width, height, format, GL_HALF_FLOAT_OES,
+    WebGLArrayView{data, size});
 }
 
 void WebGLRenderingContext::TexParameteri(GLenum target, GLenum pname, GLint param) {
@@ -713,7 +1188,13 @@ void WebGLRenderingContext::Clear(GLbitfield mask) {
 }
 
 void WebGLRenderingContext::UseProgram(GLuint program) {  
+  if(program == this->activeProgram) {
+    return;
+  }
+  //Pending uniforms belong to the program being replaced
+  this->flushUniforms();
   (this->glUseProgram)(program);
+  this->activeProgram = program;
 }
 
 GLuint WebGLRenderingContext::CreateBuffer() {  
@@ -725,6 +1206,11 @@ GLuint WebGLRenderingContext::CreateBuffer() {
 }
 
 void WebGLRenderingContext::BindBuffer(GLenum target, GLuint buffer) {
+  if(target == GL_ELEMENT_ARRAY_BUFFER) {
+    this->elementArrayBufferBinding = buffer;
+  } else if(target == GL_ARRAY_BUFFER && !this->stateChanged(GL_ARRAY_BUFFER_BINDING, buffer)) {
+    return;
+  }
   (this->glBindBuffer)(target,buffer);
 }
 
@@ -739,6 +1225,7 @@ GLuint WebGLRenderingContext::CreateFramebuffer() {
 
 
 void WebGLRenderingContext::BindFramebuffer(GLint target, GLint buffer) { 
+  this->framebufferBinding = buffer;
   (this->glBindFramebuffer)(target, buffer);
 }
 
@@ -767,84 +1254,194 @@ void WebGLRenderingContext::FramebufferTexture2D(GLenum target, GLenum attachmen
   }
 }
 
-template <typename... Args>
-struct GLBufferData{};
-
-template <typename T1, typename T2, typename... Args>
-struct GLBufferData<T1, T2, Args...> 
-{
-  static void apply(PFNGLBUFFERDATAPROC glBufferData, GLint target, WebGLBufferDataInternal data, GLenum usage)
-  {
-    if(std::holds_alternative<T1>(data)) {
-      GLBufferData<T1>::apply(glBufferData, target, data, usage);
+GLboolean WebGLRenderingContext::BufferData(GLint target, WebGLBufferData data, GLenum usage) {
+  if(target == GL_ELEMENT_ARRAY_BUFFER) {
+    this->invalidateIndexRanges(this->elementArrayBufferBinding);
+  }
+  if(!data.has_value()) {
+    return GL_FALSE;
+  }
+  if(!this->uploads.empty()) {
+    this->cancelUploads(false, target == GL_ELEMENT_ARRAY_BUFFER
+      ? this->elementArrayBufferBinding
+      : this->stateShadow[GL_ARRAY_BUFFER_BINDING][0]);
+  }
+  const WebGLBufferSource& source = data.value();
+  if(target == GL_ELEMENT_ARRAY_BUFFER && !this->robustAccess) {
+    //Keep a copy of the indices for drawElements validation
+    std::vector<uint8_t>& shadow = this->elementShadows[this->elementArrayBufferBinding];
+    if(source.bytes) {
+      shadow.assign(source.bytes, source.bytes + source.size);
     } else {
-      GLBufferData<T2, Args...>::apply(glBufferData, target, data, usage);
+      shadow.assign(static_cast<size_t>(std::max<GLsizeiptr>(source.size, 0)), 0);
     }
   }
-};
+  this->beginStorage();
+  (this->glBufferData)(target, source.size, source.bytes, usage);
 
-template <typename T>
-struct GLBufferData<T> 
-{
-  static void apply(PFNGLBUFFERDATAPROC glBufferData, GLint target, WebGLBufferDataInternal data, GLenum usage) {
-    if(std::holds_alternative<T>(data)) {
-      const auto& array = std::get<T>(data);
-      glBufferData(target, static_cast<GLsizeiptr>(array.size() * T::bytesPerElement), (void*)(array.data()), usage); 
-    }
+  //Sizes bound the vertex and index ranges draws can read
+  if(!this->storageSucceeded()) {
+    return GL_FALSE;
   }
-};
-
-void WebGLRenderingContext::BufferData(GLint target, WebGLBufferData data, GLenum usage) {
-  if(data.has_value()) {
-    const auto& _data = data.value();
-    if(std::holds_alternative<GLsizeiptr>(_data)) {
-      const auto& size = std::get<GLsizeiptr>(_data);
-      (this->glBufferData)(target, size, NULL, usage);
-    } else if(std::holds_alternative<qjs::ArrayBuffer>(_data)) {
-      const auto& array = std::get<qjs::ArrayBuffer>(_data);
-      (this->glBufferData)(target, array.size(), (void*)(array.data()), usage);
-    } else {
-      GLBufferData< 
-        qjs::Int8Array,
-        qjs::Int16Array,
-        qjs::Int32Array,
-        qjs::Uint8Array,
-        qjs::Uint16Array,
-        qjs::Uint32Array,
-        qjs::Float32Array,
-        qjs::Float64Array,
-        qjs::BigInt64Array,
-        qjs::BigUint64Array
-      >::apply(this->glBufferData, target, _data, usage);
-    }
+  GLuint buffer = target == GL_ELEMENT_ARRAY_BUFFER
+    ? this->elementArrayBufferBinding
+    : this->stateShadow[GL_ARRAY_BUFFER_BINDING][0];
+  GLsizeiptr& size = this->bufferSizes[buffer];
+  this->memoryChanged(WEBGL_MEMORY_BUFFER, size, source.size);
+  size = source.size;
+  if(this->errorMode == WEBGL_ERRORS_DEFERRED) {
+    this->pendingBufferSizes.push_back(buffer);
   }
+  return GL_TRUE;
 }
 
 void WebGLRenderingContext::BufferSubData(GLenum target, GLint offset, WebGLByteArray array) {
+  //Queued chunks would be sent over the new data, and over the indices the
+  //shadow is patched with
+  if(!this->uploads.empty()) {
+    this->flushUploads(false, target == GL_ELEMENT_ARRAY_BUFFER
+      ? this->elementArrayBufferBinding
+      : this->stateShadow[GL_ARRAY_BUFFER_BINDING][0]);
+  }
+  if(target == GL_ELEMENT_ARRAY_BUFFER && !this->robustAccess) {
+    this->invalidateIndexRanges(this->elementArrayBufferBinding);
+
+    std::vector<uint8_t>& shadow = this->elementShadows[this->elementArrayBufferBinding];
+    if(array.has_value() && offset >= 0 && offset + array.value().size() <= shadow.size()) {
+      memcpy(shadow.data() + offset, array.value().data(), array.value().size());
+    }
+  }
   if(array.has_value())
     (this->glBufferSubData)(target, offset, array.value().size(), array.value().data());
 }
 
 
+//Invalid enums are left for GL to report, the shadow only holds accepted state
+bool WebGLRenderingContext::isBlendEquation(GLenum mode) const {
+  switch(mode) {
+    case GL_FUNC_ADD:
+    case GL_FUNC_SUBTRACT:
+    case GL_FUNC_REVERSE_SUBTRACT:
+      return true;
+    case GL_MIN_EXT:
+    case GL_MAX_EXT:
+      return this->blendMinmax;
+    default:
+      return false;
+  }
+}
+
+static bool isBlendFactor(GLenum factor) {
+  switch(factor) {
+    case GL_ZERO:
+    case GL_ONE:
+    case GL_SRC_COLOR:
+    case GL_ONE_MINUS_SRC_COLOR:
+    case GL_SRC_ALPHA:
+    case GL_ONE_MINUS_SRC_ALPHA:
+    case GL_DST_ALPHA:
+    case GL_ONE_MINUS_DST_ALPHA:
+    case GL_DST_COLOR:
+    case GL_ONE_MINUS_DST_COLOR:
+    case GL_SRC_ALPHA_SATURATE:
+    case GL_CONSTANT_COLOR:
+    case GL_ONE_MINUS_CONSTANT_COLOR:
+    case GL_CONSTANT_ALPHA:
+    case GL_ONE_MINUS_CONSTANT_ALPHA:
+      return true;
+    default:
+      return false;
+  }
+}
+
 void WebGLRenderingContext::BlendEquation(GLenum mode) {
+  if(this->isBlendEquation(mode) &&
+     !this->stateChanged(GL_BLEND_EQUATION_RGB, mode, mode)) {
+    return;
+  }
   (this->glBlendEquation)(mode);
 }
 
 
 void WebGLRenderingContext::BlendFunc(GLenum sfactor, GLenum dfactor) {
+  if(isBlendFactor(sfactor) && isBlendFactor(dfactor) &&
+     !this->stateChanged(GL_BLEND_SRC_RGB, sfactor, dfactor, sfactor, dfactor)) {
+    return;
+  }
   (this->glBlendFunc)(sfactor,dfactor);
 }
 
 
 void WebGLRenderingContext::EnableVertexAttribArray(GLuint index) {
+  if(index < this->parameterValue(GL_MAX_VERTEX_ATTRIBS).words[0]) {
+    this->vertexAttrib(index).enabled = true;
+  }
   (this->glEnableVertexAttribArray)(index);
 }
 
+//Bytes per component of the types WebGL accepts for vertex attributes, 0 for
+//the others
+static GLint vertexAttribTypeSize(GLenum type) {
+  switch(type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+      return 1;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+      return 2;
+    case GL_FLOAT:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
 void WebGLRenderingContext::VertexAttribPointer(GLint index, GLint size, GLenum type, GLboolean normalized, GLint stride, qjs_size_t offset) {
-  (this->glVertexAttribPointer)(
-    index,
-    size,
-    type,
+  //Command buffers and trusted contexts come here unchecked, a pointer that
+  //is refused must not reach the shadow draws are validated against
+  const GLint typeSize = vertexAttribTypeSize(type);
+  if(size < 1 || size > 4 || stride < 0) {
+    this->setError(GL_INVALID_VALUE);
+    return;
+  }
+  if(typeSize == 0) {
+    this->setError(GL_INVALID_ENUM);
+    return;
+  }
+  if(stride > 255) {
+    this->setError(GL_INVALID_VALUE);
+    return;
+  }
+  if(stride % typeSize != 0 || offset % typeSize != 0) {
+    this->setError(GL_INVALID_OPERATION);
+    return;
+  }
+
+  //Pointers are per vertex array object and capture the bound array buffer
+  if(index >= 0 && static_cast<GLuint>(index) < this->parameterValue(GL_MAX_VERTEX_ATTRIBS).words[0]) {
+    WebGLVertexAttribState& attrib = this->vertexAttrib(index);
+    GLuint buffer = this->stateShadow[GL_ARRAY_BUFFER_BINDING][0];
+    if(attrib.pointer &&
+      attrib.buffer == buffer &&
+      attrib.size == size &&
+      attrib.type == type &&
+      attrib.normalized == normalized &&
+      attrib.stride == stride &&
+      attrib.offset == offset) {
+      return;
+    }
+    attrib.pointer    = true;
+    attrib.buffer     = buffer;
+    attrib.size       = size;
+    attrib.type       = type;
+    attrib.normalized = normalized;
+    attrib.stride     = stride;
+    attrib.offset     = offset;
+  }
+  (this->glVertexAttribPointer)(
+    index,
+    size,
+    type,
     normalized,
     stride,
     reinterpret_cast<GLvoid*>(offset));
@@ -852,12 +1449,28 @@ void WebGLRenderingContext::VertexAttribPointer(GLint index, GLint size, GLenum
 
 
 void WebGLRenderingContext::ActiveTexture(GLenum texture) {
+  if(texture >= GL_TEXTURE0 &&
+     texture - GL_TEXTURE0 < this->limits[GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS].words[0] &&
+     !this->stateChanged(GL_ACTIVE_TEXTURE, texture)) {
+    return;
+  }
   (this->glActiveTexture)(texture);
 }
 
 
-void WebGLRenderingContext::DrawElements(GLenum mode, GLint count, GLenum type, qjs_size_t offset) {
-  (this->glDrawElements)(mode, count, type, reinterpret_cast<GLvoid*>(offset));
+void WebGLRenderingContext::DrawElements(GLenum mode, GLint count, GLenum type, GLint offset) {
+  GLsizei reducedCount = this->validateDrawElements(mode, count, type, offset, 1, false);
+  if(reducedCount <= 0) {
+    return;
+  }
+  this->flushUniforms();
+  GLvoid* indices = reinterpret_cast<GLvoid*>(static_cast<intptr_t>(offset));
+  if(this->beginAttrib0()) {
+    (this->glDrawElementsInstanced)(mode, reducedCount, type, indices, 1);
+    this->endAttrib0();
+  } else {
+    (this->glDrawElements)(mode, reducedCount, type, indices);
+  }
 }
 
 
@@ -869,24 +1482,46 @@ void WebGLRenderingContext::Finish() {
   (this->glFinish)();
 }
 
+//Attribute 0 keeps its generic value for the constant array it is drawn from
 void WebGLRenderingContext::VertexAttrib1f(GLuint index, GLfloat x) {
+  if(index == 0) {
+    this->VertexAttrib4f(index, x, 0, 0, 1);
+    return;
+  }
   (this->glVertexAttrib1f)(index, x);
 }
 
 void WebGLRenderingContext::VertexAttrib2f(GLuint index, GLfloat x, GLfloat y) {
+  if(index == 0) {
+    this->VertexAttrib4f(index, x, y, 0, 1);
+    return;
+  }
   (this->glVertexAttrib2f)(index, x, y);
 }
 
 void WebGLRenderingContext::VertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z) {
+  if(index == 0) {
+    this->VertexAttrib4f(index, x, y, z, 1);
+    return;
+  }
   (this->glVertexAttrib3f)(index, x, y, z);
 }
 
 void WebGLRenderingContext::VertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+  if(index == 0) {
+    this->attrib0Value[0] = x;
+    this->attrib0Value[1] = y;
+    this->attrib0Value[2] = z;
+    this->attrib0Value[3] = w;
+  }
   (this->glVertexAttrib4f)(index, x, y, z, w);
 }
 
 void WebGLRenderingContext::BlendColor(GLclampf r, GLclampf g, GLclampf b, GLclampf a) {
 #if !defined(__vita__)
+  if(!this->stateChanged(GL_BLEND_COLOR, clampBits(r), clampBits(g), clampBits(b), clampBits(a))) {
+    return;
+  }
   (this->glBlendColor)(r, g, b, a);
 #else
   // throw std::runtime_error("glBlendColor is not implemented in this platform!");
@@ -894,42 +1529,125 @@ void WebGLRenderingContext::BlendColor(GLclampf r, GLclampf g, GLclampf b, GLcla
 }
 
 void WebGLRenderingContext::BlendEquationSeparate(GLenum mode_rgb, GLenum mode_alpha) {
+  if(this->isBlendEquation(mode_rgb) && this->isBlendEquation(mode_alpha) &&
+     !this->stateChanged(GL_BLEND_EQUATION_RGB, mode_rgb, mode_alpha)) {
+    return;
+  }
   (this->glBlendEquationSeparate)(mode_rgb, mode_alpha);
 }
 
 void WebGLRenderingContext::BlendFuncSeparate(GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha) {
+  if(isBlendFactor(src_rgb) && isBlendFactor(dst_rgb) && isBlendFactor(src_alpha) && isBlendFactor(dst_alpha) &&
+     !this->stateChanged(GL_BLEND_SRC_RGB, src_rgb, dst_rgb, src_alpha, dst_alpha)) {
+    return;
+  }
   (this->glBlendFuncSeparate)(src_rgb, dst_rgb, src_alpha, dst_alpha);
 }
 
 void WebGLRenderingContext::ClearStencil(GLint s) {
+  if(!this->stateChanged(GL_STENCIL_CLEAR_VALUE, s)) {
+    return;
+  }
   (this->glClearStencil)(s);
 }
 
 void WebGLRenderingContext::ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) {
+  if(!this->stateChanged(GL_COLOR_WRITEMASK, r, g, b, a)) {
+    return;
+  }
   (this->glColorMask)(r, g, b, a);
 }
 
-void WebGLRenderingContext::CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+GLboolean WebGLRenderingContext::CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+  if(!this->uploads.empty()) {
+    this->flushFramebufferUploads();
+    this->cancelUploads(true, this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
+  this->beginStorage();
   (this->glCopyTexImage2D)(target, level, internalformat, x, y, width, height, border);
+  if(!this->storageSucceeded()) {
+    return GL_FALSE;
+  }
+  if(!this->residentTextures.empty()) {
+    this->residentImageLost(this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
+  this->textureSpecified(target, level, GL_RGBA, GL_UNSIGNED_BYTE, width, height);
+  return GL_TRUE;
 }
 
 void WebGLRenderingContext::CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+  if(!this->uploads.empty()) {
+    this->flushFramebufferUploads();
+    this->flushUploads(true, this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
   (this->glCopyTexSubImage2D)(target, level, xoffset, yoffset, x, y, width, height);
+  if(!this->residentTextures.empty()) {
+    this->residentImageLost(this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
+}
+
+GLboolean WebGLRenderingContext::CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, WebGLByteArray data) {
+  if(!this->uploads.empty()) {
+    this->cancelUploads(true, this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
+  const bool empty = !data.has_value() || data.value().empty();
+  this->beginStorage();
+  (this->glCompressedTexImage2D)(
+      target
+    , level
+    , internalformat
+    , width
+    , height
+    , border
+    , empty ? 0 : data.value().size()
+    , empty ? nullptr : data.value().data());
+  if(!this->storageSucceeded()) {
+    return GL_FALSE;
+  }
+  //Compressed levels are never color renderable, no type keeps them out of framebuffers
+  this->textureSpecified(target, level, internalformat, GL_NONE, width, height, empty ? 0 : data.value().size());
+  if(!this->residentTextures.empty()) {
+    this->residentImageLost(this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
+  return GL_TRUE;
+}
+
+void WebGLRenderingContext::CompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, WebGLByteArray data) {
+  if(!data.has_value() || data.value().empty()) {
+    return;
+  }
+  (this->glCompressedTexSubImage2D)(target, level, xoffset, yoffset, width, height, format, data.value().size(), data.value().data());
+  if(!this->residentTextures.empty()) {
+    this->residentImageLost(this->textureBinding(target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP), target, level);
+  }
 }
 
 void WebGLRenderingContext::CullFace(GLenum mode) {
+  if((mode == GL_FRONT || mode == GL_BACK || mode == GL_FRONT_AND_BACK) &&
+     !this->stateChanged(GL_CULL_FACE_MODE, mode)) {
+    return;
+  }
   (this->glCullFace)(mode);
 }
 
 void WebGLRenderingContext::DepthMask(GLboolean flag) {
+  if(!this->stateChanged(GL_DEPTH_WRITEMASK, flag)) {
+    return;
+  }
   (this->glDepthMask)(flag);
 }
 
 void WebGLRenderingContext::DepthRange(GLclampf zNear, GLclampf zFar) {
+  if(!this->stateChanged(GL_DEPTH_RANGE, clampBits(zNear), clampBits(zFar))) {
+    return;
+  }
   (this->glDepthRangef)(zNear, zFar);
 }
 
 void WebGLRenderingContext::DisableVertexAttribArray(GLuint index) {
+  if(index < this->parameterValue(GL_MAX_VERTEX_ATTRIBS).words[0]) {
+    this->vertexAttrib(index).enabled = false;
+  }
   (this->glDisableVertexAttribArray)(index);
 }
 
@@ -938,14 +1656,26 @@ void WebGLRenderingContext::Hint(GLenum target, GLenum mode) {
 }
 
 bool WebGLRenderingContext::IsEnabled(GLenum cap) {
+  if(isShadowedCapability(cap)) {
+    auto state = this->stateShadow.find(cap);
+    if(state != this->stateShadow.end()) {
+      return state->second[0] != GL_FALSE;
+    }
+  }
   return (this->glIsEnabled)(cap) != 0;
 }
 
 void WebGLRenderingContext::LineWidth(GLfloat width) {
+  if(width > 0 && !this->stateChanged(GL_LINE_WIDTH, floatBits(width))) {
+    return;
+  }
   (this->glLineWidth)(width);
 }
 
 void WebGLRenderingContext::PolygonOffset(GLfloat factor, GLfloat units) {
+  if(!this->stateChanged(GL_POLYGON_OFFSET_FACTOR, floatBits(factor), floatBits(units))) {
+    return;
+  }
   (this->glPolygonOffset)(factor, units);
 }
 
@@ -958,34 +1688,110 @@ void WebGLRenderingContext::SampleCoverage(GLclampf value, GLboolean invert) {
 }
 
 void WebGLRenderingContext::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  if(width >= 0 && height >= 0 && !this->stateChanged(GL_SCISSOR_BOX, x, y, width, height)) {
+    return;
+  }
   (this->glScissor)(x, y, width, height);
 }
 
+static bool isStencilFace(GLenum face) {
+  return face == GL_FRONT || face == GL_BACK || face == GL_FRONT_AND_BACK;
+}
+
+static bool isStencilFunc(GLenum func) {
+  return func >= GL_NEVER && func <= GL_ALWAYS;
+}
+
+static bool isStencilOp(GLenum op) {
+  switch(op) {
+    case GL_KEEP:
+    case GL_ZERO:
+    case GL_REPLACE:
+    case GL_INCR:
+    case GL_DECR:
+    case GL_INVERT:
+    case GL_INCR_WRAP:
+    case GL_DECR_WRAP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//Updates the front and/or back shadow entries of a stencil state, false when
+//neither changed. Invalid faces are left for GL to report
+static bool stencilChanged(WebGLRenderingContext* ctx, GLenum face, GLenum front, GLenum back, GLuint a, GLuint b = 0, GLuint c = 0) {
+  bool changed = false;
+  if(face == GL_FRONT || face == GL_FRONT_AND_BACK) {
+    changed = ctx->stateChanged(front, a, b, c) || changed;
+  }
+  if(face == GL_BACK || face == GL_FRONT_AND_BACK) {
+    changed = ctx->stateChanged(back, a, b, c) || changed;
+  }
+  return changed;
+}
+
 void WebGLRenderingContext::StencilFunc(GLenum func, GLint ref, GLuint mask) {
+  if(isStencilFunc(func) &&
+     !stencilChanged(this, GL_FRONT_AND_BACK, GL_STENCIL_FUNC, GL_STENCIL_BACK_FUNC, func, ref, mask)) {
+    return;
+  }
   (this->glStencilFunc)(func, ref, mask);
 }
 
 void WebGLRenderingContext::StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+  if(isStencilFace(face) && isStencilFunc(func) &&
+     !stencilChanged(this, face, GL_STENCIL_FUNC, GL_STENCIL_BACK_FUNC, func, ref, mask)) {
+    return;
+  }
   (this->glStencilFuncSeparate)(face, func, ref, mask);
 }
 
 void WebGLRenderingContext::StencilMask(GLuint mask) {
+  if(!stencilChanged(this, GL_FRONT_AND_BACK, GL_STENCIL_WRITEMASK, GL_STENCIL_BACK_WRITEMASK, mask)) {
+    return;
+  }
   (this->glStencilMask)(mask);
 }
 
 void WebGLRenderingContext::StencilMaskSeparate(GLenum face, GLuint mask) {
+  if(isStencilFace(face) &&
+     !stencilChanged(this, face, GL_STENCIL_WRITEMASK, GL_STENCIL_BACK_WRITEMASK, mask)) {
+    return;
+  }
   (this->glStencilMaskSeparate)(face, mask);
 }
 
 void WebGLRenderingContext::StencilOp(GLenum fail, GLenum zfail, GLenum zpass) {
+  if(isStencilOp(fail) && isStencilOp(zfail) && isStencilOp(zpass) &&
+     !stencilChanged(this, GL_FRONT_AND_BACK, GL_STENCIL_FAIL, GL_STENCIL_BACK_FAIL, fail, zfail, zpass)) {
+    return;
+  }
   (this->glStencilOp)(fail, zfail, zpass);
 }
 
 void WebGLRenderingContext::StencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass) {
+  if(isStencilFace(face) && isStencilOp(fail) && isStencilOp(zfail) && isStencilOp(zpass) &&
+     !stencilChanged(this, face, GL_STENCIL_FAIL, GL_STENCIL_BACK_FAIL, fail, zfail, zpass)) {
+    return;
+  }
   (this->glStencilOpSeparate)(face, fail, zfail, zpass);
 }
 
+bool WebGLRenderingContext::StencilStateValid() {
+  //WebGL requires matching front and back masks and references
+  static const GLenum FRONT[] = { GL_STENCIL_WRITEMASK, GL_STENCIL_VALUE_MASK, GL_STENCIL_REF };
+  static const GLenum BACK[] = { GL_STENCIL_BACK_WRITEMASK, GL_STENCIL_BACK_VALUE_MASK, GL_STENCIL_BACK_REF };
+  for(size_t i = 0; i < 3; ++i) {
+    if(this->parameterValue(FRONT[i]).words[0] != this->parameterValue(BACK[i]).words[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void WebGLRenderingContext::BindRenderbuffer(GLenum target, GLuint buffer) {
+  this->renderbufferBinding = buffer;
   (this->glBindRenderbuffer)(target, buffer);
 }
 
@@ -999,24 +1805,70 @@ GLuint WebGLRenderingContext::CreateRenderbuffer() {
 }
 
 void WebGLRenderingContext::DeleteBuffer(GLuint buffer) {
+  this->invalidateIndexRanges(buffer);
+  this->elementShadows.erase(buffer);
+  if(this->elementArrayBufferBinding == buffer) {
+    this->elementArrayBufferBinding = 0;
+  }
+
+  //GL unbinds the deleted buffer, forget pointers that referenced it
+  auto arrayBuffer = this->stateShadow.find(GL_ARRAY_BUFFER_BINDING);
+  if(arrayBuffer != this->stateShadow.end() && arrayBuffer->second[0] == buffer) {
+    arrayBuffer->second[0] = 0;
+  }
+  for(auto& attrib : this->vertexAttribs) {
+    if(attrib.second.buffer == buffer) {
+      attrib.second.buffer = 0;
+    }
+  }
+  auto size = this->bufferSizes.find(buffer);
+  if(size != this->bufferSizes.end()) {
+    this->memoryChanged(WEBGL_MEMORY_BUFFER, size->second, 0);
+    this->bufferSizes.erase(size);
+  }
+  this->cancelUploads(false, buffer);
+
   (this->glDeleteBuffers)(1, &buffer);
 }
 
 void WebGLRenderingContext::DeleteFramebuffer(GLuint buffer) {
   this->unregisterGLObj(GLOBJECT_TYPE_FRAMEBUFFER, buffer);
 
+  //GL reverts to the default framebuffer when the bound one is deleted
+  if(this->framebufferBinding == buffer) {
+    this->framebufferBinding = 0;
+  }
+  this->framebufferInfo.erase(buffer);
+
   (this->glDeleteFramebuffers)(1, &buffer);
 }
 
 void WebGLRenderingContext::DeleteProgram(GLuint program) {
   this->unregisterGLObj(GLOBJECT_TYPE_PROGRAM, program);
 
+  if(program == this->activeProgram) {
+    this->flushUniforms();
+  }
+  this->uniformValues.erase(program);
+  this->programAttributes.erase(program);
+
   (this->glDeleteProgram)(program);
 }
 
 void WebGLRenderingContext::DeleteRenderbuffer(GLuint renderbuffer) {
   this->unregisterGLObj(GLOBJECT_TYPE_RENDERBUFFER, renderbuffer);
 
+  if(this->renderbufferBinding == renderbuffer) {
+    this->renderbufferBinding = 0;
+  }
+  auto info = this->renderbufferInfo.find(renderbuffer);
+  if(info != this->renderbufferInfo.end()) {
+    this->memoryChanged(
+      renderbuffer == this->drawingBufferRenderbuffer ? WEBGL_MEMORY_DRAWING_BUFFER : WEBGL_MEMORY_RENDERBUFFER,
+      info->second.bytes(), 0);
+    this->renderbufferInfo.erase(info);
+  }
+
   (this->glDeleteRenderbuffers)(1, &renderbuffer);
 }
 
@@ -1029,6 +1881,31 @@ void WebGLRenderingContext::DeleteShader(GLuint shader) {
 void WebGLRenderingContext::DeleteTexture(GLuint texture) {
   this->unregisterGLObj(GLOBJECT_TYPE_TEXTURE, texture);
 
+  //GL reverts every unit the texture was bound to back to texture 0
+  for(auto& binding : this->textureBindings) {
+    if(binding.second == texture) {
+      binding.second = 0;
+    }
+  }
+  auto info = this->textureInfo.find(texture);
+  if(info != this->textureInfo.end()) {
+    this->memoryChanged(
+      texture == this->drawingBufferTexture ? WEBGL_MEMORY_DRAWING_BUFFER : WEBGL_MEMORY_TEXTURE,
+      info->second.bytes, 0);
+    this->textureInfo.erase(info);
+  }
+  this->cancelUploads(true, texture);
+  this->residentTextures.erase(texture);
+  //Atlas pages living in the texture are full from now on
+  for(auto& atlas : this->atlases) {
+    for(auto& page : atlas.second.pages) {
+      if(page.texture == texture) {
+        page.texture = 0;
+        page.packer.close();
+      }
+    }
+  }
+
   (this->glDeleteTextures)(1, &texture);
 }
 
@@ -1104,7 +1981,9 @@ GLboolean WebGLRenderingContext::IsTexture(GLuint texture) {
   return (this->glIsTexture)(texture);
 }
 
-void WebGLRenderingContext::RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+GLboolean WebGLRenderingContext::RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+  const GLenum format = internalformat;
+
   //In WebGL, we map GL_DEPTH_STENCIL to GL_DEPTH24_STENCIL8
   if (internalformat == GL_DEPTH_STENCIL_OES) {
     internalformat = GL_DEPTH24_STENCIL8_OES;
@@ -1112,365 +1991,2544 @@ void WebGLRenderingContext::RenderbufferStorage(GLenum target, GLenum internalfo
     internalformat = this->preferredDepth;
   }
 
+  this->beginStorage();
   (this->glRenderbufferStorage)(target, internalformat, width, height);
+  if(!this->storageSucceeded()) {
+    return GL_FALSE;
+  }
+  if(this->renderbufferBinding != 0) {
+    WebGLRenderbufferInfo& info = this->renderbufferInfo[this->renderbufferBinding];
+    const size_t previous = info.bytes();
+    info = WebGLRenderbufferInfo{ format, width, height };
+    this->memoryChanged(
+      this->renderbufferBinding == this->drawingBufferRenderbuffer ? WEBGL_MEMORY_DRAWING_BUFFER : WEBGL_MEMORY_RENDERBUFFER,
+      previous, info.bytes());
+  }
+  return GL_TRUE;
 }
 
 std::string WebGLRenderingContext::GetShaderSource(GLint shader) {
   GLint len;
   (this->glGetShaderiv)(shader, GL_SHADER_SOURCE_LENGTH, &len);
 
-  GLchar *source = new GLchar[len];
+  ScratchArena::Scope scope(scratch);
+  GLchar *source = scratch.allocate<GLchar>(std::max(len, 1));
+  source[0] = '\0';
   (this->glGetShaderSource)(shader, len, NULL, source);
-  std::string str = source;
-  delete[] source;
 
-  return str;
+  return std::string(source);
+}
+
+WebGLReadRegion WebGLRenderingContext::readRegion(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type) {
+  WebGLReadRegion region;
+  region.x = x;
+  region.y = y;
+  region.width = width;
+  region.height = height;
+  region.format = format;
+  region.type = type;
+  region.alignment = this->pack_alignment;
+  region.flipY = this->pack_flip_y;
+
+  GLsizei viewWidth = this->drawingBufferWidth;
+  GLsizei viewHeight = this->drawingBufferHeight;
+  if(this->framebufferBinding != 0 && this->framebufferBinding != this->drawingBuffer) {
+    const WebGLFramebufferInfo& info = this->framebufferInfo[this->framebufferBinding];
+    viewWidth = info.width;
+    viewHeight = info.height;
+  }
+
+  //Part of the rectangle inside the framebuffer
+  const int64_t left = std::max<int64_t>(x, 0);
+  const int64_t bottom = std::max<int64_t>(y, 0);
+  const int64_t right = std::min<int64_t>(int64_t(x) + width, viewWidth);
+  const int64_t top = std::min<int64_t>(int64_t(y) + height, viewHeight);
+  region.left = static_cast<GLint>(left);
+  region.bottom = static_cast<GLint>(bottom);
+  region.visibleWidth = static_cast<GLsizei>(std::max<int64_t>(right - left, 0));
+  region.visibleHeight = static_cast<GLsizei>(std::max<int64_t>(top - bottom, 0));
+  return region;
+}
+
+void WebGLRenderingContext::packPixels(const WebGLReadRegion& region, const uint8_t* visible, uint8_t* out) {
+  const size_t rowSize = region.rowSize();
+  const size_t rowStride = region.stride(rowSize);
+  const size_t visibleStride = region.visibleStride();
+  const size_t leftSize = (region.left - region.x) * region.pixelSize();
+  const size_t visibleSize = region.visibleWidth * region.pixelSize();
+  for(GLsizei row = 0; row < region.height; ++row) {
+    uint8_t* dst = out + (region.flipY ? region.height - 1 - row : row) * rowStride;
+    const int64_t sourceRow = int64_t(region.y) + row - region.bottom;
+    if(!visible || sourceRow < 0 || sourceRow >= region.visibleHeight) {
+      memset(dst, 0, rowSize);
+      continue;
+    }
+
+    const uint8_t* src = visible + sourceRow * visibleStride;
+    memset(dst, 0, leftSize);
+    if(region.format == GL_RGB) {
+      convertRGBAToRGB(dst + leftSize, src, region.visibleWidth);
+    } else if(region.format == GL_BGRA_EXT) {
+      convertRGBAToBGRA(dst + leftSize, src, region.visibleWidth);
+    } else {
+      memcpy(dst + leftSize, src, visibleSize);
+    }
+    memset(dst + leftSize + visibleSize, 0, rowSize - leftSize - visibleSize);
+  }
 }
 
+//Reads are clipped to the framebuffer and the pixels outside of it are zeroed,
+//pixels are always read as RGBA and converted when RGB or BGRA are asked for
 void WebGLRenderingContext::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, WebGLByteArray pixels) {
-  if(pixels.has_value())
-    (this->glReadPixels)(x, y, width, height, format, type, pixels.value().data());
+  if(!pixels.has_value() || width <= 0 || height <= 0 || !this->framebufferOk()) {
+    return;
+  }
+  this->flushFramebufferUploads();
+
+  const WebGLReadRegion region = this->readRegion(x, y, width, height, format, type);
+  uint8_t* out = pixels.value().data();
+  if(pixels.value().size() < region.imageSize()) {
+    this->setError(GL_INVALID_OPERATION);
+    return;
+  }
+
+  if(format == GL_RGBA && !region.flipY && region.visibleWidth == width && region.visibleHeight == height) {
+    (this->glReadPixels)(x, y, width, height, GL_RGBA, type, out);
+    return;
+  }
+
+  ScratchArena::Scope scope(scratch);
+  uint8_t* visible = nullptr;
+  if(!region.empty()) {
+    visible = scratch.allocate<uint8_t>(region.visibleSize());
+    (this->glReadPixels)(region.left, region.bottom, region.visibleWidth, region.visibleHeight, GL_RGBA, type, visible);
+  }
+  this->packPixels(region, visible, out);
 }
 
-WebGLTexParameter WebGLRenderingContext::GetTexParameter(GLenum target, GLenum pname) {
+//Starts a read that readPixelsAsyncResult picks up once its fence signaled.
+//Returns 0 when the read can't be deferred, the caller reads synchronously
+GLuint WebGLRenderingContext::ReadPixelsAsync(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type) {
 #if !defined(__vita__)
-  if (pname == GL_TEXTURE_MAX_ANISOTROPY_EXT) {
-    GLfloat param_value = 0;
-    (this->glGetTexParameterfv)(target, pname, &param_value);
-    return WebGLTexParameter(param_value);
-  } else {
-    GLint param_value = 0;
-    (this->glGetTexParameteriv)(target, pname, &param_value);
-    return WebGLTexParameter(param_value);
+  if(!this->fenceSync || width <= 0 || height <= 0 || !this->framebufferOk()) {
+    return 0;
+  }
+  this->flushFramebufferUploads();
+  const WebGLReadRegion region = this->readRegion(x, y, width, height, format, type);
+  if(region.empty()) {
+    return 0;
   }
-#else
-  // throw std::runtime_error("glSampleCoverage is not implemented in this platform!");
-  return std::nullopt;
-#endif
-} 
 
-WebGLActiveElement WebGLRenderingContext::GetActiveAttrib(GLuint program, GLuint index) {
-  GLint maxLength;
-  (this->glGetProgramiv)(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+  //Errors of the calls below are not the application's, the ones it raised
+  //before are kept
+  this->collectErrors();
+
+  auto readback = std::make_shared<WebGLReadback>();
+  readback->region = region;
+  if(this->pixelPackBuffer) {
+    (this->glGenBuffers)(1, &readback->buffer);
+    (this->glBindBuffer)(GL_PIXEL_PACK_BUFFER, readback->buffer);
+    (this->glBufferData)(GL_PIXEL_PACK_BUFFER, region.visibleSize(), NULL, GL_STREAM_READ);
+    (this->glReadPixels)(region.left, region.bottom, region.visibleWidth, region.visibleHeight, GL_RGBA, type, NULL);
+    (this->glBindBuffer)(GL_PIXEL_PACK_BUFFER, 0);
+  } else {
+    //Float framebuffers can't be copied to a texture in GLES2
+    if(type != GL_UNSIGNED_BYTE) {
+      return 0;
+    }
+    if(!this->readbackWorker) {
+      this->readbackWorker.reset(new WebGLReadbackWorker(DISPLAY, config, context));
+    }
+    if(!this->readbackWorker->ok()) {
+      return 0;
+    }
 
-  char* name = new char[maxLength];
-  GLsizei length = 0;
-  GLenum  type;
-  GLsizei size;
-  (this->glGetActiveAttrib)(program, index, maxLength, &length, &size, &type, name);
+    //The copy goes through the active unit, its binding is put back after.
+    //Framebuffers without alpha can only be copied to RGB, reading the texture
+    //back as RGBA gives an opaque alpha
+    GLint alphaBits = 0;
+    (this->glGetIntegerv)(GL_ALPHA_BITS, &alphaBits);
+    const GLuint previous = this->textureBinding(GL_TEXTURE_2D);
+    (this->glGenTextures)(1, &readback->texture);
+    (this->glBindTexture)(GL_TEXTURE_2D, readback->texture);
+    (this->glTexParameteri)(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    (this->glCopyTexImage2D)(GL_TEXTURE_2D, 0, alphaBits > 0 ? GL_RGBA : GL_RGB, region.left, region.bottom, region.visibleWidth, region.visibleHeight, 0);
+    (this->glBindTexture)(GL_TEXTURE_2D, previous);
+  }
 
-  std::string sname(name);
-  delete[] name;
+  //A read that failed falls back to the synchronous path
+  if(this->discardErrors()) {
+    this->releaseReadback(*readback);
+    return 0;
+  }
 
-  if (length > 0) {
-    return WebGLActiveElementContent(size, type, sname);
-  } else {
-    return std::nullopt;
+  readback->fence = (this->eglCreateSyncKHR)(DISPLAY, EGL_SYNC_FENCE_KHR, NULL);
+  if(readback->fence == EGL_NO_SYNC_KHR) {
+    this->releaseReadback(*readback);
+    return 0;
+  }
+  //The fence only signals once the commands before it were submitted
+  (this->glFlush)();
+  if(readback->texture) {
+    this->readbackWorker->submit(readback);
   }
+
+  const GLuint id = this->nextReadback++;
+  this->readbacks[id] = readback;
+  return id;
+#else
+  return 0;
+#endif
 }
 
-WebGLActiveElement WebGLRenderingContext::GetActiveUniform(GLuint program, GLuint index) {
-  GLint maxLength;
-  (this->glGetProgramiv)(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+//0 while the read is in flight, 1 once its pixels were written out and -1
+//when it failed or is unknown. Finished reads are forgotten
+GLint WebGLRenderingContext::ReadPixelsAsyncResult(GLuint id, WebGLByteArray pixels) {
+#if !defined(__vita__)
+  //Polled from the event loop, another context may be current
+  auto iter = this->readbacks.find(id);
+  if(iter == this->readbacks.end() || !this->setActive()) {
+    return -1;
+  }
+  WebGLReadback& readback = *iter->second;
+  const WebGLReadRegion& region = readback.region;
+
+  int status = WEBGL_READBACK_FAILED;
+  if(readback.texture) {
+    status = readback.status.load(std::memory_order_acquire);
+  } else if(readback.buffer) {
+    const EGLint result = (this->eglClientWaitSyncKHR)(DISPLAY, readback.fence, 0, 0);
+    status = result == EGL_TIMEOUT_EXPIRED_KHR ? WEBGL_READBACK_PENDING :
+      result == EGL_CONDITION_SATISFIED_KHR ? WEBGL_READBACK_READY : WEBGL_READBACK_FAILED;
+  }
+  if(status == WEBGL_READBACK_PENDING) {
+    return 0;
+  }
 
-  char* name = new char[maxLength];
-  GLsizei length = 0;
-  GLenum  type;
-  GLsizei size;
-  (this->glGetActiveUniform)(program, index, maxLength, &length, &size, &type, name);
+  if(status == WEBGL_READBACK_READY && pixels.has_value() && pixels.value().size() >= region.imageSize()) {
+    if(readback.buffer) {
+      (this->glBindBuffer)(GL_PIXEL_PACK_BUFFER, readback.buffer);
+      const uint8_t* visible = static_cast<const uint8_t*>(
+        (this->glMapBufferRange)(GL_PIXEL_PACK_BUFFER, 0, region.visibleSize(), GL_MAP_READ_BIT));
+      if(visible) {
+        this->packPixels(region, visible, pixels.value().data());
+        (this->glUnmapBuffer)(GL_PIXEL_PACK_BUFFER);
+      } else {
+        status = WEBGL_READBACK_FAILED;
+      }
+      (this->glBindBuffer)(GL_PIXEL_PACK_BUFFER, 0);
+    } else {
+      this->packPixels(region, readback.pixels.data(), pixels.value().data());
+    }
+  } else {
+    status = WEBGL_READBACK_FAILED;
+  }
 
-  std::string sname(name);
-  delete[] name;
+  this->releaseReadback(readback);
+  this->readbacks.erase(iter);
+  return status == WEBGL_READBACK_READY ? 1 : -1;
+#else
+  return -1;
+#endif
+}
 
-  if (length > 0) {
-    return WebGLActiveElementContent(size, type, sname);
-  } else {
-    return std::nullopt;
+void WebGLRenderingContext::releaseReadback(WebGLReadback& readback) {
+  if(readback.buffer) {
+    (this->glDeleteBuffers)(1, &readback.buffer);
+    readback.buffer = 0;
+  }
+  if(readback.texture) {
+    (this->glDeleteTextures)(1, &readback.texture);
+    readback.texture = 0;
+  }
+#if !defined(__vita__)
+  if(readback.fence != EGL_NO_SYNC_KHR) {
+    (this->eglDestroySyncKHR)(DISPLAY, readback.fence);
+    readback.fence = EGL_NO_SYNC_KHR;
   }
+#endif
+  readback.pixels.clear();
+  readback.pixels.shrink_to_fit();
 }
 
-std::vector<GLsizei> WebGLRenderingContext::GetAttachedShaders(GLuint program) {
-  GLint numAttachedShaders;
-  (this->glGetProgramiv)(program, GL_ATTACHED_SHADERS, &numAttachedShaders);
+GLuint WebGLRenderingContext::textureBinding(GLenum bindTarget) {
+  auto unit = this->stateShadow.find(GL_ACTIVE_TEXTURE);
+  if(unit != this->stateShadow.end()) {
+    auto binding = this->textureBindings.find(std::make_pair(unit->second[0], bindTarget));
+    if(binding != this->textureBindings.end()) {
+      return binding->second;
+    }
+  }
+  GLint texture = 0;
+  (this->glGetIntegerv)(bindTarget == GL_TEXTURE_2D ? GL_TEXTURE_BINDING_2D : GL_TEXTURE_BINDING_CUBE_MAP, &texture);
+  return texture;
+}
 
-  GLuint* shaders = new GLuint[numAttachedShaders];
-  GLsizei count;
-  (this->glGetAttachedShaders)(program, numAttachedShaders, &count, shaders);
+//Queues an encoded image for the decoder thread, the bytes are copied. Returns
+//0 when the library was built without a decoder
+GLuint WebGLRenderingContext::DecodeImage(WebGLByteArray bytes, GLenum format, GLboolean flipY, GLboolean premultiply) {
+  if(!WebGLImageDecoder::available() || !bytes.has_value() || bytes.value().empty()) {
+    return 0;
+  }
+  if(!this->imageDecoder) {
+    this->imageDecoder.reset(new WebGLImageDecoder());
+  }
 
-  std::vector<GLsizei> ret(shaders, shaders + count);
+  auto image = std::make_shared<WebGLDecodedImage>();
+  image->encoded.assign(bytes.value().data(), bytes.value().data() + bytes.value().size());
+  image->format = format;
+  image->alignment = this->unpack_alignment;
+  image->flipY = flipY;
+  image->premultiply = premultiply;
+  this->imageDecoder->submit(image);
+
+  const GLuint id = this->nextDecodedImage++;
+  this->decodedImages[id] = image;
+  return id;
+}
+
+//Status of a queued image (0 pending, 1 decoded, -1 failed or unknown) and
+//its size once decoded. Failed images are forgotten
+std::vector<double> WebGLRenderingContext::GetDecodedImage(GLuint id) {
+  auto iter = this->decodedImages.find(id);
+  if(iter == this->decodedImages.end()) {
+    return { -1, 0, 0 };
+  }
+  const WebGLDecodedImage& image = *iter->second;
+  switch(image.status.load(std::memory_order_acquire)) {
+    case WEBGL_DECODE_PENDING:
+      return { 0, 0, 0 };
+    case WEBGL_DECODE_READY:
+      return { 1, double(image.width), double(image.height) };
+    default:
+      this->decodedImages.erase(iter);
+      return { -1, 0, 0 };
+  }
+}
 
-  delete[] shaders;
+//Uploads a decoded image to a level of texture. The texture is bound to the
+//active unit for the upload only, the image was decoded with the unpack state
+//it was queued with and is forgotten afterwards
+GLboolean WebGLRenderingContext::TexImage2DDecoded(GLuint id, GLuint texture, GLenum target, GLint level) {
+  auto iter = this->decodedImages.find(id);
+  if(iter == this->decodedImages.end() ||
+    iter->second->status.load(std::memory_order_acquire) != WEBGL_DECODE_READY) {
+    return GL_FALSE;
+  }
+  const std::shared_ptr<WebGLDecodedImage> image = iter->second;
+  this->decodedImages.erase(iter);
+
+  const GLenum bindTarget = target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+  const GLuint previous = this->textureBinding(bindTarget);
+  (this->glBindTexture)(bindTarget, texture);
+  if(image->alignment != this->unpack_alignment) {
+    (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, image->alignment);
+  }
+  this->beginStorage();
+  (this->glTexImage2D)(target, level, image->format, image->width, image->height, 0,
+    image->format, GL_UNSIGNED_BYTE, image->pixels.data());
+  const bool stored = this->storageSucceeded();
+  if(image->alignment != this->unpack_alignment) {
+    (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, this->unpack_alignment);
+  }
+  (this->glBindTexture)(bindTarget, previous);
+  if(!stored) {
+    return GL_FALSE;
+  }
 
-  return ret;
+  WebGLTextureInfo& info = this->textureInfo[texture];
+  info.format = image->format;
+  info.type = GL_UNSIGNED_BYTE;
+  info.levels[level] = std::make_pair(image->width, image->height);
+  this->textureStored(texture, target, level, size_t(image->width) * image->height * unpackPixelSize(GL_UNSIGNED_BYTE, image->format));
+  if(!this->residentTextures.empty()) {
+    this->residentImageLost(texture, target, level);
+  }
+  return GL_TRUE;
 }
 
- WebGLParameter WebGLRenderingContext::GetParameter(GLenum name) {
-  switch(name) {
-    case 0x9240 /* UNPACK_FLIP_Y_WEBGL */:
-      return WebGLParameter(this->unpack_flip_y);
+void WebGLRenderingContext::ReleaseDecodedImage(GLuint id) {
+  this->decodedImages.erase(id);
+}
 
-    case 0x9241 /* UNPACK_PREMULTIPLY_ALPHA_WEBGL*/:
-      return WebGLParameter(this->unpack_premultiply_alpha);
+//Allocates a level of the texture bound to target and queues its pixels, they
+//are unpacked with the current pixel storage state when they are sent
+GLuint WebGLRenderingContext::EnqueueTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLenum format, GLenum type, WebGLByteArray pixels) {
+  const GLenum bindTarget = target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+  const GLuint texture = this->textureBinding(bindTarget);
+  if(!pixels.has_value() || texture == 0 || width <= 0 || height <= 0) {
+    return 0;
+  }
 
-    case 0x9243 /* UNPACK_COLORSPACE_CONVERSION_WEBGL */:
-      return WebGLParameter(this->unpack_colorspace_conversion);
+  //Contents are undefined until every row was sent
+  this->cancelUploads(true, texture, target, level);
+  this->beginStorage();
+  (this->glTexImage2D)(target, level, internalformat, width, height, 0, format, type, NULL);
+  if(!this->storageSucceeded()) {
+    return 0;
+  }
+  this->textureSpecified(target, level, format, type, width, height);
+  if(!this->residentTextures.empty()) {
+    this->residentImageLost(texture, target, level);
+  }
 
-    case GL_BLEND:
-    case GL_CULL_FACE:
-    case GL_DEPTH_TEST:
-    case GL_DEPTH_WRITEMASK:
-    case GL_DITHER:
-    case GL_POLYGON_OFFSET_FILL:
-    case GL_SAMPLE_COVERAGE_INVERT:
-    case GL_SCISSOR_TEST:
-    case GL_STENCIL_TEST:
-    {
-      GLboolean params;
-      (this->glGetBooleanv)(name, &params);
+  WebGLUpload upload;
+  upload.id = this->nextUpload++;
+  upload.texture = true;
+  upload.target = target;
+  upload.object = texture;
+  upload.level = level;
+  upload.format = format;
+  upload.type = type;
+  upload.width = width;
+  upload.height = height;
+  upload.rowSize = size_t(width) * unpackPixelSize(type, format);
+  upload.unpack = this->unpackState();
+  //Padded to whole rows, strips may then be unpacked past the last one
+  const size_t size = upload.unpack.stride(upload.rowSize) * height;
+  const uint8_t* data = pixels.value().data();
+  upload.data.assign(data, data + std::min(size, pixels.value().size()));
+  upload.data.resize(size);
+  this->uploads.push_back(std::move(upload));
+  return this->uploads.back().id;
+}
+
+//Allocates the buffer bound to target and queues its data
+GLuint WebGLRenderingContext::EnqueueBufferData(GLenum target, WebGLByteArray data, GLenum usage) {
+  const GLuint buffer = target == GL_ELEMENT_ARRAY_BUFFER
+    ? this->elementArrayBufferBinding
+    : this->stateShadow[GL_ARRAY_BUFFER_BINDING][0];
+  if(!data.has_value() || buffer == 0) {
+    return 0;
+  }
+  const uint8_t* bytes = data.value().data();
+  const size_t size = data.value().size();
+  if(!this->BufferData(target, WebGLBufferSource{ nullptr, static_cast<GLsizeiptr>(size) }, usage)) {
+    return 0;
+  }
+  //Draws are validated against the final indices right away
+  if(target == GL_ELEMENT_ARRAY_BUFFER && !this->robustAccess) {
+    this->elementShadows[buffer].assign(bytes, bytes + size);
+  }
 
-      return WebGLParameter(params != 0);
+  WebGLUpload upload;
+  upload.id = this->nextUpload++;
+  upload.target = target;
+  upload.object = buffer;
+  upload.data.assign(bytes, bytes + size);
+  this->uploads.push_back(std::move(upload));
+  return this->uploads.back().id;
+}
+
+//Sends the next strip or chunk of an upload, the object is bound for the call
+//only. Returns true once everything was sent
+bool WebGLRenderingContext::sendUpload(WebGLUpload& upload) {
+  if(!upload.texture) {
+    const size_t size = std::min(UPLOAD_CHUNK_SIZE, upload.data.size() - upload.sent);
+    const GLuint previous = upload.target == GL_ELEMENT_ARRAY_BUFFER
+      ? this->elementArrayBufferBinding
+      : this->stateShadow[GL_ARRAY_BUFFER_BINDING][0];
+    if(previous != upload.object) {
+      (this->glBindBuffer)(upload.target, upload.object);
     }
-
-    case GL_DEPTH_CLEAR_VALUE:
-    case GL_LINE_WIDTH:
-    case GL_POLYGON_OFFSET_FACTOR:
-    case GL_POLYGON_OFFSET_UNITS:
-    case GL_SAMPLE_COVERAGE_VALUE:
-    case GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT:
-    {
-      GLfloat params;
-      (this->glGetFloatv)(name, &params);
-
-      return WebGLParameter(params);
+    (this->glBufferSubData)(upload.target, upload.sent, size, upload.data.data() + upload.sent);
+    if(previous != upload.object) {
+      (this->glBindBuffer)(upload.target, previous);
     }
+    upload.sent += size;
+    return upload.sent >= upload.data.size();
+  }
 
-    case GL_RENDERER:
-    case GL_SHADING_LANGUAGE_VERSION:
-    case GL_VENDOR:
-    case GL_VERSION:
-    case GL_EXTENSIONS:
-    {
-      const char *params = reinterpret_cast<const char*>((this->glGetString)(name));
-      if(params) {
-        return WebGLParameter(params);
-      }
-    }
+  const size_t rowStride = upload.unpack.stride(upload.rowSize);
+  const GLsizei row = static_cast<GLsizei>(upload.sent);
+  const GLsizei rows = std::max<GLsizei>(1,
+    std::min<GLsizei>(upload.height - row, static_cast<GLsizei>(UPLOAD_CHUNK_SIZE / std::max<size_t>(rowStride, 1))));
+  const GLenum bindTarget = upload.target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+  const GLuint previous = this->textureBinding(bindTarget);
+  if(previous != upload.object) {
+    (this->glBindTexture)(bindTarget, upload.object);
+  }
+  if(upload.unpack.alignment != this->unpack_alignment) {
+    (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, upload.unpack.alignment);
+  }
 
-    case GL_MAX_VIEWPORT_DIMS:
-    {
-      GLint params[2];
-      (this->glGetIntegerv)(name, params);
+  //A flipped strip comes from the mirrored rows of the source
+  ScratchArena::Scope scope(scratch);
+  const unsigned char* pixels = upload.data.data() +
+    (upload.unpack.flipY ? upload.height - row - rows : row) * rowStride;
+  if(upload.unpack.flipY || upload.unpack.premultiply) {
+    pixels = this->unpackPixels(upload.unpack, upload.type, upload.format, upload.width, rows, pixels);
+  }
+  (this->glTexSubImage2D)(upload.target, upload.level, 0, row, upload.width, rows, upload.format, upload.type, pixels);
 
-      return WebGLParameter(std::vector<GLint>(params, params + 2));
-    }
+  if(upload.unpack.alignment != this->unpack_alignment) {
+    (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, this->unpack_alignment);
+  }
+  if(previous != upload.object) {
+    (this->glBindTexture)(bindTarget, previous);
+  }
+  upload.sent += rows;
+  return upload.sent >= static_cast<size_t>(upload.height);
+}
 
-    case GL_SCISSOR_BOX:
-    case GL_VIEWPORT:
-    {
-      GLint params[4];
-      (this->glGetIntegerv)(name, params);
+GLuint WebGLRenderingContext::CreateAtlas(GLsizei width, GLsizei height, GLint padding, GLenum format, GLboolean mipmaps) {
+  if(width <= 0 || height <= 0 || padding < 0) {
+    return 0;
+  }
+  WebGLAtlas atlas;
+  atlas.width = width;
+  atlas.height = height;
+  atlas.padding = padding;
+  atlas.format = format;
+  atlas.mipmaps = mipmaps;
+  const GLuint id = this->nextAtlas++;
+  this->atlases[id] = std::move(atlas);
+  return id;
+}
+
+//The page texture was allocated at the atlas size and format by the caller
+GLboolean WebGLRenderingContext::AtlasAddPage(GLuint atlas, GLuint texture) {
+  auto iter = this->atlases.find(atlas);
+  if(iter == this->atlases.end() || texture == 0) {
+    return GL_FALSE;
+  }
+  iter->second.pages.push_back(WebGLAtlasPage{ texture, WebGLAtlasPacker(iter->second.width, iter->second.height) });
+  return GL_TRUE;
+}
 
-      return WebGLParameter(std::vector<GLint>(params, params + 4));
+//Places a region in the first page it fits in and uploads its pixels with the
+//padding around them. Returns the page, the texel rectangle of the pixels and
+//their UV rectangle, or nothing when the pages are full
+std::vector<double> WebGLRenderingContext::AtlasInsert(GLuint atlas, GLsizei width, GLsizei height, WebGLByteArray pixels) {
+  auto iter = this->atlases.find(atlas);
+  if(iter == this->atlases.end() || width <= 0 || height <= 0) {
+    return std::vector<double>();
+  }
+  const WebGLAtlas& info = iter->second;
+  const GLint padding = info.padding;
+  const GLsizei round = info.mipmaps ? 4 : 1;
+  const GLsizei paddedWidth = (width + 2 * padding + round - 1) / round * round;
+  const GLsizei paddedHeight = (height + 2 * padding + round - 1) / round * round;
+
+  size_t index = 0;
+  GLint x = 0, y = 0;
+  for(; index < info.pages.size(); ++index) {
+    WebGLAtlasPage& page = iter->second.pages[index];
+    if(page.texture != 0 && page.packer.insert(paddedWidth, paddedHeight, x, y)) {
+      break;
     }
+  }
+  if(index == info.pages.size()) {
+    return std::vector<double>();
+  }
 
-    case GL_ALIASED_LINE_WIDTH_RANGE:
-    case GL_ALIASED_POINT_SIZE_RANGE:
-    case GL_DEPTH_RANGE:
-    {
-      GLfloat params[2];
-      (this->glGetFloatv)(name, params);
-
-      return WebGLParameter(std::vector<GLfloat>(params, params + 2));
+  if(pixels.has_value() && !pixels.value().empty()) {
+    ScratchArena::Scope scope(scratch);
+    const WebGLUnpackState unpack = this->unpackState();
+    const GLint pixelSize = unpackPixelSize(GL_UNSIGNED_BYTE, info.format);
+    const size_t rowStride = unpack.stride(size_t(width) * pixelSize);
+    const unsigned char* source = pixels.value().data();
+    if(unpack.flipY || unpack.premultiply) {
+      source = this->unpackPixels(unpack, GL_UNSIGNED_BYTE, info.format, width, height, source);
     }
 
-    case GL_BLEND_COLOR:
-    case GL_COLOR_CLEAR_VALUE:
-    {
-      GLfloat params[4];
-      (this->glGetFloatv)(name, params);
-
-      return WebGLParameter(std::vector<GLfloat>(params, params + 4));
+    //Rows and columns past the edges of the pixels repeat the edge texels
+    const size_t paddedRow = size_t(paddedWidth) * pixelSize;
+    unsigned char* padded = scratch.allocate<unsigned char>(paddedRow * paddedHeight);
+    for(GLsizei row = 0; row < paddedHeight; ++row) {
+      const GLsizei sourceRow = std::min(std::max(row - padding, 0), height - 1);
+      const unsigned char* src = source + sourceRow * rowStride;
+      unsigned char* dst = padded + row * paddedRow;
+      for(GLint column = 0; column < padding; ++column, dst += pixelSize) {
+        memcpy(dst, src, pixelSize);
+      }
+      memcpy(dst, src, size_t(width) * pixelSize);
+      dst += size_t(width) * pixelSize;
+      const unsigned char* last = src + size_t(width - 1) * pixelSize;
+      for(GLsizei column = padding + width; column < paddedWidth; ++column, dst += pixelSize) {
+        memcpy(dst, last, pixelSize);
+      }
     }
 
-    case GL_COLOR_WRITEMASK:
-    {
-      GLboolean params[4];
-      (this->glGetBooleanv)(name, params);
-
-      return WebGLParameter(std::vector<GLboolean>(params, params + 4));
+    const GLuint previous = this->textureBinding(GL_TEXTURE_2D);
+    const GLuint texture = info.pages[index].texture;
+    if(previous != texture) {
+      (this->glBindTexture)(GL_TEXTURE_2D, texture);
     }
-
-    default:
-    {
-      GLint params;
-      (this->glGetIntegerv)(name, &params);
-      return WebGLParameter(params);
+    if(this->unpack_alignment != 1) {
+      (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, 1);
+    }
+    (this->glTexSubImage2D)(GL_TEXTURE_2D, 0, x, y, paddedWidth, paddedHeight, info.format, GL_UNSIGNED_BYTE, padded);
+    if(!this->residentTextures.empty()) {
+      this->residentSubImage(texture, GL_TEXTURE_2D, 0, x, y, paddedWidth, paddedHeight, info.format, GL_UNSIGNED_BYTE, 1, padded);
+    }
+    if(this->unpack_alignment != 1) {
+      (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, this->unpack_alignment);
+    }
+    if(previous != texture) {
+      (this->glBindTexture)(GL_TEXTURE_2D, previous);
     }
   }
-}
-
-GLint WebGLRenderingContext::GetBufferParameter(GLenum target, GLenum pname) {
-  GLint params;
-  (this->glGetBufferParameteriv)(target, pname, &params);
 
-  return params;
+  const double left = x + padding;
+  const double top = y + padding;
+  return std::vector<double>{
+    double(index),
+    left,
+    top,
+    double(width),
+    double(height),
+    left / info.width,
+    top / info.height,
+    (left + width) / info.width,
+    (top + height) / info.height
+  };
 }
 
-GLint WebGLRenderingContext::GetFramebufferAttachmentParameter(GLenum target, GLenum attachment, GLenum pname) {
-  GLint params;
-  (this->glGetFramebufferAttachmentParameteriv)(target, attachment, pname, &params);
-
-  return params;
+void WebGLRenderingContext::DeleteAtlas(GLuint atlas) {
+  this->atlases.erase(atlas);
 }
 
-std::string WebGLRenderingContext::GetProgramInfoLog(GLuint program) {
-  GLint infoLogLength;
-  (this->glGetProgramiv)(program, GL_INFO_LOG_LENGTH, &infoLogLength);
+//Keeps what a managed texture image was specified with, the pixels are the
+//unpacked ones that went to GL
+void WebGLRenderingContext::residentImageSpecified(GLuint texture, GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLenum format, GLenum type, const unsigned char* pixels) {
+  auto iter = this->residentTextures.find(texture);
+  if(iter == this->residentTextures.end()) {
+    return;
+  }
+  WebGLResidentTexture& resident = iter->second;
+  resident.bindTarget = target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+  resident.resident = true;
+  resident.lastUse = this->frame;
+
+  WebGLResidentImage& image = resident.images[std::make_pair(target, level)];
+  image.internalformat = internalformat;
+  image.format = format;
+  image.type = type;
+  image.width = width;
+  image.height = height;
+  image.alignment = this->unpack_alignment;
+  image.zero = pixels == nullptr;
+  image.lost = false;
+  image.pixels.clear();
+  if(resident.keepPixels && pixels) {
+    const size_t size = this->unpackState().stride(size_t(width) * unpackPixelSize(type, format)) * height;
+    image.pixels.assign(pixels, pixels + size);
+  }
+  image.pixels.shrink_to_fit();
+}
 
-  char* error = new char[infoLogLength+1];
-  (this->glGetProgramInfoLog)(program, infoLogLength+1, &infoLogLength, error);
+//Copies the rows of a texSubImage2D call or an atlas region into the pixels
+//kept for the image, rows of pixels are aligned to alignment
+void WebGLRenderingContext::residentSubImage(GLuint texture, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, GLint alignment, const unsigned char* pixels) {
+  auto iter = this->residentTextures.find(texture);
+  if(iter == this->residentTextures.end() || !iter->second.keepPixels) {
+    return;
+  }
+  auto found = iter->second.images.find(std::make_pair(target, level));
+  if(found == iter->second.images.end()) {
+    return;
+  }
+  WebGLResidentImage& image = found->second;
+  if(image.lost) {
+    return;
+  }
+  if(image.format != format || image.type != type ||
+    xoffset < 0 || yoffset < 0 ||
+    xoffset + width > image.width || yoffset + height > image.height) {
+    this->residentImageLost(texture, target, level);
+    return;
+  }
 
-  std::string ret(error);
+  const size_t pixelSize = unpackPixelSize(type, format);
+  WebGLUnpackState stored;
+  stored.alignment = image.alignment;
+  const size_t storedStride = stored.stride(image.width * pixelSize);
+  if(image.zero) {
+    image.pixels.assign(storedStride * image.height, 0);
+    image.zero = false;
+  }
+  WebGLUnpackState source;
+  source.alignment = alignment;
+  const size_t rowStride = source.stride(width * pixelSize);
+  for(GLsizei row = 0; row < height; ++row) {
+    memcpy(
+      image.pixels.data() + (yoffset + row) * storedStride + xoffset * pixelSize,
+      pixels + row * rowStride,
+      width * pixelSize);
+  }
+}
 
-  delete[] error;
+//The image was changed by a call that doesn't go through unpacked pixels, the
+//texture stays resident unless JS reloads it
+void WebGLRenderingContext::residentImageLost(GLuint texture, GLenum target, GLint level) {
+  auto iter = this->residentTextures.find(texture);
+  if(iter == this->residentTextures.end()) {
+    return;
+  }
+  iter->second.bindTarget = target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+  WebGLResidentImage& image = iter->second.images[std::make_pair(target, level)];
+  image.lost = true;
+  std::vector<uint8_t>().swap(image.pixels);
+}
+
+//Releases the storage of every image, the name and the parameters of the
+//texture stay. Mipmap levels that were generated are released too
+void WebGLRenderingContext::evictTexture(GLuint texture, WebGLResidentTexture& resident) {
+  const GLuint previous = this->textureBinding(resident.bindTarget);
+  (this->glBindTexture)(resident.bindTarget, texture);
+  for(const auto& it : resident.images) {
+    const WebGLResidentImage& image = it.second;
+    (this->glTexImage2D)(it.first.first, it.first.second, image.internalformat, 0, 0, 0, image.format, image.type, nullptr);
+    this->textureStored(texture, it.first.first, it.first.second, 0);
+    if(resident.mipmaps && it.first.second == 0) {
+      for(GLint level = 1; (std::max(image.width, image.height) >> level) > 0; ++level) {
+        if(!resident.images.count(std::make_pair(it.first.first, level))) {
+          (this->glTexImage2D)(it.first.first, level, image.internalformat, 0, 0, 0, image.format, image.type, nullptr);
+          this->textureStored(texture, it.first.first, level, 0);
+        }
+      }
+    }
+  }
+  (this->glBindTexture)(resident.bindTarget, previous);
+  resident.resident = false;
+  ++this->evictions;
+}
 
-  return ret;
+//Specifies the images of an evicted texture again, it is bound to its target
+//on the active unit. Textures JS reloads are left to it
+bool WebGLRenderingContext::restoreTexture(GLuint texture, WebGLResidentTexture& resident) {
+  if(!resident.keepPixels) {
+    return false;
+  }
+  for(const auto& it : resident.images) {
+    const WebGLResidentImage& image = it.second;
+    if(image.alignment != this->unpack_alignment) {
+      (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, image.alignment);
+    }
+    this->texImage(it.first.first, it.first.second, image.internalformat, image.width, image.height, 0,
+      image.format, image.type, image.zero ? nullptr : image.pixels.data());
+    if(image.alignment != this->unpack_alignment) {
+      (this->glPixelStorei)(GL_UNPACK_ALIGNMENT, this->unpack_alignment);
+    }
+  }
+  if(resident.mipmaps) {
+    (this->glGenerateMipmap)(resident.bindTarget);
+    this->mipmapsGenerated(texture, resident.bindTarget);
+  }
+  resident.resident = true;
+  ++this->restores;
+  return true;
 }
 
-WebGLShaderPrecisionFormat WebGLRenderingContext::GetShaderPrecisionFormat(GLenum shaderType, GLenum precisionType) {
-#if !defined(__vita__)
-  GLint range[2];
-  GLint precision;
+//Evicts the least recently used textures until texture storage fits the budget
+void WebGLRenderingContext::enforceResidency() {
+  if(this->residencyBudget <= 0 || this->memoryBytes[WEBGL_MEMORY_TEXTURE] <= this->residencyBudget) {
+    return;
+  }
 
-  (this->glGetShaderPrecisionFormat)(shaderType, precisionType, range, &precision);
+  //Textures draws can sample or render to without binding them first
+  std::vector<GLuint> pinned;
+  for(const auto& binding : this->textureBindings) {
+    pinned.push_back(binding.second);
+  }
+  for(const auto& framebuffer : this->framebufferInfo) {
+    for(const auto& attachment : framebuffer.second.attachments) {
+      if(attachment.second.target == GL_TEXTURE) {
+        pinned.push_back(attachment.second.object);
+      }
+    }
+  }
+  std::sort(pinned.begin(), pinned.end());
+
+  std::vector<std::pair<uint64_t, GLuint>> candidates;
+  for(auto& it : this->residentTextures) {
+    const WebGLResidentTexture& resident = it.second;
+    if(!resident.resident || resident.lastUse >= this->frame || resident.images.empty() ||
+      std::binary_search(pinned.begin(), pinned.end(), it.first)) {
+      continue;
+    }
+    bool restorable = true;
+    for(const auto& image : resident.images) {
+      restorable = restorable && !(resident.keepPixels && image.second.lost);
+    }
+    if(restorable) {
+      candidates.emplace_back(resident.lastUse, it.first);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
 
-  return WebGLShaderPrecisionFormatContent(range[0], range[1], precision);
-#else
-  // throw std::runtime_error("glGetShaderPrecisionFormat is not implemented in this platform!");
-  return std::nullopt;
-#endif
+  for(const auto& candidate : candidates) {
+    if(this->memoryBytes[WEBGL_MEMORY_TEXTURE] <= this->residencyBudget) {
+      break;
+    }
+    this->evictTexture(candidate.second, this->residentTextures[candidate.second]);
+  }
 }
 
-int WebGLRenderingContext::GetRenderbufferParameter(GLenum target, GLenum pname) {
-#if !defined(__vita__)
-  int value;
-  (this->glGetRenderbufferParameteriv)(target, pname, &value);
-
-  return value;
-#else
-  // throw std::runtime_error("glGetRenderbufferParameteriv is not implemented in this platform!");
-  return 0;
-#endif
+void WebGLRenderingContext::SetResidencyBudget(double bytes) {
+  this->residencyBudget = std::max(bytes, 0.0);
+  this->enforceResidency();
 }
 
-std::vector<float> WebGLRenderingContext::GetUniform(GLint program, GLint location) {
-#if !defined(__vita__)
-  float data[16];
-  (this->glGetUniformfv)(program, location, data);
+//Images specified before the texture was managed have no pixels kept, the
+//texture can only be evicted once they are specified again
+void WebGLRenderingContext::ManageTexture(GLuint texture, GLboolean keepPixels) {
+  if(texture == 0 || this->residentTextures.count(texture)) {
+    return;
+  }
+  WebGLResidentTexture& resident = this->residentTextures[texture];
+  resident.keepPixels = keepPixels;
+  resident.lastUse = this->frame;
+  auto info = this->textureInfo.find(texture);
+  if(info != this->textureInfo.end()) {
+    for(const auto& image : info->second.imageBytes) {
+      this->residentImageLost(texture, image.first.first, image.first.second);
+    }
+  }
+}
 
-  return std::vector<float>(data, data + 16);
-#else
-  // throw std::runtime_error("glSampleCoverage is not implemented in this platform!");
-  return std::vector<float>{};
-#endif
+//An evicted texture is restored before it leaves the manager
+void WebGLRenderingContext::UnmanageTexture(GLuint texture) {
+  auto iter = this->residentTextures.find(texture);
+  if(iter == this->residentTextures.end()) {
+    return;
+  }
+  if(!iter->second.resident) {
+    const GLenum bindTarget = iter->second.bindTarget;
+    const GLuint previous = this->textureBinding(bindTarget);
+    this->BindTexture(bindTarget, texture);
+    this->BindTexture(bindTarget, previous);
+  }
+  this->residentTextures.erase(texture);
 }
 
-WebGLAttrib WebGLRenderingContext::GetVertexAttrib(GLint index, GLenum pname) {
-  GLint value;
+GLboolean WebGLRenderingContext::TextureEvicted(GLuint texture) {
+  auto iter = this->residentTextures.find(texture);
+  return iter != this->residentTextures.end() && !iter->second.resident;
+}
 
-  switch (pname) {
-    case GL_VERTEX_ATTRIB_ARRAY_ENABLED:
-    case GL_VERTEX_ATTRIB_ARRAY_NORMALIZED:
-    {
-      (this->glGetVertexAttribiv)(index, pname, &value);
-      return WebGLAttrib(value);
+//Managed, resident and evicted textures, bytes of pixels kept, evictions and
+//restores so far and the budget
+std::vector<double> WebGLRenderingContext::GetResidencyStats() {
+  size_t resident = 0, kept = 0;
+  for(const auto& it : this->residentTextures) {
+    resident += it.second.resident;
+    for(const auto& image : it.second.images) {
+      kept += image.second.pixels.size();
     }
+  }
+  return std::vector<double>{
+    static_cast<double>(this->residentTextures.size()),
+    static_cast<double>(resident),
+    static_cast<double>(this->residentTextures.size() - resident),
+    static_cast<double>(kept),
+    static_cast<double>(this->evictions),
+    static_cast<double>(this->restores),
+    this->residencyBudget
+  };
+}
 
-    case GL_VERTEX_ATTRIB_ARRAY_SIZE:
-    case GL_VERTEX_ATTRIB_ARRAY_STRIDE:
-    case GL_VERTEX_ATTRIB_ARRAY_TYPE:
-    {
-      (this->glGetVertexAttribiv)(index, pname, &value);
-      return WebGLAttrib(value);
+//Drops the uploads of an object that was deleted or respecified, all of them
+//or those of a texture image only
+void WebGLRenderingContext::cancelUploads(bool texture, GLuint object, GLenum target, GLint level) {
+  for(auto iter = this->uploads.begin(); iter != this->uploads.end();) {
+    if(iter->texture == texture && iter->object == object &&
+      (level < 0 || (iter->target == target && iter->level == level))) {
+      this->finishedUploads.push_back(-static_cast<GLint>(iter->id));
+      iter = this->uploads.erase(iter);
+    } else {
+      ++iter;
     }
+  }
+}
 
-    case GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING:
-    {
-      (this->glGetVertexAttribiv)(index, pname, &value);
-      return WebGLAttrib(value);
+//Sends the rest of the uploads of an object right away, for calls that write
+//over them or read them back. Matched like in cancelUploads
+void WebGLRenderingContext::flushUploads(bool texture, GLuint object, GLenum target, GLint level) {
+  for(auto iter = this->uploads.begin(); iter != this->uploads.end();) {
+    if(iter->texture == texture && iter->object == object &&
+      (level < 0 || (iter->target == target && iter->level == level))) {
+      while(!this->sendUpload(*iter)) {}
+      this->finishedUploads.push_back(static_cast<GLint>(iter->id));
+      iter = this->uploads.erase(iter);
+    } else {
+      ++iter;
     }
+  }
+}
 
-    case GL_CURRENT_VERTEX_ATTRIB:
-    {
-      std::array<float, 4> vextex_attribs;
-
-      (this->glGetVertexAttribfv)(index, pname, vextex_attribs.data());
-
-      std::vector<float> vextex_attribs_vector(vextex_attribs.begin(), vextex_attribs.end());
-      return WebGLAttrib(std::move(vextex_attribs_vector));
+//Textures attached to the bound framebuffer are complete before it is read
+void WebGLRenderingContext::flushFramebufferUploads() {
+  if(this->uploads.empty() || this->framebufferBinding == 0) {
+    return;
+  }
+  for(const auto& it : this->framebufferInfo[this->framebufferBinding].attachments) {
+    if(it.second.target == GL_TEXTURE && it.second.object != 0) {
+      this->flushUploads(true, it.second.object);
     }
-
-    default:
-      return WebGLAttrib(GL_INVALID_ENUM);
   }
 }
 
-const char* WebGLRenderingContext::GetSupportedExtensions() {
-  
-  const char *extensions = reinterpret_cast<const char*>(
-    (this->glGetString)(GL_EXTENSIONS));
-  
-  return extensions;
+void WebGLRenderingContext::SetUploadBudget(GLint microseconds) {
+  this->uploadBudget = std::max(microseconds, 0);
 }
 
-// WebGLExtension WebGLRenderingContext::GetExtension(const std::string& name) {
-//   if(name == "WEBGL_draw_buffers") {
-//     WebGLDrawBuffersExtension ret;
-//     return ret;
-//   }
-//   //TODO
-//   return nullptr;
-// }
+//Sends queued uploads in order until the budget is used, at least one strip
+//goes out every time so that uploads always make progress
+void WebGLRenderingContext::ProcessUploads() {
+  if(this->uploads.empty()) {
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const auto budget = std::chrono::microseconds(this->uploadBudget);
+  do {
+    WebGLUpload& upload = this->uploads.front();
+    if(this->sendUpload(upload)) {
+      this->finishedUploads.push_back(static_cast<GLint>(upload.id));
+      this->uploads.pop_front();
+    }
+  } while(!this->uploads.empty() && std::chrono::steady_clock::now() - start < budget);
+}
 
-GLenum WebGLRenderingContext::CheckFramebufferStatus(GLenum target) {
-  return (this->glCheckFramebufferStatus)(target);
+WebGLScratchArray<GLint> WebGLRenderingContext::TakeFinishedUploads() {
+  WebGLScratchArray<GLint> finished = this->scratchArray(this->finishedUploads.data(), this->finishedUploads.size());
+  this->finishedUploads.clear();
+  return finished;
 }
 
-void WebGLRenderingContext::DrawBuffersWEBGL(const std::vector<GLenum>& buffersArray) {
+WebGLTexParameter WebGLRenderingContext::GetTexParameter(GLenum target, GLenum pname) {
 #if !defined(__vita__)
-  (this->glDrawBuffersEXT)(buffersArray.size(), buffersArray.data());
+  if (pname == GL_TEXTURE_MAX_ANISOTROPY_EXT) {
+    GLfloat param_value = 0;
+    (this->glGetTexParameterfv)(target, pname, &param_value);
+    return WebGLTexParameter(param_value);
+  } else {
+    GLint param_value = 0;
+    (this->glGetTexParameteriv)(target, pname, &param_value);
+    return WebGLTexParameter(param_value);
+  }
 #else
   // throw std::runtime_error("glSampleCoverage is not implemented in this platform!");
+  return std::nullopt;
 #endif
-}
+} 
 
-WebGLDrawBuffersExtension WebGLRenderingContext::EXTWEBGL_draw_buffers() {
-  return WebGLDrawBuffersExtension{};
-}
+WebGLActiveElement WebGLRenderingContext::GetActiveAttrib(GLuint program, GLuint index) {
+  GLint maxLength;
+  (this->glGetProgramiv)(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
 
-void WebGLRenderingContext::BindVertexArrayOES(GLuint array) {
-  (this->glBindVertexArrayOES)(array);
-}
+  ScratchArena::Scope scope(scratch);
+  char* name = scratch.allocate<char>(std::max(maxLength, 1));
+  name[0] = '\0';
+  GLsizei length = 0;
+  GLenum  type;
+  GLsizei size;
+  (this->glGetActiveAttrib)(program, index, maxLength, &length, &size, &type, name);
 
-GLuint WebGLRenderingContext::CreateVertexArrayOES() {
-  GLuint array = 0;
-  (this->glGenVertexArraysOES)(1, &array);
-  this->registerGLObj(GLOBJECT_TYPE_VERTEX_ARRAY, array);
+  std::string sname(name);
 
-  return array;
+  if (length > 0) {
+    return WebGLActiveElementContent(size, type, sname);
+  } else {
+    return std::nullopt;
+  }
 }
 
-void WebGLRenderingContext::DeleteVertexArrayOES(GLuint array) {
-  this->unregisterGLObj(GLOBJECT_TYPE_VERTEX_ARRAY, array);
+WebGLActiveElement WebGLRenderingContext::GetActiveUniform(GLuint program, GLuint index) {
+  GLint maxLength;
+  (this->glGetProgramiv)(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
 
-  (this->glDeleteVertexArraysOES)(1, &array);
-}
+  ScratchArena::Scope scope(scratch);
+  char* name = scratch.allocate<char>(std::max(maxLength, 1));
+  name[0] = '\0';
+  GLsizei length = 0;
+  GLenum  type;
+  GLsizei size;
+  (this->glGetActiveUniform)(program, index, maxLength, &length, &size, &type, name);
 
-bool WebGLRenderingContext::IsVertexArrayOES(GLuint array) {
-#if !defined(__vita__)
-  return (this->glIsVertexArrayOES)(array) != 0;
+  std::string sname(name);
+
+  if (length > 0) {
+    return WebGLActiveElementContent(size, type, sname);
+  } else {
+    return std::nullopt;
+  }
+}
+
+WebGLScratchArray<GLuint> WebGLRenderingContext::GetAttachedShaders(GLuint program) {
+  GLint numAttachedShaders = 0;
+  (this->glGetProgramiv)(program, GL_ATTACHED_SHADERS, &numAttachedShaders);
+
+  const ScratchArena::Mark mark = scratch.mark();
+  GLuint* shaders = scratch.allocate<GLuint>(std::max(numAttachedShaders, 1));
+  GLsizei count = 0;
+  (this->glGetAttachedShaders)(program, numAttachedShaders, &count, shaders);
+
+  return WebGLScratchArray<GLuint>{ shaders, static_cast<size_t>(count), &scratch, mark };
+}
+
+//Type and number of values returned by a numeric parameter
+static void parameterShape(GLenum pname, GLenum& type, uint8_t& length) {
+  type = GL_INT;
+  length = 1;
+  switch(pname) {
+    case GL_BLEND:
+    case GL_CULL_FACE:
+    case GL_DEPTH_TEST:
+    case GL_DEPTH_WRITEMASK:
+    case GL_DITHER:
+    case GL_POLYGON_OFFSET_FILL:
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    case GL_SAMPLE_COVERAGE:
+    case GL_SAMPLE_COVERAGE_INVERT:
+    case GL_SCISSOR_TEST:
+    case GL_STENCIL_TEST:
+      type = GL_BOOL;
+    break;
+
+    case GL_COLOR_WRITEMASK:
+      type = GL_BOOL;
+      length = 4;
+    break;
+
+    case GL_DEPTH_CLEAR_VALUE:
+    case GL_LINE_WIDTH:
+    case GL_POLYGON_OFFSET_FACTOR:
+    case GL_POLYGON_OFFSET_UNITS:
+    case GL_SAMPLE_COVERAGE_VALUE:
+    case GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT:
+      type = GL_FLOAT;
+    break;
+
+    case GL_ALIASED_LINE_WIDTH_RANGE:
+    case GL_ALIASED_POINT_SIZE_RANGE:
+    case GL_DEPTH_RANGE:
+      type = GL_FLOAT;
+      length = 2;
+    break;
+
+    case GL_BLEND_COLOR:
+    case GL_COLOR_CLEAR_VALUE:
+      type = GL_FLOAT;
+      length = 4;
+    break;
+
+    case GL_MAX_VIEWPORT_DIMS:
+      length = 2;
+    break;
+
+    case GL_SCISSOR_BOX:
+    case GL_VIEWPORT:
+      length = 4;
+    break;
+  }
+}
+
+//State shadow entry and first word holding a parameter
+static bool shadowedParameter(GLenum pname, GLenum& key, uint8_t& index) {
+  key = pname;
+  index = 0;
+  switch(pname) {
+    case GL_BLEND:
+    case GL_CULL_FACE:
+    case GL_DEPTH_TEST:
+    case GL_DITHER:
+    case GL_POLYGON_OFFSET_FILL:
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    case GL_SAMPLE_COVERAGE:
+    case GL_SCISSOR_TEST:
+    case GL_STENCIL_TEST:
+    case GL_ACTIVE_TEXTURE:
+    case GL_ARRAY_BUFFER_BINDING:
+    case GL_BLEND_COLOR:
+    case GL_COLOR_CLEAR_VALUE:
+    case GL_COLOR_WRITEMASK:
+    case GL_CULL_FACE_MODE:
+    case GL_DEPTH_CLEAR_VALUE:
+    case GL_DEPTH_FUNC:
+    case GL_DEPTH_RANGE:
+    case GL_DEPTH_WRITEMASK:
+    case GL_FRONT_FACE:
+    case GL_LINE_WIDTH:
+    case GL_SCISSOR_BOX:
+    case GL_STENCIL_CLEAR_VALUE:
+    case GL_STENCIL_WRITEMASK:
+    case GL_STENCIL_BACK_WRITEMASK:
+    case GL_VIEWPORT:
+      return true;
+
+    case GL_BLEND_SRC_RGB:
+    case GL_BLEND_DST_RGB:
+    case GL_BLEND_SRC_ALPHA:
+    case GL_BLEND_DST_ALPHA:
+      key = GL_BLEND_SRC_RGB;
+      index = pname == GL_BLEND_SRC_RGB ? 0 : pname == GL_BLEND_DST_RGB ? 1 : pname == GL_BLEND_SRC_ALPHA ? 2 : 3;
+      return true;
+
+    case GL_BLEND_EQUATION_RGB:
+    case GL_BLEND_EQUATION_ALPHA:
+      key = GL_BLEND_EQUATION_RGB;
+      index = pname == GL_BLEND_EQUATION_RGB ? 0 : 1;
+      return true;
+
+    case GL_POLYGON_OFFSET_FACTOR:
+    case GL_POLYGON_OFFSET_UNITS:
+      key = GL_POLYGON_OFFSET_FACTOR;
+      index = pname == GL_POLYGON_OFFSET_FACTOR ? 0 : 1;
+      return true;
+
+    case GL_STENCIL_FUNC:
+    case GL_STENCIL_REF:
+    case GL_STENCIL_VALUE_MASK:
+      key = GL_STENCIL_FUNC;
+      index = pname == GL_STENCIL_FUNC ? 0 : pname == GL_STENCIL_REF ? 1 : 2;
+      return true;
+
+    case GL_STENCIL_BACK_FUNC:
+    case GL_STENCIL_BACK_REF:
+    case GL_STENCIL_BACK_VALUE_MASK:
+      key = GL_STENCIL_BACK_FUNC;
+      index = pname == GL_STENCIL_BACK_FUNC ? 0 : pname == GL_STENCIL_BACK_REF ? 1 : 2;
+      return true;
+
+    case GL_STENCIL_FAIL:
+    case GL_STENCIL_PASS_DEPTH_FAIL:
+    case GL_STENCIL_PASS_DEPTH_PASS:
+      key = GL_STENCIL_FAIL;
+      index = pname == GL_STENCIL_FAIL ? 0 : pname == GL_STENCIL_PASS_DEPTH_FAIL ? 1 : 2;
+      return true;
+
+    case GL_STENCIL_BACK_FAIL:
+    case GL_STENCIL_BACK_PASS_DEPTH_FAIL:
+    case GL_STENCIL_BACK_PASS_DEPTH_PASS:
+      key = GL_STENCIL_BACK_FAIL;
+      index = pname == GL_STENCIL_BACK_FAIL ? 0 : pname == GL_STENCIL_BACK_PASS_DEPTH_FAIL ? 1 : 2;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void WebGLRenderingContext::initLimits(const char* extensionString) {
+  static const GLenum LIMITS[] = {
+    GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS,
+    GL_MAX_CUBE_MAP_TEXTURE_SIZE,
+    GL_MAX_FRAGMENT_UNIFORM_VECTORS,
+    GL_MAX_RENDERBUFFER_SIZE,
+    GL_MAX_TEXTURE_IMAGE_UNITS,
+    GL_MAX_TEXTURE_SIZE,
+    GL_MAX_VARYING_VECTORS,
+    GL_MAX_VERTEX_ATTRIBS,
+    GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS,
+    GL_MAX_VERTEX_UNIFORM_VECTORS,
+    GL_MAX_VIEWPORT_DIMS,
+    GL_SUBPIXEL_BITS,
+    GL_ALIASED_LINE_WIDTH_RANGE,
+    GL_ALIASED_POINT_SIZE_RANGE,
+    GL_MAX_DRAW_BUFFERS_EXT,
+    GL_MAX_COLOR_ATTACHMENTS_EXT,
+    GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+  };
+
+  const bool drawBuffers = strstr(extensionString, "GL_EXT_draw_buffers") != NULL;
+  const bool anisotropic = strstr(extensionString, "GL_EXT_texture_filter_anisotropic") != NULL;
+
+  for(GLenum pname : LIMITS) {
+    //Extension limits are an invalid enum without the extension
+    if(((pname == GL_MAX_DRAW_BUFFERS_EXT || pname == GL_MAX_COLOR_ATTACHMENTS_EXT) && !drawBuffers) ||
+       (pname == GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT && !anisotropic)) {
+      continue;
+    }
+    this->limits[pname] = this->parameterValue(pname);
+  }
+}
+
+void WebGLRenderingContext::initStateShadow() {
+  static const GLenum CAPABILITIES[] = {
+    GL_BLEND,
+    GL_CULL_FACE,
+    GL_DEPTH_TEST,
+    GL_POLYGON_OFFSET_FILL,
+    GL_SAMPLE_ALPHA_TO_COVERAGE,
+    GL_SAMPLE_COVERAGE,
+    GL_SCISSOR_TEST,
+    GL_STENCIL_TEST
+  };
+  for(GLenum cap : CAPABILITIES) {
+    this->stateShadow[cap] = { GL_FALSE, 0, 0, 0 };
+  }
+  this->stateShadow[GL_DITHER] = { GL_TRUE, 0, 0, 0 };
+
+  this->stateShadow[GL_ACTIVE_TEXTURE] = { GL_TEXTURE0, 0, 0, 0 };
+  this->stateShadow[GL_ARRAY_BUFFER_BINDING] = { 0, 0, 0, 0 };
+  this->stateShadow[GL_BLEND_COLOR] = { 0, 0, 0, 0 };
+  this->stateShadow[GL_BLEND_EQUATION_RGB] = { GL_FUNC_ADD, GL_FUNC_ADD, 0, 0 };
+  this->stateShadow[GL_BLEND_SRC_RGB] = { GL_ONE, GL_ZERO, GL_ONE, GL_ZERO };
+  this->stateShadow[GL_COLOR_CLEAR_VALUE] = { 0, 0, 0, 0 };
+  this->stateShadow[GL_COLOR_WRITEMASK] = { GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
+  this->stateShadow[GL_CULL_FACE_MODE] = { GL_BACK, 0, 0, 0 };
+  this->stateShadow[GL_DEPTH_CLEAR_VALUE] = { floatBits(1.0f), 0, 0, 0 };
+  this->stateShadow[GL_DEPTH_FUNC] = { GL_LESS, 0, 0, 0 };
+  this->stateShadow[GL_DEPTH_RANGE] = { floatBits(0.0f), floatBits(1.0f), 0, 0 };
+  this->stateShadow[GL_DEPTH_WRITEMASK] = { GL_TRUE, 0, 0, 0 };
+  this->stateShadow[GL_FRONT_FACE] = { GL_CCW, 0, 0, 0 };
+  this->stateShadow[GL_LINE_WIDTH] = { floatBits(1.0f), 0, 0, 0 };
+  this->stateShadow[GL_POLYGON_OFFSET_FACTOR] = { floatBits(0.0f), floatBits(0.0f), 0, 0 };
+  this->stateShadow[GL_STENCIL_CLEAR_VALUE] = { 0, 0, 0, 0 };
+  this->stateShadow[GL_STENCIL_FUNC] = { GL_ALWAYS, 0, ~0u, 0 };
+  this->stateShadow[GL_STENCIL_BACK_FUNC] = { GL_ALWAYS, 0, ~0u, 0 };
+  this->stateShadow[GL_STENCIL_FAIL] = { GL_KEEP, GL_KEEP, GL_KEEP, 0 };
+  this->stateShadow[GL_STENCIL_BACK_FAIL] = { GL_KEEP, GL_KEEP, GL_KEEP, 0 };
+  this->stateShadow[GL_STENCIL_WRITEMASK] = { ~0u, 0, 0, 0 };
+  this->stateShadow[GL_STENCIL_BACK_WRITEMASK] = { ~0u, 0, 0, 0 };
+
+  this->attrib0Value[0] = 0;
+  this->attrib0Value[1] = 0;
+  this->attrib0Value[2] = 0;
+  this->attrib0Value[3] = 1;
+}
+
+WebGLParameterValue WebGLRenderingContext::parameterValue(GLenum pname) {
+  auto limit = this->limits.find(pname);
+  if(limit != this->limits.end()) {
+    return limit->second;
+  }
+
+  WebGLParameterValue value;
+  parameterShape(pname, value.type, value.length);
+
+  GLenum key;
+  uint8_t index;
+  if(shadowedParameter(pname, key, index)) {
+    auto state = this->stateShadow.find(key);
+    if(state != this->stateShadow.end()) {
+      memcpy(value.words, state->second.data() + index, value.length * sizeof(uint32_t));
+      return value;
+    }
+  }
+
+  //Anything else, like the viewport before it is first set, asks the driver
+  switch(value.type) {
+    case GL_BOOL:
+    {
+      GLboolean params[4] = { 0, 0, 0, 0 };
+      (this->glGetBooleanv)(pname, params);
+      for(uint8_t i = 0; i < value.length; ++i) {
+        value.words[i] = params[i];
+      }
+    }
+    break;
+
+    case GL_FLOAT:
+    {
+      GLfloat params[4] = { 0, 0, 0, 0 };
+      (this->glGetFloatv)(pname, params);
+      memcpy(value.words, params, sizeof(params));
+    }
+    break;
+
+    default:
+    {
+      GLint params[4] = { 0, 0, 0, 0 };
+      (this->glGetIntegerv)(pname, params);
+      memcpy(value.words, params, sizeof(params));
+    }
+    break;
+  }
+
+  return value;
+}
+
+WebGLParameter WebGLRenderingContext::GetParameter(GLenum name) {
+  switch(name) {
+    case 0x9240 /* UNPACK_FLIP_Y_WEBGL */:
+      return WebGLParameter(this->unpack_flip_y);
+
+    case 0x9241 /* UNPACK_PREMULTIPLY_ALPHA_WEBGL*/:
+      return WebGLParameter(this->unpack_premultiply_alpha);
+
+    case 0x9243 /* UNPACK_COLORSPACE_CONVERSION_WEBGL */:
+      return WebGLParameter(this->unpack_colorspace_conversion);
+
+    case 0x93A4 /* PACK_REVERSE_ROW_ORDER_ANGLE */:
+      return WebGLParameter(this->pack_flip_y);
+
+    case GL_RENDERER:
+    case GL_SHADING_LANGUAGE_VERSION:
+    case GL_VENDOR:
+    case GL_VERSION:
+    case GL_EXTENSIONS:
+    {
+      const char *params = reinterpret_cast<const char*>((this->glGetString)(name));
+      if(params) {
+        return WebGLParameter(params);
+      }
+    }
+    break;
+
+    default:
+    break;
+  }
+
+  const WebGLParameterValue value = this->parameterValue(name);
+  switch(value.type) {
+    case GL_BOOL:
+    {
+      if(value.length == 1) {
+        return WebGLParameter(value.words[0] != 0);
+      }
+      GLboolean params[4];
+      std::copy(value.words, value.words + value.length, params);
+      return WebGLParameter(this->scratchArray(params, value.length));
+    }
+
+    case GL_FLOAT:
+    {
+      GLfloat params[4];
+      memcpy(params, value.words, sizeof(params));
+      if(value.length == 1) {
+        return WebGLParameter(params[0]);
+      }
+      return WebGLParameter(this->scratchArray(params, value.length));
+    }
+
+    default:
+    {
+      GLint params[4];
+      memcpy(params, value.words, sizeof(params));
+      if(value.length == 1) {
+        return WebGLParameter(params[0]);
+      }
+      return WebGLParameter(this->scratchArray(params, value.length));
+    }
+  }
+}
+
+GLint WebGLRenderingContext::GetParameterInto(GLenum name, WebGLParameterTarget target) {
+  const WebGLParameterValue value = this->parameterValue(name);
+  GLfloat f[4];
+  GLint i[4];
+  memcpy(f, value.words, sizeof(f));
+  memcpy(i, value.words, sizeof(i));
+
+  return std::visit([&](auto& array) -> GLint {
+    using T = std::remove_pointer_t<decltype(array.data())>;
+    const GLint length = static_cast<GLint>(std::min<size_t>(value.length, array.size()));
+    T* data = array.data();
+    for(GLint n = 0; n < length; ++n) {
+      switch(value.type) {
+        case GL_FLOAT:
+          data[n] = std::is_floating_point_v<T> ? static_cast<T>(f[n]) : static_cast<T>(std::lround(f[n]));
+        break;
+        case GL_BOOL:
+          data[n] = static_cast<T>(value.words[n] != 0);
+        break;
+        default:
+          data[n] = static_cast<T>(i[n]);
+        break;
+      }
+    }
+    return length;
+  }, target);
+}
+
+GLint WebGLRenderingContext::GetBufferParameter(GLenum target, GLenum pname) {
+  GLint params;
+  (this->glGetBufferParameteriv)(target, pname, &params);
+
+  return params;
+}
+
+GLint WebGLRenderingContext::GetFramebufferAttachmentParameter(GLenum target, GLenum attachment, GLenum pname) {
+  GLint params;
+  (this->glGetFramebufferAttachmentParameteriv)(target, attachment, pname, &params);
+
+  return params;
+}
+
+std::string WebGLRenderingContext::GetProgramInfoLog(GLuint program) {
+  GLint infoLogLength;
+  (this->glGetProgramiv)(program, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+  ScratchArena::Scope scope(scratch);
+  char* error = scratch.allocate<char>(infoLogLength+1);
+  error[0] = '\0';
+  (this->glGetProgramInfoLog)(program, infoLogLength+1, &infoLogLength, error);
+
+  return std::string(error);
+}
+
+WebGLShaderPrecisionFormat WebGLRenderingContext::GetShaderPrecisionFormat(GLenum shaderType, GLenum precisionType) {
+#if !defined(__vita__)
+  GLint range[2];
+  GLint precision;
+
+  (this->glGetShaderPrecisionFormat)(shaderType, precisionType, range, &precision);
+
+  return WebGLShaderPrecisionFormatContent(range[0], range[1], precision);
+#else
+  // throw std::runtime_error("glGetShaderPrecisionFormat is not implemented in this platform!");
+  return std::nullopt;
+#endif
+}
+
+int WebGLRenderingContext::GetRenderbufferParameter(GLenum target, GLenum pname) {
+#if !defined(__vita__)
+  int value;
+  (this->glGetRenderbufferParameteriv)(target, pname, &value);
+
+  return value;
+#else
+  // throw std::runtime_error("glGetRenderbufferParameteriv is not implemented in this platform!");
+  return 0;
+#endif
+}
+
+WebGLScratchArray<GLfloat> WebGLRenderingContext::GetUniform(GLint program, GLint location) {
+#if !defined(__vita__)
+  if(static_cast<GLuint>(program) == this->activeProgram) {
+    this->flushUniforms();
+  }
+  const ScratchArena::Mark mark = scratch.mark();
+  GLfloat* data = scratch.allocate<GLfloat>(16);
+  (this->glGetUniformfv)(program, location, data);
+
+  return WebGLScratchArray<GLfloat>{ data, 16, &scratch, mark };
 #else
   // throw std::runtime_error("glSampleCoverage is not implemented in this platform!");
-  return false;
+  return WebGLScratchArray<GLfloat>{};
 #endif
 }
+
+WebGLAttrib WebGLRenderingContext::GetVertexAttrib(GLint index, GLenum pname) {
+  GLint value;
+
+  switch (pname) {
+    case GL_VERTEX_ATTRIB_ARRAY_ENABLED:
+    case GL_VERTEX_ATTRIB_ARRAY_NORMALIZED:
+    {
+      (this->glGetVertexAttribiv)(index, pname, &value);
+      return WebGLAttrib(value);
+    }
+
+    case GL_VERTEX_ATTRIB_ARRAY_SIZE:
+    case GL_VERTEX_ATTRIB_ARRAY_STRIDE:
+    case GL_VERTEX_ATTRIB_ARRAY_TYPE:
+    {
+      (this->glGetVertexAttribiv)(index, pname, &value);
+      return WebGLAttrib(value);
+    }
+
+    case GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING:
+    {
+      (this->glGetVertexAttribiv)(index, pname, &value);
+      return WebGLAttrib(value);
+    }
+
+    case GL_CURRENT_VERTEX_ATTRIB:
+    {
+      const ScratchArena::Mark mark = scratch.mark();
+      GLfloat* vextex_attribs = scratch.allocate<GLfloat>(4);
+
+      (this->glGetVertexAttribfv)(index, pname, vextex_attribs);
+
+      return WebGLAttrib(WebGLScratchArray<GLfloat>{ vextex_attribs, 4, &scratch, mark });
+    }
+
+    default:
+      return WebGLAttrib(GL_INVALID_ENUM);
+  }
+}
+
+const char* WebGLRenderingContext::GetSupportedExtensions() {
+  
+  const char *extensions = reinterpret_cast<const char*>(
+    (this->glGetString)(GL_EXTENSIONS));
+  
+  return extensions;
+}
+
+// WebGLExtension WebGLRenderingContext::GetExtension(const std::string& name) {
+//   if(name == "WEBGL_draw_buffers") {
+//     WebGLDrawBuffersExtension ret;
+//     return ret;
+//   }
+//   //TODO
+//   return nullptr;
+// }
+
+GLenum WebGLRenderingContext::CheckFramebufferStatus(GLenum target) {
+  return (this->glCheckFramebufferStatus)(target);
+}
+
+void WebGLRenderingContext::DrawBuffersWEBGL(const std::vector<GLenum>& buffersArray) {
+#if !defined(__vita__)
+  (this->glDrawBuffersEXT)(buffersArray.size(), buffersArray.data());
+#else
+  // throw std::runtime_error("glSampleCoverage is not implemented in this platform!");
+#endif
+}
+
+WebGLDrawBuffersExtension WebGLRenderingContext::EXTWEBGL_draw_buffers() {
+  return WebGLDrawBuffersExtension{};
+}
+
+void WebGLRenderingContext::BindVertexArrayOES(GLuint array) {
+  //Element array bindings are part of the vertex array object state
+  this->vertexArrayElementBindings[this->activeVertexArray] = this->elementArrayBufferBinding;
+  this->activeVertexArray = array;
+  auto binding = this->vertexArrayElementBindings.find(array);
+  this->elementArrayBufferBinding = binding != this->vertexArrayElementBindings.end() ? binding->second : 0;
+
+  (this->glBindVertexArrayOES)(array);
+}
+
+GLuint WebGLRenderingContext::CreateVertexArrayOES() {
+  GLuint array = 0;
+  (this->glGenVertexArraysOES)(1, &array);
+  this->registerGLObj(GLOBJECT_TYPE_VERTEX_ARRAY, array);
+
+  return array;
+}
+
+void WebGLRenderingContext::DeleteVertexArrayOES(GLuint array) {
+  this->unregisterGLObj(GLOBJECT_TYPE_VERTEX_ARRAY, array);
+
+  //Deleting the bound vertex array reverts to the default one
+  if(array != 0 && array == this->activeVertexArray) {
+    this->activeVertexArray = 0;
+    this->elementArrayBufferBinding = this->vertexArrayElementBindings[0];
+  }
+  this->vertexArrayElementBindings.erase(array);
+  for(auto it = this->vertexAttribs.begin(); it != this->vertexAttribs.end();) {
+    if(it->first.first == array) {
+      it = this->vertexAttribs.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  (this->glDeleteVertexArraysOES)(1, &array);
+}
+
+bool WebGLRenderingContext::IsVertexArrayOES(GLuint array) {
+#if !defined(__vita__)
+  return (this->glIsVertexArrayOES)(array) != 0;
+#else
+  // throw std::runtime_error("glSampleCoverage is not implemented in this platform!");
+  return false;
+#endif
+}
+
+bool WebGLRenderingContext::stateChanged(GLenum pname, GLuint a, GLuint b, GLuint c, GLuint d) {
+  const std::array<GLuint, 4> value = { a, b, c, d };
+  auto state = this->stateShadow.emplace(pname, value);
+  if(!state.second) {
+    if(state.first->second == value) {
+      return false;
+    }
+    state.first->second = value;
+  }
+  return true;
+}
+
+//Number of 32-bit words in a single element of each uniform kind
+static const uint8_t UNIFORM_WORDS[] = { 1, 2, 3, 4, 1, 2, 3, 4, 4, 9, 16 };
+
+void WebGLRenderingContext::issueUniform(WebGLUniformKind kind, GLint location, GLsizei count, GLboolean transpose, const void* data) {
+  const GLfloat* f = reinterpret_cast<const GLfloat*>(data);
+  const GLint* i = reinterpret_cast<const GLint*>(data);
+  switch(kind) {
+    case WEBGL_UNIFORM_1F: (this->glUniform1fv)(location, count, f); break;
+    case WEBGL_UNIFORM_2F: (this->glUniform2fv)(location, count, f); break;
+    case WEBGL_UNIFORM_3F: (this->glUniform3fv)(location, count, f); break;
+    case WEBGL_UNIFORM_4F: (this->glUniform4fv)(location, count, f); break;
+    case WEBGL_UNIFORM_1I: (this->glUniform1iv)(location, count, i); break;
+    case WEBGL_UNIFORM_2I: (this->glUniform2iv)(location, count, i); break;
+    case WEBGL_UNIFORM_3I: (this->glUniform3iv)(location, count, i); break;
+    case WEBGL_UNIFORM_4I: (this->glUniform4iv)(location, count, i); break;
+    case WEBGL_UNIFORM_MATRIX_2FV: (this->glUniformMatrix2fv)(location, count, transpose, f); break;
+    case WEBGL_UNIFORM_MATRIX_3FV: (this->glUniformMatrix3fv)(location, count, transpose, f); break;
+    case WEBGL_UNIFORM_MATRIX_4FV: (this->glUniformMatrix4fv)(location, count, transpose, f); break;
+  }
+  ++this->uniformCallsIssued;
+}
+
+void WebGLRenderingContext::setUniform(WebGLUniformKind kind, GLint location, GLsizei count, GLboolean transpose, const void* data) {
+  //Invalid locations and missing programs are left for GL to ignore or report
+  if(location < 0 || this->activeProgram == 0) {
+    this->issueUniform(kind, location, count, transpose, data);
+    return;
+  }
+
+  //Array uploads may overlap other cached locations, send them in order and
+  //forget what is cached for the program
+  if(count != 1) {
+    this->flushUniforms();
+    this->issueUniform(kind, location, count, transpose, data);
+    this->uniformValues.erase(this->activeProgram);
+    return;
+  }
+
+  const uint8_t length = UNIFORM_WORDS[kind];
+  WebGLUniformValue& value = this->uniformValues[this->activeProgram][location];
+  if(value.length == length && value.kind == kind && value.transpose == transpose &&
+     memcmp(value.words, data, length * sizeof(uint32_t)) == 0) {
+    ++this->uniformCallsSkipped;
+    return;
+  }
+
+  value.kind = kind;
+  value.transpose = transpose;
+  value.length = length;
+  memcpy(value.words, data, length * sizeof(uint32_t));
+  if(!value.dirty) {
+    value.dirty = true;
+    this->dirtyUniforms.push_back(location);
+  }
+}
+
+void WebGLRenderingContext::flushUniforms() {
+  if(this->dirtyUniforms.empty()) {
+    return;
+  }
+
+  //Errors raised before are not blamed on the uniforms
+  if(this->errorMode == WEBGL_ERRORS_SYNC || this->debugErrorRaised) {
+    this->collectErrors();
+  }
+
+  auto program = this->uniformValues.find(this->activeProgram);
+  if(program != this->uniformValues.end()) {
+    for(GLint location : this->dirtyUniforms) {
+      auto value = program->second.find(location);
+      if(value != program->second.end() && value->second.dirty) {
+        value->second.dirty = false;
+        this->issueUniform(value->second.kind, location, 1, value->second.transpose, value->second.words);
+      }
+    }
+
+    //Values GL rejected are not cached, so a retry reaches GL and raises its
+    //error again. Deferred errors are only seen on swap, which forgets all of them
+    if((this->errorMode == WEBGL_ERRORS_SYNC || this->debugErrorRaised) &&
+       this->collectErrors() != GL_NO_ERROR) {
+      for(GLint location : this->dirtyUniforms) {
+        program->second.erase(location);
+      }
+    }
+  }
+  this->dirtyUniforms.clear();
+}
+
+std::vector<double> WebGLRenderingContext::GetUniformStats() {
+  return std::vector<double>{
+    static_cast<double>(this->uniformCallsIssued),
+    static_cast<double>(this->uniformCallsSkipped)
+  };
+}
+
+void WebGLRenderingContext::SetArenaSize(qjs_size_t size) {
+  this->scratch.resize(size);
+}
+
+std::vector<double> WebGLRenderingContext::GetArenaStats() {
+  return std::vector<double>{
+    static_cast<double>(this->scratch.capacity()),
+    static_cast<double>(this->scratch.used()),
+    static_cast<double>(this->scratch.highWater()),
+    static_cast<double>(this->scratch.fallbackCount()),
+    static_cast<double>(this->scratch.fallbackHighWater())
+  };
+}
+
+//Bytes per type, the total and the budget
+std::vector<double> WebGLRenderingContext::GetMemoryStats() {
+  return std::vector<double>{
+    static_cast<double>(this->memoryBytes[WEBGL_MEMORY_TEXTURE]),
+    static_cast<double>(this->memoryBytes[WEBGL_MEMORY_RENDERBUFFER]),
+    static_cast<double>(this->memoryBytes[WEBGL_MEMORY_BUFFER]),
+    static_cast<double>(this->memoryBytes[WEBGL_MEMORY_DRAWING_BUFFER] + this->surfaceBytes),
+    static_cast<double>(this->memoryTotal()),
+    this->memoryBudget
+  };
+}
+
+double WebGLRenderingContext::GetObjectMemory(GLuint type, GLuint object) {
+  switch(type) {
+    case GLOBJECT_TYPE_TEXTURE:
+    {
+      auto info = this->textureInfo.find(object);
+      return info != this->textureInfo.end() ? info->second.bytes : 0;
+    }
+    case GLOBJECT_TYPE_RENDERBUFFER:
+    {
+      auto info = this->renderbufferInfo.find(object);
+      return info != this->renderbufferInfo.end() ? info->second.bytes() : 0;
+    }
+    case GLOBJECT_TYPE_BUFFER:
+    {
+      auto size = this->bufferSizes.find(object);
+      return size != this->bufferSizes.end() ? size->second : 0;
+    }
+    default:
+      return 0;
+  }
+}
+
+void WebGLRenderingContext::SetMemoryBudget(double bytes) {
+  this->memoryBudget = std::max(bytes, 0.0);
+  this->overMemoryBudget = this->memoryBudget > 0 && this->memoryTotal() > this->memoryBudget;
+  this->memoryBudgetCrossed = this->overMemoryBudget;
+}
+
+GLboolean WebGLRenderingContext::TakeMemoryBudgetCrossed() {
+  const bool crossed = this->memoryBudgetCrossed;
+  this->memoryBudgetCrossed = false;
+  return crossed;
+}
+
+bool WebGLRenderingContext::IsRobustAccess() {
+  return this->robustAccess;
+}
+
+int64_t WebGLRenderingContext::GetMaxIndex(GLuint buffer, GLenum type, qjs_size_t offset, GLsizei count) {
+  if(count <= 0) {
+    return -1;
+  }
+
+  std::vector<WebGLIndexRange>& ranges = this->indexRanges[buffer];
+  for(const WebGLIndexRange& range : ranges) {
+    if(range.type == type && range.offset == offset && range.count == count) {
+      return range.maxIndex;
+    }
+  }
+
+  size_t elementSize = 0;
+  switch(type) {
+    case GL_UNSIGNED_BYTE:
+      elementSize = 1;
+    break;
+    case GL_UNSIGNED_SHORT:
+      elementSize = 2;
+    break;
+    case GL_UNSIGNED_INT:
+      elementSize = 4;
+    break;
+    default:
+      return -1;
+  }
+
+  //Callers validate the range beforehand, this only guards the shadow access
+  auto shadow = this->elementShadows.find(buffer);
+  if(shadow == this->elementShadows.end() ||
+     static_cast<size_t>(offset) + count * elementSize > shadow->second.size()) {
+    return -1;
+  }
+
+  const uint8_t* data = shadow->second.data() + offset;
+  int64_t maxIndex = -1;
+  switch(type) {
+    case GL_UNSIGNED_BYTE:
+      maxIndex = maxIndexU8(data, count);
+    break;
+    case GL_UNSIGNED_SHORT:
+      maxIndex = maxIndexU16(reinterpret_cast<const uint16_t*>(data), count);
+    break;
+    case GL_UNSIGNED_INT:
+      maxIndex = maxIndexU32(reinterpret_cast<const uint32_t*>(data), count);
+    break;
+  }
+
+  if(ranges.size() >= MAX_INDEX_RANGES) {
+    ranges.erase(ranges.begin());
+  }
+  ranges.push_back(WebGLIndexRange{type, offset, count, maxIndex});
+
+  return maxIndex;
+}
+
+//Storage calls can run out of memory, the error is kept for getError. With
+//deferred errors the call is assumed to have succeeded until swap collects
+//the errors of the frame
+bool WebGLRenderingContext::storageSucceeded() {
+  switch(this->errorMode) {
+    case WEBGL_ERRORS_SYNC:
+      return this->collectErrors() == GL_NO_ERROR;
+    case WEBGL_ERRORS_DEBUG:
+      return !this->debugErrorRaised || this->collectErrors() == GL_NO_ERROR;
+    default:
+      return true;
+  }
+}
+
+void WebGLRenderingContext::textureSpecified(GLenum target, GLint level, GLenum format, GLenum type, GLsizei width, GLsizei height) {
+  this->textureSpecified(target, level, format, type, width, height,
+    size_t(width) * height * unpackPixelSize(type, format));
+}
+
+void WebGLRenderingContext::textureSpecified(GLenum target, GLint level, GLenum format, GLenum type, GLsizei width, GLsizei height, size_t bytes) {
+  const GLenum bindTarget = target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+  auto binding = this->textureBindings.find(std::make_pair(this->stateShadow[GL_ACTIVE_TEXTURE][0], bindTarget));
+  if(binding == this->textureBindings.end() || binding->second == 0) {
+    return;
+  }
+  WebGLTextureInfo& info = this->textureInfo[binding->second];
+  info.format = format;
+  info.type = type;
+  info.levels[level] = std::make_pair(width, height);
+  this->textureStored(binding->second, target, level, bytes);
+}
+
+//Counts the levels glGenerateMipmap allocated below level 0, on every face of
+//a cube map
+void WebGLRenderingContext::mipmapsGenerated(GLuint texture, GLenum bindTarget) {
+  static const GLenum FACES[] = {
+    GL_TEXTURE_CUBE_MAP_POSITIVE_X,
+    GL_TEXTURE_CUBE_MAP_NEGATIVE_X,
+    GL_TEXTURE_CUBE_MAP_POSITIVE_Y,
+    GL_TEXTURE_CUBE_MAP_NEGATIVE_Y,
+    GL_TEXTURE_CUBE_MAP_POSITIVE_Z,
+    GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
+  };
+  auto iter = this->textureInfo.find(texture);
+  if(texture == 0 || iter == this->textureInfo.end()) {
+    return;
+  }
+  WebGLTextureInfo& info = iter->second;
+  auto base = info.levels.find(0);
+  if(base == info.levels.end() || info.type == GL_NONE) {
+    return;
+  }
+  const size_t pixelSize = unpackPixelSize(info.type, info.format);
+  const std::pair<GLsizei, GLsizei> size = base->second;
+  const bool cube = bindTarget == GL_TEXTURE_CUBE_MAP;
+  for(size_t face = 0; face < (cube ? 6 : 1); ++face) {
+    GLsizei width = size.first;
+    GLsizei height = size.second;
+    for(GLint level = 1; width > 1 || height > 1; ++level) {
+      width = std::max(width / 2, 1);
+      height = std::max(height / 2, 1);
+      info.levels[level] = std::make_pair(width, height);
+      this->textureStored(texture, cube ? FACES[face] : GL_TEXTURE_2D, level, size_t(width) * height * pixelSize);
+    }
+  }
+}
+
+//Replaces the bytes of a texture image, the drawing buffer texture is counted
+//with the drawing buffer
+void WebGLRenderingContext::textureStored(GLuint texture, GLenum target, GLint level, size_t bytes) {
+  WebGLTextureInfo& info = this->textureInfo[texture];
+  size_t& image = info.imageBytes[std::make_pair(target, level)];
+  this->memoryChanged(
+    texture == this->drawingBufferTexture ? WEBGL_MEMORY_DRAWING_BUFFER : WEBGL_MEMORY_TEXTURE,
+    image, bytes);
+  info.bytes = info.bytes - image + bytes;
+  image = bytes;
+}
+
+void WebGLRenderingContext::memoryChanged(WebGLMemoryType type, size_t previous, size_t current) {
+  this->memoryBytes[type] = this->memoryBytes[type] - previous + current;
+  if(this->memoryBudget <= 0) {
+    return;
+  }
+  //Only going over the budget is reported, once until it is back under it
+  const bool over = this->memoryTotal() > this->memoryBudget;
+  if(over && !this->overMemoryBudget) {
+    this->memoryBudgetCrossed = true;
+  }
+  this->overMemoryBudget = over;
+}
+
+size_t WebGLRenderingContext::memoryTotal() const {
+  size_t total = this->surfaceBytes;
+  for(size_t bytes : this->memoryBytes) {
+    total += bytes;
+  }
+  return total;
+}
+
+//Color, depth and stencil of the EGL surface, window surfaces have a front and
+//a back color buffer
+void WebGLRenderingContext::measureSurface() {
+  EGLint width = 0, height = 0, colorBits = 0, depthBits = 0, stencilBits = 0;
+  eglQuerySurface(DISPLAY, surface, EGL_WIDTH, &width);
+  eglQuerySurface(DISPLAY, surface, EGL_HEIGHT, &height);
+  eglGetConfigAttrib(DISPLAY, config, EGL_BUFFER_SIZE, &colorBits);
+  eglGetConfigAttrib(DISPLAY, config, EGL_DEPTH_SIZE, &depthBits);
+  eglGetConfigAttrib(DISPLAY, config, EGL_STENCIL_SIZE, &stencilBits);
+  const size_t colorBuffers = this->windowSurface ? 2 : 1;
+  const size_t pixelBits = colorBits * colorBuffers + depthBits + stencilBits;
+  this->surfaceBytes = size_t(width) * height * ((pixelBits + 7) / 8);
+}
+
+WebGLVertexAttribState& WebGLRenderingContext::vertexAttrib(GLuint index) {
+  return this->vertexAttribs[std::make_pair(this->activeVertexArray, index)];
+}
+
+void WebGLRenderingContext::EnableExtension(const std::string& name) {
+  if(name == "oes_element_index_uint") {
+    this->elementIndexUint = true;
+  } else if(name == "webgl_draw_buffers") {
+    this->drawBuffers = true;
+  } else if(name == "ext_blend_minmax") {
+    this->blendMinmax = true;
+  } else if(name == "ext_color_buffer_half_float") {
+    this->colorBufferHalfFloat = true;
+  }
+}
+
+void WebGLRenderingContext::SetDrawingBuffer(GLuint framebuffer) {
+  this->drawingBuffer = framebuffer;
+}
+
+void WebGLRenderingContext::SetDrawingBufferSize(GLsizei width, GLsizei height) {
+  this->drawingBufferWidth = width;
+  this->drawingBufferHeight = height;
+  //A window surface follows the size of the window
+  if(this->windowSurface) {
+    this->measureSurface();
+  }
+}
+
+void WebGLRenderingContext::SetDrawingBufferStorage(GLuint texture, GLuint renderbuffer) {
+  this->drawingBufferTexture = texture;
+  this->drawingBufferRenderbuffer = renderbuffer;
+}
+
+void WebGLRenderingContext::FramebufferAttachment(GLuint framebuffer, GLenum attachment, GLenum target, GLuint object, GLint level) {
+  this->framebufferInfo[framebuffer].attachments[attachment] = WebGLAttachment{ target, object, level };
+}
+
+GLenum WebGLRenderingContext::FramebufferStatus(GLuint framebuffer) {
+  return this->framebufferStatus(framebuffer);
+}
+
+static inline bool isColorAttachment(GLenum attachment) {
+  return attachment >= GL_COLOR_ATTACHMENT0 && attachment < GL_COLOR_ATTACHMENT0 + 16;
+}
+
+//Completeness as WebGL 1 defines it, stricter than what most drivers accept
+GLenum WebGLRenderingContext::framebufferStatus(GLuint framebuffer) {
+  WebGLFramebufferInfo& info = this->framebufferInfo[framebuffer];
+  const WebGLAttachment none;
+  auto attachment = [&info, &none](GLenum point) -> const WebGLAttachment& {
+    auto it = info.attachments.find(point);
+    return it != info.attachments.end() ? it->second : none;
+  };
+  const WebGLAttachment& depth = attachment(GL_DEPTH_ATTACHMENT);
+  const WebGLAttachment& depthStencil = attachment(0x821A);
+  const WebGLAttachment& stencil = attachment(GL_STENCIL_ATTACHMENT);
+
+  if((depthStencil.target != GL_NONE && (stencil.target != GL_NONE || depth.target != GL_NONE)) ||
+    (stencil.target != GL_NONE && depth.target != GL_NONE)) {
+    return GL_FRAMEBUFFER_UNSUPPORTED;
+  }
+
+  bool hasColor = false;
+  for(const auto& it : info.attachments) {
+    if(isColorAttachment(it.first) && it.second.target != GL_NONE) {
+      hasColor = true;
+    }
+  }
+  if(!hasColor) {
+    return GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT;
+  }
+
+  std::vector<std::pair<GLsizei, GLsizei>> sizes;
+
+  //Depth and stencil can only be renderbuffers of their exact format
+  static const GLenum DEPTH_STENCIL_POINTS[] = { 0x821A, GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT };
+  static const GLenum DEPTH_STENCIL_FORMATS[] = { GL_DEPTH_STENCIL_OES, GL_DEPTH_COMPONENT16, GL_STENCIL_INDEX8 };
+  for(size_t i = 0; i < 3; ++i) {
+    const WebGLAttachment& current = attachment(DEPTH_STENCIL_POINTS[i]);
+    if(current.target == GL_TEXTURE) {
+      return GL_FRAMEBUFFER_UNSUPPORTED;
+    } else if(current.target == GL_RENDERBUFFER) {
+      const WebGLRenderbufferInfo& renderbuffer = this->renderbufferInfo[current.object];
+      if(renderbuffer.format != DEPTH_STENCIL_FORMATS[i]) {
+        return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
+      }
+      sizes.emplace_back(renderbuffer.width, renderbuffer.height);
+    }
+  }
+
+  //Every color texture is measured at the level of the first attachment
+  const GLint level = attachment(GL_COLOR_ATTACHMENT0).level;
+  for(const auto& it : info.attachments) {
+    if(!isColorAttachment(it.first)) {
+      continue;
+    }
+    const WebGLAttachment& current = it.second;
+    if(current.target == GL_TEXTURE) {
+      const WebGLTextureInfo& texture = this->textureInfo[current.object];
+      if(texture.format != GL_RGBA ||
+        !(texture.type == GL_UNSIGNED_BYTE || texture.type == GL_FLOAT ||
+          (texture.type == GL_HALF_FLOAT_OES && this->colorBufferHalfFloat))) {
+        return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
+      }
+      auto size = texture.levels.find(level);
+      sizes.push_back(size != texture.levels.end() ? size->second : std::pair<GLsizei, GLsizei>(0, 0));
+    } else if(current.target == GL_RENDERBUFFER) {
+      const WebGLRenderbufferInfo& renderbuffer = this->renderbufferInfo[current.object];
+      if(renderbuffer.format != GL_RGBA4 &&
+        renderbuffer.format != GL_RGB565 &&
+        renderbuffer.format != GL_RGB5_A1 &&
+        !((renderbuffer.format == GL_RGBA16F_EXT || renderbuffer.format == GL_RGB16F_EXT) && this->colorBufferHalfFloat)) {
+        return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
+      }
+      sizes.emplace_back(renderbuffer.width, renderbuffer.height);
+    }
+  }
+
+  if(sizes.empty()) {
+    return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
+  }
+  for(size_t i = 1; i < sizes.size(); ++i) {
+    if(sizes[i] != sizes[0]) {
+      return GL_FRAMEBUFFER_INCOMPLETE_DIMENSIONS;
+    }
+  }
+  if(sizes[0].first == 0 || sizes[0].second == 0) {
+    return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
+  }
+
+  info.width = sizes[0].first;
+  info.height = sizes[0].second;
+  return GL_FRAMEBUFFER_COMPLETE;
+}
+
+//The drawing buffer is always complete, like the default framebuffer
+bool WebGLRenderingContext::framebufferOk() {
+  if(this->framebufferBinding != 0 &&
+    this->framebufferBinding != this->drawingBuffer &&
+    this->framebufferStatus(this->framebufferBinding) != GL_FRAMEBUFFER_COMPLETE) {
+    this->setError(GL_INVALID_FRAMEBUFFER_OPERATION);
+    return false;
+  }
+  return true;
+}
+
+static inline GLint attribTypeSize(GLenum type) {
+  switch(type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+      return 1;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+      return 2;
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT:
+      return 4;
+  }
+  return 0;
+}
+
+//Checks that every array the program reads has the vertices (up to maxIndex)
+//and instances (primCount) of the draw. Instanced draws only check the arrays
+//of active attributes and need at least one array without a divisor
+bool WebGLRenderingContext::vertexAttribsValid(int64_t maxIndex, GLsizei primCount, bool instanced) {
+  if(this->activeProgram == 0) {
+    this->setError(GL_INVALID_OPERATION);
+    return false;
+  }
+  const std::vector<GLint>& active = this->programAttributes[this->activeProgram];
+
+  bool hasZero = false;
+  auto it = this->vertexAttribs.lower_bound(std::make_pair(this->activeVertexArray, 0u));
+  for(; it != this->vertexAttribs.end() && it->first.first == this->activeVertexArray; ++it) {
+    const WebGLVertexAttribState& attrib = it->second;
+    if(!attrib.enabled) {
+      continue;
+    }
+    const bool used = std::find(active.begin(), active.end(), static_cast<GLint>(it->first.second)) != active.end();
+    if(attrib.buffer == 0 && (used || !instanced)) {
+      this->setError(GL_INVALID_OPERATION);
+      return false;
+    }
+    if(!used) {
+      continue;
+    }
+
+    int64_t last = 0;
+    if(attrib.divisor == 0) {
+      hasZero = true;
+      last = maxIndex;
+    } else {
+      last = (static_cast<int64_t>(primCount) + attrib.divisor - 1) / attrib.divisor - 1;
+    }
+    const int64_t elementSize = static_cast<int64_t>(attrib.size) * attribTypeSize(attrib.type);
+    const int64_t stride = attrib.stride ? attrib.stride : elementSize;
+    const int64_t maxByte = stride * last + elementSize + attrib.offset;
+    auto size = this->bufferSizes.find(attrib.buffer);
+    if(!this->robustAccess && maxByte > (size != this->bufferSizes.end() ? size->second : 0)) {
+      this->setError(GL_INVALID_OPERATION);
+      return false;
+    }
+  }
+
+  if(instanced && !hasZero) {
+    this->setError(GL_INVALID_OPERATION);
+    return false;
+  }
+  return true;
+}
+
+//Vertices drawn for a primitive mode, -1 for unknown modes
+static inline GLsizei vertexCount(GLenum mode, GLsizei count) {
+  switch(mode) {
+    case GL_TRIANGLES:
+      return count - (count % 3);
+    case GL_LINES:
+      return count - (count % 2);
+    case GL_LINE_LOOP:
+    case GL_POINTS:
+      return count;
+    case GL_TRIANGLE_FAN:
+    case GL_LINE_STRIP:
+      return count < 2 ? 0 : count;
+    case GL_TRIANGLE_STRIP:
+      return count < 3 ? 0 : count;
+  }
+  return -1;
+}
+
+//Returns the vertex count to draw, -1 when nothing is drawn
+GLsizei WebGLRenderingContext::validateDrawArrays(GLenum mode, GLint first, GLint count, GLsizei primCount, bool instanced) {
+  if(first < 0 || count < 0 || primCount < 0) {
+    this->setError(GL_INVALID_VALUE);
+    return -1;
+  }
+  if(!this->StencilStateValid()) {
+    this->setError(GL_INVALID_OPERATION);
+    return -1;
+  }
+  const GLsizei reducedCount = vertexCount(mode, count);
+  if(reducedCount < 0) {
+    this->setError(GL_INVALID_ENUM);
+    return -1;
+  }
+  if(!this->framebufferOk()) {
+    return -1;
+  }
+  if(count == 0 || primCount == 0) {
+    return -1;
+  }
+
+  const int64_t maxIndex = static_cast<int64_t>(first) + count - 1;
+  if(!this->vertexAttribsValid(maxIndex, primCount, instanced)) {
+    return -1;
+  }
+  return reducedCount;
+}
+
+//Returns the index count to draw, -1 when nothing is drawn
+GLsizei WebGLRenderingContext::validateDrawElements(GLenum mode, GLint count, GLenum type, GLint offset, GLsizei primCount, bool instanced) {
+  if(count < 0 || offset < 0 || primCount < 0) {
+    this->setError(GL_INVALID_VALUE);
+    return -1;
+  }
+  if(!this->StencilStateValid()) {
+    this->setError(GL_INVALID_OPERATION);
+    return -1;
+  }
+  if(this->elementArrayBufferBinding == 0) {
+    this->setError(GL_INVALID_OPERATION);
+    return -1;
+  }
+
+  //Element type and alignment
+  GLint elementSize = 1;
+  if(type == GL_UNSIGNED_SHORT) {
+    elementSize = 2;
+  } else if(type == GL_UNSIGNED_INT && this->elementIndexUint) {
+    elementSize = 4;
+  } else if(type != GL_UNSIGNED_BYTE) {
+    this->setError(GL_INVALID_ENUM);
+    return -1;
+  }
+  if(offset % elementSize) {
+    this->setError(GL_INVALID_OPERATION);
+    return -1;
+  }
+
+  GLsizei reducedCount = count;
+  switch(mode) {
+    case GL_TRIANGLES:
+      reducedCount -= count % 3;
+    break;
+    case GL_LINES:
+      reducedCount -= count % 2;
+    break;
+    case GL_POINTS:
+    break;
+    case GL_LINE_LOOP:
+    case GL_LINE_STRIP:
+      if(count < 2) {
+        this->setError(GL_INVALID_OPERATION);
+        return -1;
+      }
+    break;
+    case GL_TRIANGLE_FAN:
+    case GL_TRIANGLE_STRIP:
+      if(count < 3) {
+        this->setError(GL_INVALID_OPERATION);
+        return -1;
+      }
+    break;
+    default:
+      this->setError(GL_INVALID_ENUM);
+      return -1;
+  }
+
+  if(!this->framebufferOk()) {
+    return -1;
+  }
+
+  //Empty draws still report the vertex array errors
+  const GLsizei emptyPrimCount = instanced ? 0 : primCount;
+  if(count == 0 || primCount == 0) {
+    this->vertexAttribsValid(0, emptyPrimCount, instanced);
+    return -1;
+  }
+
+  //Robust contexts already handle out-of-range indices, skip the scan
+  int64_t maxIndex = 0;
+  if(!this->robustAccess) {
+    auto size = this->bufferSizes.find(this->elementArrayBufferBinding);
+    const int64_t end = static_cast<int64_t>(count) * elementSize + offset;
+    if(end > (size != this->bufferSizes.end() ? size->second : 0)) {
+      this->setError(GL_INVALID_OPERATION);
+      return -1;
+    }
+    maxIndex = this->GetMaxIndex(this->elementArrayBufferBinding, type, offset, count);
+  }
+  if(maxIndex < 0) {
+    this->vertexAttribsValid(0, emptyPrimCount, instanced);
+    return -1;
+  }
+
+  if(!this->vertexAttribsValid(maxIndex, primCount, instanced)) {
+    return -1;
+  }
+  return reducedCount;
+}
+
+//Attribute 0 must be an array on desktop GL. When it isn't, its generic
+//value is drawn from a one element array advanced once per instance
+bool WebGLRenderingContext::beginAttrib0() {
+  if(this->vertexAttrib(0).enabled || this->drawBuffers) {
+    return false;
+  }
+  if(this->attrib0Buffer == 0) {
+    (this->glGenBuffers)(1, &this->attrib0Buffer);
+    this->registerGLObj(GLOBJECT_TYPE_BUFFER, this->attrib0Buffer);
+  }
+  (this->glBindBuffer)(GL_ARRAY_BUFFER, this->attrib0Buffer);
+  (this->glBufferData)(GL_ARRAY_BUFFER, sizeof(this->attrib0Value), this->attrib0Value, GL_STREAM_DRAW);
+  (this->glEnableVertexAttribArray)(0);
+  (this->glVertexAttribPointer)(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
+#if !defined(__vita__)
+  (this->glVertexAttribDivisor)(0, 1);
+#endif
+  return true;
+}
+
+void WebGLRenderingContext::endAttrib0() {
+  const WebGLVertexAttribState& attrib = this->vertexAttrib(0);
+  (this->glBindBuffer)(GL_ARRAY_BUFFER, attrib.buffer);
+  (this->glVertexAttribPointer)(
+    0,
+    attrib.size,
+    attrib.type,
+    attrib.normalized,
+    attrib.stride,
+    reinterpret_cast<GLvoid*>(attrib.offset));
+#if !defined(__vita__)
+  (this->glVertexAttribDivisor)(0, attrib.divisor);
+#endif
+  (this->glDisableVertexAttribArray)(0);
+  (this->glBindBuffer)(GL_ARRAY_BUFFER, this->stateShadow[GL_ARRAY_BUFFER_BINDING][0]);
+}
+
+//Minimum number of argument words for every WebGLCommandOp
+static const uint8_t COMMAND_ARITY[WEBGL_COMMAND_COUNT] = {
+  0, //unused
+  1, //ACTIVE_TEXTURE
+  2, //BIND_BUFFER
+  2, //BIND_FRAMEBUFFER
+  2, //BIND_RENDERBUFFER
+  2, //BIND_TEXTURE
+  1, //BIND_VERTEX_ARRAY
+  4, //BLEND_COLOR
+  1, //BLEND_EQUATION
+  2, //BLEND_EQUATION_SEPARATE
+  2, //BLEND_FUNC
+  4, //BLEND_FUNC_SEPARATE
+  1, //CLEAR
+  4, //CLEAR_COLOR
+  1, //CLEAR_DEPTH
+  1, //CLEAR_STENCIL
+  4, //COLOR_MASK
+  1, //CULL_FACE
+  1, //DEPTH_FUNC
+  1, //DEPTH_MASK
+  2, //DEPTH_RANGE
+  1, //DISABLE
+  1, //DISABLE_VERTEX_ATTRIB_ARRAY
+  3, //DRAW_ARRAYS
+  4, //DRAW_ARRAYS_INSTANCED
+  4, //DRAW_ELEMENTS
+  5, //DRAW_ELEMENTS_INSTANCED
+  1, //ENABLE
+  1, //ENABLE_VERTEX_ATTRIB_ARRAY
+  1, //FRONT_FACE
+  1, //LINE_WIDTH
+  2, //POLYGON_OFFSET
+  4, //SCISSOR
+  3, //STENCIL_FUNC
+  4, //STENCIL_FUNC_SEPARATE
+  1, //STENCIL_MASK
+  2, //STENCIL_MASK_SEPARATE
+  3, //STENCIL_OP
+  4, //STENCIL_OP_SEPARATE
+  2, //UNIFORM_1F
+  3, //UNIFORM_2F
+  4, //UNIFORM_3F
+  5, //UNIFORM_4F
+  2, //UNIFORM_1I
+  3, //UNIFORM_2I
+  4, //UNIFORM_3I
+  5, //UNIFORM_4I
+  2, //UNIFORM_MATRIX_2FV
+  2, //UNIFORM_MATRIX_3FV
+  2, //UNIFORM_MATRIX_4FV
+  1, //USE_PROGRAM
+  2, //VERTEX_ATTRIB_1F
+  3, //VERTEX_ATTRIB_2F
+  4, //VERTEX_ATTRIB_3F
+  5, //VERTEX_ATTRIB_4F
+  2, //VERTEX_ATTRIB_DIVISOR
+  6, //VERTEX_ATTRIB_POINTER
+  4, //VIEWPORT
+};
+
+static inline GLfloat commandFloat(uint32_t word) {
+  GLfloat value;
+  memcpy(&value, &word, sizeof(value));
+  return value;
+}
+
+void WebGLRenderingContext::Submit(qjs::Uint32Array commands, GLuint length) {
+  const uint32_t* command = commands.data();
+  const uint32_t* end = command + std::min<size_t>(length, commands.size());
+
+  while(command < end) {
+    GLenum op = command[0] & 0xffff;
+    GLuint argc = command[0] >> 16;
+    const uint32_t* args = command + 1;
+
+    //Stop on truncated streams, the rest can't be trusted
+    if(argc > static_cast<size_t>(end - args)) {
+      this->setError(GL_INVALID_VALUE);
+      return;
+    }
+    command = args + argc;
+
+    if(op == 0 || op >= WEBGL_COMMAND_COUNT) {
+      this->setError(GL_INVALID_ENUM);
+      continue;
+    }
+    if(argc < COMMAND_ARITY[op]) {
+      this->setError(GL_INVALID_VALUE);
+      continue;
+    }
+
+    #define ARG_I(n) static_cast<GLint>(args[n])
+    #define ARG_U(n) static_cast<GLuint>(args[n])
+    #define ARG_F(n) commandFloat(args[n])
+
+    switch(op) {
+      case WEBGL_COMMAND_ACTIVE_TEXTURE:
+        this->ActiveTexture(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_BIND_BUFFER:
+        this->BindBuffer(ARG_U(0), ARG_U(1));
+      break;
+      case WEBGL_COMMAND_BIND_FRAMEBUFFER:
+        this->BindFramebuffer(ARG_I(0), ARG_I(1));
+      break;
+      case WEBGL_COMMAND_BIND_RENDERBUFFER:
+        this->BindRenderbuffer(ARG_U(0), ARG_U(1));
+      break;
+      case WEBGL_COMMAND_BIND_TEXTURE:
+        this->BindTexture(ARG_U(0), ARG_I(1));
+      break;
+      case WEBGL_COMMAND_BIND_VERTEX_ARRAY:
+        this->BindVertexArrayOES(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_BLEND_COLOR:
+        this->BlendColor(ARG_F(0), ARG_F(1), ARG_F(2), ARG_F(3));
+      break;
+      case WEBGL_COMMAND_BLEND_EQUATION:
+        this->BlendEquation(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_BLEND_EQUATION_SEPARATE:
+        this->BlendEquationSeparate(ARG_U(0), ARG_U(1));
+      break;
+      case WEBGL_COMMAND_BLEND_FUNC:
+        this->BlendFunc(ARG_U(0), ARG_U(1));
+      break;
+      case WEBGL_COMMAND_BLEND_FUNC_SEPARATE:
+        this->BlendFuncSeparate(ARG_U(0), ARG_U(1), ARG_U(2), ARG_U(3));
+      break;
+      case WEBGL_COMMAND_CLEAR:
+        this->Clear(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_CLEAR_COLOR:
+        this->ClearColor(ARG_F(0), ARG_F(1), ARG_F(2), ARG_F(3));
+      break;
+      case WEBGL_COMMAND_CLEAR_DEPTH:
+        this->ClearDepth(ARG_F(0));
+      break;
+      case WEBGL_COMMAND_CLEAR_STENCIL:
+        this->ClearStencil(ARG_I(0));
+      break;
+      case WEBGL_COMMAND_COLOR_MASK:
+        this->ColorMask(ARG_U(0) != 0, ARG_U(1) != 0, ARG_U(2) != 0, ARG_U(3) != 0);
+      break;
+      case WEBGL_COMMAND_CULL_FACE:
+        this->CullFace(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_DEPTH_FUNC:
+        this->DepthFunc(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_DEPTH_MASK:
+        this->DepthMask(ARG_U(0) != 0);
+      break;
+      case WEBGL_COMMAND_DEPTH_RANGE:
+        this->DepthRange(ARG_F(0), ARG_F(1));
+      break;
+      case WEBGL_COMMAND_DISABLE:
+        this->Disable(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_DISABLE_VERTEX_ATTRIB_ARRAY:
+        this->DisableVertexAttribArray(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_DRAW_ARRAYS:
+        this->DrawArrays(ARG_U(0), ARG_I(1), ARG_I(2));
+      break;
+      case WEBGL_COMMAND_DRAW_ARRAYS_INSTANCED:
+        this->DrawArraysInstanced(ARG_U(0), ARG_I(1), ARG_I(2), ARG_I(3));
+      break;
+      case WEBGL_COMMAND_DRAW_ELEMENTS:
+        this->DrawElements(ARG_U(0), ARG_I(1), ARG_U(2), ARG_I(3));
+      break;
+      case WEBGL_COMMAND_DRAW_ELEMENTS_INSTANCED:
+        this->DrawElementsInstanced(ARG_U(0), ARG_I(1), ARG_U(2), ARG_I(3), ARG_I(4));
+      break;
+      case WEBGL_COMMAND_ENABLE:
+        this->Enable(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_ENABLE_VERTEX_ATTRIB_ARRAY:
+        this->EnableVertexAttribArray(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_FRONT_FACE:
+        this->FrontFace(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_LINE_WIDTH:
+        this->LineWidth(ARG_F(0));
+      break;
+      case WEBGL_COMMAND_POLYGON_OFFSET:
+        this->PolygonOffset(ARG_F(0), ARG_F(1));
+      break;
+      case WEBGL_COMMAND_SCISSOR:
+        this->Scissor(ARG_I(0), ARG_I(1), ARG_I(2), ARG_I(3));
+      break;
+      case WEBGL_COMMAND_STENCIL_FUNC:
+        this->StencilFunc(ARG_U(0), ARG_I(1), ARG_U(2));
+      break;
+      case WEBGL_COMMAND_STENCIL_FUNC_SEPARATE:
+        this->StencilFuncSeparate(ARG_U(0), ARG_U(1), ARG_I(2), ARG_U(3));
+      break;
+      case WEBGL_COMMAND_STENCIL_MASK:
+        this->StencilMask(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_STENCIL_MASK_SEPARATE:
+        this->StencilMaskSeparate(ARG_U(0), ARG_U(1));
+      break;
+      case WEBGL_COMMAND_STENCIL_OP:
+        this->StencilOp(ARG_U(0), ARG_U(1), ARG_U(2));
+      break;
+      case WEBGL_COMMAND_STENCIL_OP_SEPARATE:
+        this->StencilOpSeparate(ARG_U(0), ARG_U(1), ARG_U(2), ARG_U(3));
+      break;
+      case WEBGL_COMMAND_UNIFORM_1F:
+        this->Uniform1f(ARG_I(0), ARG_F(1));
+      break;
+      case WEBGL_COMMAND_UNIFORM_2F:
+        this->Uniform2f(ARG_I(0), ARG_F(1), ARG_F(2));
+      break;
+      case WEBGL_COMMAND_UNIFORM_3F:
+        this->Uniform3f(ARG_I(0), ARG_F(1), ARG_F(2), ARG_F(3));
+      break;
+      case WEBGL_COMMAND_UNIFORM_4F:
+        this->Uniform4f(ARG_I(0), ARG_F(1), ARG_F(2), ARG_F(3), ARG_F(4));
+      break;
+      case WEBGL_COMMAND_UNIFORM_1I:
+        this->Uniform1i(ARG_I(0), ARG_I(1));
+      break;
+      case WEBGL_COMMAND_UNIFORM_2I:
+        this->Uniform2i(ARG_I(0), ARG_I(1), ARG_I(2));
+      break;
+      case WEBGL_COMMAND_UNIFORM_3I:
+        this->Uniform3i(ARG_I(0), ARG_I(1), ARG_I(2), ARG_I(3));
+      break;
+      case WEBGL_COMMAND_UNIFORM_4I:
+        this->Uniform4i(ARG_I(0), ARG_I(1), ARG_I(2), ARG_I(3), ARG_I(4));
+      break;
+      //Matrices are stored inline after (location, transpose)
+      case WEBGL_COMMAND_UNIFORM_MATRIX_2FV:
+        this->setUniform(WEBGL_UNIFORM_MATRIX_2FV, ARG_I(0), (argc - 2) / 4, ARG_U(1) != 0, args + 2);
+      break;
+      case WEBGL_COMMAND_UNIFORM_MATRIX_3FV:
+        this->setUniform(WEBGL_UNIFORM_MATRIX_3FV, ARG_I(0), (argc - 2) / 9, ARG_U(1) != 0, args + 2);
+      break;
+      case WEBGL_COMMAND_UNIFORM_MATRIX_4FV:
+        this->setUniform(WEBGL_UNIFORM_MATRIX_4FV, ARG_I(0), (argc - 2) / 16, ARG_U(1) != 0, args + 2);
+      break;
+      case WEBGL_COMMAND_USE_PROGRAM:
+        this->UseProgram(ARG_U(0));
+      break;
+      case WEBGL_COMMAND_VERTEX_ATTRIB_1F:
+        this->VertexAttrib1f(ARG_U(0), ARG_F(1));
+      break;
+      case WEBGL_COMMAND_VERTEX_ATTRIB_2F:
+        this->VertexAttrib2f(ARG_U(0), ARG_F(1), ARG_F(2));
+      break;
+      case WEBGL_COMMAND_VERTEX_ATTRIB_3F:
+        this->VertexAttrib3f(ARG_U(0), ARG_F(1), ARG_F(2), ARG_F(3));
+      break;
+      case WEBGL_COMMAND_VERTEX_ATTRIB_4F:
+        this->VertexAttrib4f(ARG_U(0), ARG_F(1), ARG_F(2), ARG_F(3), ARG_F(4));
+      break;
+      case WEBGL_COMMAND_VERTEX_ATTRIB_DIVISOR:
+        this->VertexAttribDivisor(ARG_U(0), ARG_U(1));
+      break;
+      case WEBGL_COMMAND_VERTEX_ATTRIB_POINTER:
+        this->VertexAttribPointer(ARG_I(0), ARG_I(1), ARG_U(2), ARG_U(3) != 0, ARG_I(4), ARG_U(5));
+      break;
+      case WEBGL_COMMAND_VIEWPORT:
+        this->Viewport(ARG_I(0), ARG_I(1), ARG_I(2), ARG_I(3));
+      break;
+      default:
+      break;
+    }
+
+    #undef ARG_I
+    #undef ARG_U
+    #undef ARG_F
+  }
+}
@@ -2,8 +2,11 @@
 #define WEBGL_H_
 
 #include <algorithm>
+#include <array>
+#include <deque>
 #include <vector>
 #include <map>
+#include <string>
 #include <utility>
 #include <memory>
 #include <variant>
@@ -20,6 +23,11 @@
 #include <GLES2/gl2ext.h>
 #endif
 
+#include "arena.h"
+#include "atlas.h"
+#include "decoder.h"
+#include "readback.h"
+
 enum GLObjectType {
   GLOBJECT_TYPE_BUFFER,
   GLOBJECT_TYPE_FRAMEBUFFER,
@@ -37,23 +45,109 @@ enum GLContextState {
   GLCONTEXT_STATE_ERROR
 };
 
+// How errors raised by the driver reach getError. SYNC asks glGetError after
+// every call that allocates storage, DEBUG only when a GL_KHR_debug callback
+// reported an error and DEFERRED once per frame, when the buffers are swapped.
+// In DEFERRED mode buffer sizes set during a frame that ran out of memory are
+// dropped on swap
+enum WebGLErrorMode {
+  WEBGL_ERRORS_SYNC,
+  WEBGL_ERRORS_DEBUG,
+  WEBGL_ERRORS_DEFERRED
+};
+
+// Opcodes understood by WebGLRenderingContext::Submit. Each command is a
+// header word (opcode | argument count << 16) followed by its arguments,
+// floats are stored bit-cast into the 32-bit words.
+// Keep in sync with quickjs/gl/webgl-command-buffer.js
+enum WebGLCommandOp {
+  WEBGL_COMMAND_ACTIVE_TEXTURE = 1,
+  WEBGL_COMMAND_BIND_BUFFER,
+  WEBGL_COMMAND_BIND_FRAMEBUFFER,
+  WEBGL_COMMAND_BIND_RENDERBUFFER,
+  WEBGL_COMMAND_BIND_TEXTURE,
+  WEBGL_COMMAND_BIND_VERTEX_ARRAY,
+  WEBGL_COMMAND_BLEND_COLOR,
+  WEBGL_COMMAND_BLEND_EQUATION,
+  WEBGL_COMMAND_BLEND_EQUATION_SEPARATE,
+  WEBGL_COMMAND_BLEND_FUNC,
+  WEBGL_COMMAND_BLEND_FUNC_SEPARATE,
+  WEBGL_COMMAND_CLEAR,
+  WEBGL_COMMAND_CLEAR_COLOR,
+  WEBGL_COMMAND_CLEAR_DEPTH,
+  WEBGL_COMMAND_CLEAR_STENCIL,
+  WEBGL_COMMAND_COLOR_MASK,
+  WEBGL_COMMAND_CULL_FACE,
+  WEBGL_COMMAND_DEPTH_FUNC,
+  WEBGL_COMMAND_DEPTH_MASK,
+  WEBGL_COMMAND_DEPTH_RANGE,
+  WEBGL_COMMAND_DISABLE,
+  WEBGL_COMMAND_DISABLE_VERTEX_ATTRIB_ARRAY,
+  WEBGL_COMMAND_DRAW_ARRAYS,
+  WEBGL_COMMAND_DRAW_ARRAYS_INSTANCED,
+  WEBGL_COMMAND_DRAW_ELEMENTS,
+  WEBGL_COMMAND_DRAW_ELEMENTS_INSTANCED,
+  WEBGL_COMMAND_ENABLE,
+  WEBGL_COMMAND_ENABLE_VERTEX_ATTRIB_ARRAY,
+  WEBGL_COMMAND_FRONT_FACE,
+  WEBGL_COMMAND_LINE_WIDTH,
+  WEBGL_COMMAND_POLYGON_OFFSET,
+  WEBGL_COMMAND_SCISSOR,
+  WEBGL_COMMAND_STENCIL_FUNC,
+  WEBGL_COMMAND_STENCIL_FUNC_SEPARATE,
+  WEBGL_COMMAND_STENCIL_MASK,
+  WEBGL_COMMAND_STENCIL_MASK_SEPARATE,
+  WEBGL_COMMAND_STENCIL_OP,
+  WEBGL_COMMAND_STENCIL_OP_SEPARATE,
+  WEBGL_COMMAND_UNIFORM_1F,
+  WEBGL_COMMAND_UNIFORM_2F,
+  WEBGL_COMMAND_UNIFORM_3F,
+  WEBGL_COMMAND_UNIFORM_4F,
+  WEBGL_COMMAND_UNIFORM_1I,
+  WEBGL_COMMAND_UNIFORM_2I,
+  WEBGL_COMMAND_UNIFORM_3I,
+  WEBGL_COMMAND_UNIFORM_4I,
+  WEBGL_COMMAND_UNIFORM_MATRIX_2FV,
+  WEBGL_COMMAND_UNIFORM_MATRIX_3FV,
+  WEBGL_COMMAND_UNIFORM_MATRIX_4FV,
+  WEBGL_COMMAND_USE_PROGRAM,
+  WEBGL_COMMAND_VERTEX_ATTRIB_1F,
+  WEBGL_COMMAND_VERTEX_ATTRIB_2F,
+  WEBGL_COMMAND_VERTEX_ATTRIB_3F,
+  WEBGL_COMMAND_VERTEX_ATTRIB_4F,
+  WEBGL_COMMAND_VERTEX_ATTRIB_DIVISOR,
+  WEBGL_COMMAND_VERTEX_ATTRIB_POINTER,
+  WEBGL_COMMAND_VIEWPORT,
+  WEBGL_COMMAND_COUNT
+};
+
 // QuickJS uses up to signed 64-bit integers so we downcast to 32-bit 
 // in those cases (may cause bugs in 64-bit architectures
 using qjs_size_t = std::conditional<std::is_same_v<size_t, uint64_t>, uint32_t, size_t>::type;
 
+//Values returned to JS from the scratch arena. The bindings release them from
+//the arena once they are copied, otherwise they live until the next swap()
+template <typename T>
+struct WebGLScratchArray {
+  const T*     values = nullptr;
+  size_t       length = 0;
+  ScratchArena* arena = nullptr;
+  ScratchArena::Mark mark;
+};
+
 using WebGLParameter = std::variant<
   GLboolean,
   GLint,
   GLfloat,
   const char*,
-  std::vector<GLfloat>,
-  std::vector<GLint>,
-  std::vector<GLboolean>
+  WebGLScratchArray<GLfloat>,
+  WebGLScratchArray<GLint>,
+  WebGLScratchArray<GLboolean>
 >;
 
 using WebGLAttrib = std::variant<
   GLint,
-  std::vector<float>
+  WebGLScratchArray<GLfloat>
 >;
 
 using WebGLTexParameter = std::optional<std::variant<
@@ -61,24 +155,26 @@ using WebGLTexParameter = std::optional<std::variant<
   GLint
 >>;
 
-using WebGLBufferDataInternal = std::variant<
-  qjs::ArrayBuffer,
-  qjs::Int8Array,
-  qjs::Int16Array,
-  qjs::Int32Array,
-  qjs::Uint8Array,
-  qjs::Uint16Array,
-  qjs::Uint32Array,
-  qjs::Float32Array,
-  qjs::Float64Array,
-  qjs::BigInt64Array,
-  qjs::BigUint64Array,
-  GLsizeiptr
->;
+//Bytes of an ArrayBuffer or any ArrayBufferView, borrowed from the JS object
+//for the duration of the call
+struct WebGLArrayView {
+  uint8_t* bytes  = nullptr;
+  size_t   length = 0;
+
+  uint8_t* data() const { return bytes; }
+  size_t size() const { return length; }
+  bool empty() const { return length == 0; }
+};
+
+//Source of bufferData, bytes is NULL when only a size was given
+struct WebGLBufferSource {
+  const uint8_t* bytes = nullptr;
+  GLsizeiptr     size  = 0;
+};
 
-using WebGLBufferData = std::optional<WebGLBufferDataInternal>;
+using WebGLBufferData = std::optional<WebGLBufferSource>;
 
-using WebGLByteArray = std::optional<qjs::Uint8Array>;
+using WebGLByteArray = std::optional<WebGLArrayView>;
 
 using GLObjectReference = std::pair<GLuint, GLObjectType>;
 
@@ -102,6 +198,202 @@ struct WebGLShaderPrecisionFormatContent {
 
 using WebGLShaderPrecisionFormat = std::optional<WebGLShaderPrecisionFormatContent>;
 
+//Cached result of an index scan for drawElements
+struct WebGLIndexRange {
+  GLenum     type;
+  qjs_size_t offset;
+  GLsizei    count;
+  int64_t    maxIndex;
+};
+
+//Entry point a cached uniform value is sent with
+enum WebGLUniformKind {
+  WEBGL_UNIFORM_1F,
+  WEBGL_UNIFORM_2F,
+  WEBGL_UNIFORM_3F,
+  WEBGL_UNIFORM_4F,
+  WEBGL_UNIFORM_1I,
+  WEBGL_UNIFORM_2I,
+  WEBGL_UNIFORM_3I,
+  WEBGL_UNIFORM_4I,
+  WEBGL_UNIFORM_MATRIX_2FV,
+  WEBGL_UNIFORM_MATRIX_3FV,
+  WEBGL_UNIFORM_MATRIX_4FV
+};
+
+//Last value set on a uniform location, raw 32-bit words of a single element
+struct WebGLUniformValue {
+  WebGLUniformKind kind = WEBGL_UNIFORM_1F;
+  GLboolean transpose   = GL_FALSE;
+  bool      dirty       = false;
+  uint8_t   length      = 0;
+  uint32_t  words[16];
+};
+
+//Vertex attribute of a vertex array object, as set through this context
+struct WebGLVertexAttribState {
+  bool       enabled    = false;
+  bool       pointer    = false;
+  GLuint     buffer     = 0;
+  GLint      size       = 4;
+  GLenum     type       = GL_FLOAT;
+  GLboolean  normalized = GL_FALSE;
+  GLsizei    stride     = 0;
+  qjs_size_t offset     = 0;
+  GLuint     divisor    = 0;
+};
+
+//Format of the last image specified for a texture and the size of each level.
+//Bytes are kept per image, cube map faces have one each
+struct WebGLTextureInfo {
+  GLenum format = 0;
+  GLenum type   = 0;
+  std::map<GLint, std::pair<GLsizei, GLsizei>> levels;
+  std::map<std::pair<GLenum, GLint>, size_t> imageBytes;
+  size_t bytes  = 0;
+};
+
+//Image of a texture under residency management, what texImage2D specified it
+//with. Pixels are kept unpacked at the given row alignment when the texture
+//keeps its pixels, lost once the image was changed in a way they can't follow
+struct WebGLResidentImage {
+  GLenum  internalformat = GL_RGBA;
+  GLenum  format         = GL_RGBA;
+  GLenum  type           = GL_UNSIGNED_BYTE;
+  GLsizei width          = 0;
+  GLsizei height         = 0;
+  GLint   alignment      = 4;
+  bool    zero           = true;
+  bool    lost           = false;
+  std::vector<uint8_t> pixels;
+};
+
+//Texture opted into the residency manager. Its images are released when it is
+//evicted and specified again when it is bound next, from the pixels kept or
+//by JS when it reloads them itself
+struct WebGLResidentTexture {
+  std::map<std::pair<GLenum, GLint>, WebGLResidentImage> images;
+  GLenum   bindTarget = 0;
+  bool     keepPixels = true;
+  bool     resident   = true;
+  bool     mipmaps    = false;
+  uint64_t lastUse    = 0;
+};
+
+//Kinds of storage getMemoryStats reports. The drawing buffer covers the EGL
+//surface and the texture and renderbuffer of an offscreen drawing buffer
+enum WebGLMemoryType {
+  WEBGL_MEMORY_TEXTURE,
+  WEBGL_MEMORY_RENDERBUFFER,
+  WEBGL_MEMORY_BUFFER,
+  WEBGL_MEMORY_DRAWING_BUFFER,
+  WEBGL_MEMORY_TYPES
+};
+
+//Page of an atlas, a texture of the atlas size allocated from JS and the
+//packer placing regions in it. The texture is 0 once deleted
+struct WebGLAtlasPage {
+  GLuint texture;
+  WebGLAtlasPacker packer;
+};
+
+//Atlas made by createAtlas. Regions are padded on every side with copies of
+//their edge texels, and rounded to 4 texels when the pages are mipmapped so
+//that the first levels don't mix neighbours either
+struct WebGLAtlas {
+  GLsizei width   = 0;
+  GLsizei height  = 0;
+  GLint   padding = 0;
+  GLenum  format  = GL_RGBA;
+  bool    mipmaps = false;
+  std::vector<WebGLAtlasPage> pages;
+};
+
+//Renderbuffer storage, the format is the WebGL one before any mapping
+struct WebGLRenderbufferInfo {
+  GLenum  format = 0;
+  GLsizei width  = 0;
+  GLsizei height = 0;
+
+  //Depth is stored on 32 bits when the driver has 24 or 32 bit depth
+  size_t bytes() const {
+    switch(format) {
+      case GL_STENCIL_INDEX8:
+        return size_t(width) * height;
+      case GL_RGBA4:
+      case GL_RGB565:
+      case GL_RGB5_A1:
+      case GL_DEPTH_COMPONENT16:
+        return size_t(width) * height * 2;
+      case GL_RGB16F_EXT:
+        return size_t(width) * height * 6;
+      case GL_RGBA16F_EXT:
+        return size_t(width) * height * 8;
+      default:
+        return size_t(width) * height * 4;
+    }
+  }
+};
+
+//Object attached to a framebuffer attachment point, target is GL_TEXTURE,
+//GL_RENDERBUFFER or GL_NONE
+struct WebGLAttachment {
+  GLenum target = GL_NONE;
+  GLuint object = 0;
+  GLint  level  = 0;
+};
+
+//Attachments of a framebuffer and its size when it was last found complete
+struct WebGLFramebufferInfo {
+  std::map<GLenum, WebGLAttachment> attachments;
+  GLsizei width  = 0;
+  GLsizei height = 0;
+};
+
+//Value of a numeric getParameter query, raw 32-bit words
+struct WebGLParameterValue {
+  GLenum   type     = GL_INT;
+  uint8_t  length   = 1;
+  uint32_t words[4] = { 0, 0, 0, 0 };
+};
+
+//Typed arrays getParameterInto can write to
+using WebGLParameterTarget = std::variant<
+  qjs::Float32Array,
+  qjs::Int32Array,
+  qjs::Uint8Array
+>;
+
+//Pixel storage state uploads are unpacked with
+struct WebGLUnpackState {
+  GLint alignment   = 4;
+  bool  flipY       = false;
+  bool  premultiply = false;
+
+  size_t stride(size_t rowSize) const {
+    return alignment > 1 ? (rowSize + alignment - 1) / alignment * alignment : rowSize;
+  }
+};
+
+//Upload queued by enqueueTexImage2D or enqueueBufferData. Storage is allocated
+//when it is queued, the data is then sent in strips of rows to a texture level
+//or in chunks to a buffer, sent counts the rows or bytes already sent
+struct WebGLUpload {
+  GLuint  id      = 0;
+  bool    texture = false;
+  GLenum  target  = 0;
+  GLuint  object  = 0;
+  GLint   level   = 0;
+  GLenum  format  = 0;
+  GLenum  type    = 0;
+  GLsizei width   = 0;
+  GLsizei height  = 0;
+  size_t  rowSize = 0;
+  WebGLUnpackState unpack;
+  std::vector<uint8_t> data;
+  size_t  sent    = 0;
+};
+
 // WebGL Extensions (defined in bindings)
 struct WebGLDrawBuffersExtension {};
 
@@ -126,6 +418,8 @@ struct WebGLRenderingContext {
   static const GLenum VERSION = 0x1F02;
   static const GLenum IMPLEMENTATION_COLOR_READ_TYPE = 0x8B9A;
   static const GLenum IMPLEMENTATION_COLOR_READ_FORMAT = 0x8B9B;
+  static const EGLint CONTEXT_OPENGL_ROBUST_ACCESS_EXT = 0x30BF;
+  static const GLenum CONTEXT_ROBUST_ACCESS_EXT = 0x90F3;
 
   EGLContext context;
   EGLConfig  config;
@@ -137,6 +431,8 @@ struct WebGLRenderingContext {
   bool  unpack_premultiply_alpha;
   GLint unpack_colorspace_conversion;
   GLint unpack_alignment;
+  GLint pack_alignment;
+  bool  pack_flip_y;
 
   //A list of object references, need do destroy them at program exit
   std::map< std::pair<GLuint, GLObjectType>, bool > objects;
@@ -147,6 +443,101 @@ struct WebGLRenderingContext {
     objects.erase(std::make_pair(obj, type));
   }
 
+  //Set when a robust context was requested and the driver guarantees safe
+  //out-of-range buffer accesses, element shadows are not kept in that case
+  bool robustAccess;
+
+  //Element array bindings (per vertex array object), the CPU copy of every
+  //element buffer needed to validate drawElements and the index ranges
+  //already scanned for each of them, dropped when its data changes
+  static const size_t MAX_INDEX_RANGES = 16;
+  GLuint activeVertexArray;
+  GLuint elementArrayBufferBinding;
+  std::map<GLuint, GLuint> vertexArrayElementBindings;
+  std::map<GLuint, std::vector<uint8_t>> elementShadows;
+  std::map<GLuint, std::vector<WebGLIndexRange>> indexRanges;
+  void invalidateIndexRanges(GLuint buffer) {
+    indexRanges.erase(buffer);
+  }
+
+  //Uniform values last set on each program. Sets matching the cached value
+  //are dropped, the others are sent to GL right before the next draw
+  GLuint activeProgram;
+  std::map<GLuint, std::map<GLint, WebGLUniformValue>> uniformValues;
+  std::vector<GLint> dirtyUniforms;
+  uint64_t uniformCallsIssued;
+  uint64_t uniformCallsSkipped;
+  void setUniform(WebGLUniformKind kind, GLint location, GLsizei count, GLboolean transpose, const void* data);
+  void issueUniform(WebGLUniformKind kind, GLint location, GLsizei count, GLboolean transpose, const void* data);
+  void flushUniforms();
+
+  //Shadow of the GL state set through this context, calls that would leave it
+  //unchanged are dropped. It starts with the initial GL values of the state
+  //getParameter answers from it, state that was never set is not filtered
+  std::map<GLenum, std::array<GLuint, 4>> stateShadow;
+  std::map<std::pair<GLenum, GLenum>, GLuint> textureBindings;
+  std::map<std::pair<GLuint, GLuint>, WebGLVertexAttribState> vertexAttribs;
+  bool stateChanged(GLenum pname, GLuint a, GLuint b = 0, GLuint c = 0, GLuint d = 0);
+  bool isBlendEquation(GLenum mode) const;
+  void initStateShadow();
+
+  //State drawArrays and drawElements are validated against. Framebuffer
+  //attachments are the WebGL ones, GL only has them while they are complete.
+  //Attribute 0 is emulated with a constant buffer when it has no array
+  GLuint framebufferBinding;
+  GLuint drawingBuffer;
+  GLsizei drawingBufferWidth;
+  GLsizei drawingBufferHeight;
+  GLuint renderbufferBinding;
+  bool   elementIndexUint;
+  bool   drawBuffers;
+  bool   blendMinmax;
+  bool   colorBufferHalfFloat;
+  GLuint attrib0Buffer;
+  GLfloat attrib0Value[4];
+  std::map<GLuint, GLsizeiptr> bufferSizes;
+  //Buffers sized since deferred errors were last collected
+  std::vector<GLuint> pendingBufferSizes;
+  std::map<GLuint, std::vector<GLint>> programAttributes;
+  std::map<GLuint, WebGLTextureInfo> textureInfo;
+  std::map<GLuint, WebGLRenderbufferInfo> renderbufferInfo;
+  std::map<GLuint, WebGLFramebufferInfo> framebufferInfo;
+  bool storageSucceeded();
+  void textureSpecified(GLenum target, GLint level, GLenum format, GLenum type, GLsizei width, GLsizei height);
+  void textureSpecified(GLenum target, GLint level, GLenum format, GLenum type, GLsizei width, GLsizei height, size_t bytes);
+  void mipmapsGenerated(GLuint texture, GLenum bindTarget);
+  WebGLVertexAttribState& vertexAttrib(GLuint index);
+  GLenum framebufferStatus(GLuint framebuffer);
+  bool framebufferOk();
+  bool vertexAttribsValid(int64_t maxIndex, GLsizei primCount, bool instanced);
+  GLsizei validateDrawArrays(GLenum mode, GLint first, GLint count, GLsizei primCount, bool instanced);
+  GLsizei validateDrawElements(GLenum mode, GLint count, GLenum type, GLint offset, GLsizei primCount, bool instanced);
+  bool beginAttrib0();
+  void endAttrib0();
+
+  //Bytes of driver memory held by the storage allocated through the context,
+  //kept up to date as it is specified and deleted. Crossing the budget upwards
+  //is remembered until JS takes it, 0 means no budget
+  std::array<size_t, WEBGL_MEMORY_TYPES> memoryBytes;
+  size_t surfaceBytes;
+  bool   windowSurface;
+  double memoryBudget;
+  bool   overMemoryBudget;
+  bool   memoryBudgetCrossed;
+  GLuint drawingBufferTexture;
+  GLuint drawingBufferRenderbuffer;
+  void memoryChanged(WebGLMemoryType type, size_t previous, size_t current);
+  void textureStored(GLuint texture, GLenum target, GLint level, size_t bytes);
+  void measureSurface();
+  size_t memoryTotal() const;
+
+  //Implementation limits, queried once when the context is created
+  std::map<GLenum, WebGLParameterValue> limits;
+  void initLimits(const char* extensionString);
+
+  //Numeric parameter from the limits, the state shadow or the driver
+  WebGLParameterValue parameterValue(GLenum pname);
+
   //Context list
   WebGLRenderingContext *next, *prev;
   static WebGLRenderingContext* CONTEXT_LIST_HEAD;
@@ -183,6 +574,7 @@ struct WebGLRenderingContext {
     bool preserveDrawingBuffer,
     bool preferLowPowerToHighPerformance,
     bool failIfMajorPerformanceCaveat,
+    bool robustAccess,
     std::optional<intptr_t> uWindow,
     qjs::Value platformOptions);
     
@@ -196,20 +588,113 @@ struct WebGLRenderingContext {
   static WebGLRenderingContext* ACTIVE;
   bool setActive();
 
-  //Unpacks a buffer full of pixels into memory
+  //Scratch memory for the native calls, reset every frame
+  static const size_t SCRATCH_ARENA_SIZE = 4 << 20;
+  ScratchArena scratch;
+  template <typename T>
+  WebGLScratchArray<T> scratchArray(const T* values, size_t length) {
+    const ScratchArena::Mark mark = scratch.mark();
+    T* copy = scratch.allocate<T>(length);
+    std::copy(values, values + length, copy);
+    return WebGLScratchArray<T>{ copy, length, &scratch, mark };
+  }
+
+  //Unpacks a buffer full of pixels into scratch memory, with the current pixel
+  //storage state unless another one is given
+  WebGLUnpackState unpackState() const;
   unsigned char* unpackPixels(
     GLenum type,
     GLenum format,
     GLint width,
     GLint height,
     unsigned char* pixels);
-
-  //Error handling
-  GLenum lastError;
+  unsigned char* unpackPixels(
+    const WebGLUnpackState& unpack,
+    GLenum type,
+    GLenum format,
+    GLint width,
+    GLint height,
+    const unsigned char* pixels);
+  //Converts Float32Array pixels to half floats laid out for the unpack state
+  unsigned char* halfFloatPixels(GLenum format, GLsizei width, GLsizei height, const unsigned char* pixels);
+
+  //Uploads queued by enqueueTexImage2D and enqueueBufferData, drained by
+  //processUploads and swap until the budget (microseconds) is used. Ids of the
+  //finished ones are kept for JS, negated when their object was deleted first
+  static const GLint DEFAULT_UPLOAD_BUDGET = 2000;
+  static const size_t UPLOAD_CHUNK_SIZE = 256 << 10;
+  GLint uploadBudget;
+  GLuint nextUpload;
+  std::deque<WebGLUpload> uploads;
+  std::vector<GLint> finishedUploads;
+  bool sendUpload(WebGLUpload& upload);
+  void cancelUploads(bool texture, GLuint object, GLenum target = 0, GLint level = -1);
+  void flushUploads(bool texture, GLuint object, GLenum target = 0, GLint level = -1);
+  void flushFramebufferUploads();
+
+  //readPixels rectangle clipped to the framebuffer, and the copy of the
+  //visible pixels read as RGBA into the rows asked for
+  WebGLReadRegion readRegion(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type);
+  void packPixels(const WebGLReadRegion& region, const uint8_t* visible, uint8_t* out);
+
+  //Reads started by readPixelsAsync. They go into a pixel pack buffer when the
+  //driver is GLES3 or through a helper thread owning a shared context, and are
+  //followed by a fence the results wait on instead of stalling the pipeline
+  bool fenceSync;
+  bool pixelPackBuffer;
+  GLuint nextReadback;
+  std::map<GLuint, std::shared_ptr<WebGLReadback>> readbacks;
+#if !defined(__vita__)
+  std::unique_ptr<WebGLReadbackWorker> readbackWorker;
+#endif
+  void releaseReadback(WebGLReadback& readback);
+
+  //Images decoded for texImage2DFromEncoded, kept by id until uploaded. The
+  //decoder thread is started by the first one
+  GLuint nextDecodedImage;
+  std::map<GLuint, std::shared_ptr<WebGLDecodedImage>> decodedImages;
+  std::unique_ptr<WebGLImageDecoder> imageDecoder;
+
+  //Textures under residency management. Textures not used in the current
+  //frame are evicted least recently used first while texture storage is over
+  //the budget, those bound to a unit or attached to a framebuffer are kept
+  double residencyBudget;
+  uint64_t frame;
+  uint64_t evictions;
+  uint64_t restores;
+  std::map<GLuint, WebGLResidentTexture> residentTextures;
+  GLboolean texImage(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const unsigned char* pixels);
+  void residentImageSpecified(GLuint texture, GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLenum format, GLenum type, const unsigned char* pixels);
+  void residentSubImage(GLuint texture, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, GLint alignment, const unsigned char* pixels);
+  void residentImageLost(GLuint texture, GLenum target, GLint level);
+  void evictTexture(GLuint texture, WebGLResidentTexture& resident);
+  bool restoreTexture(GLuint texture, WebGLResidentTexture& resident);
+  void enforceResidency();
+
+  //Atlases made by createAtlas, regions are placed and uploaded natively
+  GLuint nextAtlas;
+  std::map<GLuint, WebGLAtlas> atlases;
+
+  //Texture bound to a target of the active unit, the state shadow knows it
+  //unless it was never set through this context
+  GLuint textureBinding(GLenum bindTarget);
+
+  //Error handling. Errors are queued in the order they were raised, each code
+  //at most once like the WebGL error flags
+  WebGLErrorMode errorMode;
+  bool debugErrorRaised;
+  bool outOfMemoryRaised;
+  std::vector<GLenum> errors;
+  void recordError(GLenum error);
+  GLenum collectErrors();
+  bool discardErrors();
+  void beginStorage();
+  static void GL_APIENTRY debugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam);
   void setError(GLenum error);
   GLenum getError();
   GLenum GetError();
   void SetError(GLenum error);
+  bool DeferErrors();
 
   //Preferred depth format
   GLenum preferredDepth;
@@ -224,8 +709,8 @@ struct WebGLRenderingContext {
   void Swap();
 
   void VertexAttribDivisor(GLuint index, GLuint divisor);
-  void DrawArraysInstanced(GLenum mode, GLint first, GLuint count, GLuint icount);
-  void DrawElementsInstanced(GLenum mode, GLint count, GLenum type, GLint offset, GLuint icount);
+  void DrawArraysInstanced(GLenum mode, GLint first, GLint count, GLint icount);
+  void DrawElementsInstanced(GLenum mode, GLint count, GLenum type, GLint offset, GLint icount);
 
   void Uniform1f(GLint location, GLfloat x);
   void Uniform2f(GLint location, GLfloat x, GLfloat y);
@@ -235,13 +720,21 @@ struct WebGLRenderingContext {
   void Uniform2i(GLint location, GLint x, GLint y);
   void Uniform3i(GLint location, GLint x, GLint y, GLint z);
   void Uniform4i(GLint location, GLint x, GLint y, GLint z, GLint w);
+  void Uniform1fv(GLint location, GLsizei count, qjs::Float32Array value);
+  void Uniform2fv(GLint location, GLsizei count, qjs::Float32Array value);
+  void Uniform3fv(GLint location, GLsizei count, qjs::Float32Array value);
+  void Uniform4fv(GLint location, GLsizei count, qjs::Float32Array value);
+  void Uniform1iv(GLint location, GLsizei count, qjs::Int32Array value);
+  void Uniform2iv(GLint location, GLsizei count, qjs::Int32Array value);
+  void Uniform3iv(GLint location, GLsizei count, qjs::Int32Array value);
+  void Uniform4iv(GLint location, GLsizei count, qjs::Int32Array value);
 
   void PixelStorei(GLenum pname, GLenum param);
   void BindAttribLocation(GLint program, GLint index, const std::string& name);
   void DrawArrays(GLenum mode, GLint first, GLint count);
-  void UniformMatrix2fv(GLint location, GLboolean transpose, const std::vector<GLfloat> data);
-  void UniformMatrix3fv(GLint location, GLboolean transpose, const std::vector<GLfloat> data);
-  void UniformMatrix4fv(GLint location, GLboolean transpose, const std::vector<GLfloat> data);
+  void UniformMatrix2fv(GLint location, GLboolean transpose, qjs::Float32Array data);
+  void UniformMatrix3fv(GLint location, GLboolean transpose, qjs::Float32Array data);
+  void UniformMatrix4fv(GLint location, GLboolean transpose, qjs::Float32Array data);
   void GenerateMipmap(GLint target);
   GLint GetAttribLocation(GLint program, const std::string& name);
   void DepthFunc(GLenum func);
@@ -264,8 +757,10 @@ struct WebGLRenderingContext {
   void Enable(GLenum cap);
   GLuint CreateTexture();
   void BindTexture(GLenum target, GLint texture);
-  void TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLint type, WebGLByteArray pixels);
+  GLboolean TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLint type, WebGLByteArray pixels);
   void TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, WebGLByteArray pixels);
+  GLboolean TexImage2DFloat32(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, WebGLByteArray pixels);
+  void TexSubImage2DFloat32(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, WebGLByteArray pixels);
   void TexParameteri(GLenum target, GLenum pname, GLint param);
   void TexParameterf(GLenum target, GLenum pname, GLfloat param);
   void Clear(GLbitfield mask); 
@@ -275,14 +770,14 @@ struct WebGLRenderingContext {
   GLuint CreateFramebuffer();
   void BindFramebuffer(GLint target, GLint buffer); 
   void FramebufferTexture2D(GLenum target, GLenum attachment, GLint textarget, GLint texture, GLint level);
-  void BufferData(GLint target, WebGLBufferData data, GLenum usage);
+  GLboolean BufferData(GLint target, WebGLBufferData data, GLenum usage);
   void BufferSubData(GLenum target, GLint offset, WebGLByteArray array);
   void BlendEquation(GLenum mode);
   void BlendFunc(GLenum sfactor, GLenum dfactor);
   void EnableVertexAttribArray(GLuint index);
   void VertexAttribPointer(GLint index, GLint size, GLenum type, GLboolean normalized, GLint stride, qjs_size_t offset);
   void ActiveTexture(GLenum texture);
-  void DrawElements(GLenum mode, GLint count, GLenum type, qjs_size_t offset);
+  void DrawElements(GLenum mode, GLint count, GLenum type, GLint offset);
   void Flush();
   void Finish();
 
@@ -296,8 +791,10 @@ struct WebGLRenderingContext {
   void BlendFuncSeparate(GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha);
   void ClearStencil(GLint s);
   void ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a);
-  void CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
+  GLboolean CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
   void CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+  GLboolean CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, WebGLByteArray data);
+  void CompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, WebGLByteArray data);
   void CullFace(GLenum mode);
   void DepthMask(GLboolean flag);
   void DepthRange(GLclampf zNear, GLclampf zFar);
@@ -331,20 +828,41 @@ struct WebGLRenderingContext {
   GLboolean IsRenderbuffer(GLuint renderbuffer);
   GLboolean IsShader(GLuint shader);
   GLboolean IsTexture(GLuint texture);
-  void RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+  GLboolean RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
   std::string GetShaderSource(GLint shader);
   void ReadPixels(GLint x, GLint y, GLsizei width, GLsizei heigh, GLenum format, GLenum type, WebGLByteArray pixels);
+  GLuint ReadPixelsAsync(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type);
+  GLint ReadPixelsAsyncResult(GLuint id, WebGLByteArray pixels);
+  GLuint DecodeImage(WebGLByteArray bytes, GLenum format, GLboolean flipY, GLboolean premultiply);
+  std::vector<double> GetDecodedImage(GLuint id);
+  GLboolean TexImage2DDecoded(GLuint id, GLuint texture, GLenum target, GLint level);
+  void ReleaseDecodedImage(GLuint id);
+  GLuint EnqueueTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLenum format, GLenum type, WebGLByteArray pixels);
+  GLuint EnqueueBufferData(GLenum target, WebGLByteArray data, GLenum usage);
+  void SetUploadBudget(GLint microseconds);
+  void ProcessUploads();
+  WebGLScratchArray<GLint> TakeFinishedUploads();
+  GLuint CreateAtlas(GLsizei width, GLsizei height, GLint padding, GLenum format, GLboolean mipmaps);
+  GLboolean AtlasAddPage(GLuint atlas, GLuint texture);
+  std::vector<double> AtlasInsert(GLuint atlas, GLsizei width, GLsizei height, WebGLByteArray pixels);
+  void DeleteAtlas(GLuint atlas);
+  void SetResidencyBudget(double bytes);
+  void ManageTexture(GLuint texture, GLboolean keepPixels);
+  void UnmanageTexture(GLuint texture);
+  GLboolean TextureEvicted(GLuint texture);
+  std::vector<double> GetResidencyStats();
   WebGLTexParameter GetTexParameter(GLenum target, GLenum pname);
   WebGLActiveElement GetActiveAttrib(GLuint program, GLuint index);
   WebGLActiveElement GetActiveUniform(GLuint program, GLuint index);
-  std::vector<GLsizei> GetAttachedShaders(GLuint program);
+  WebGLScratchArray<GLuint> GetAttachedShaders(GLuint program);
   WebGLParameter GetParameter(GLenum name);
+  GLint GetParameterInto(GLenum name, WebGLParameterTarget target);
   GLint GetBufferParameter(GLenum target, GLenum pname);
   GLint GetFramebufferAttachmentParameter(GLenum target, GLenum attachment, GLenum pname);
   std::string GetProgramInfoLog(GLuint program);
   WebGLShaderPrecisionFormat GetShaderPrecisionFormat(GLenum shaderType, GLenum precisionType);
   int GetRenderbufferParameter(GLenum target, GLenum pname);
-  std::vector<float> GetUniform(GLint program, GLint location);
+  WebGLScratchArray<GLfloat> GetUniform(GLint program, GLint location);
   WebGLAttrib GetVertexAttrib(GLint index, GLenum pname);
   const char* GetSupportedExtensions();
   // WebGLExtension GetExtension(const std::string& name);
@@ -355,6 +873,29 @@ struct WebGLRenderingContext {
   GLuint CreateVertexArrayOES();
   void DeleteVertexArrayOES(GLuint array);
   bool IsVertexArrayOES(GLuint array);
+
+  //Largest index used by a drawElements call, -1 if count is 0
+  int64_t GetMaxIndex(GLuint buffer, GLenum type, qjs_size_t offset, GLsizei count);
+  bool IsRobustAccess();
+  bool StencilStateValid();
+  void EnableExtension(const std::string& name);
+  void SetDrawingBuffer(GLuint framebuffer);
+  void SetDrawingBufferSize(GLsizei width, GLsizei height);
+  void SetDrawingBufferStorage(GLuint texture, GLuint renderbuffer);
+  void FramebufferAttachment(GLuint framebuffer, GLenum attachment, GLenum target, GLuint object, GLint level);
+  GLenum FramebufferStatus(GLuint framebuffer);
+  std::vector<double> GetUniformStats();
+
+  //Scratch arena sizing and usage
+  void SetArenaSize(qjs_size_t size);
+  std::vector<double> GetArenaStats();
+  std::vector<double> GetMemoryStats();
+  double GetObjectMemory(GLuint type, GLuint object);
+  void SetMemoryBudget(double bytes);
+  GLboolean TakeMemoryBudgetCrossed();
+
+  //Executes a stream of encoded commands (see WebGLCommandOp)
+  void Submit(qjs::Uint32Array commands, GLuint length);
   
   void initPointers();
 
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+#
+# Generates src/bindings-direct.h, plain QuickJS function tables for the
+# context methods that only take numbers and buffers and return numbers. bindings.cpp installs
+# them over the quickjspp bindings of the same name when DIRECT_BINDINGS is
+# enabled, so these calls skip the template argument conversion, the
+# shared_ptr copy of `this` and the exception handling.
+#
+# Methods are read from the .fun<&WebGLRenderingContext::X>("name") entries of
+# bindings.cpp and their signatures from webgl.h. Run it again after adding or
+# changing a binding:
+#
+#   python3 tools/gen-direct-bindings.py
+
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'src')
+
+# Argument and return types read with JS_ToInt32/JS_ToFloat64/JS_ToBool
+SCALAR_ARGS = {
+    'GLint', 'GLsizei', 'int', 'int32_t',
+    'GLenum', 'GLuint', 'GLbitfield', 'qjs_size_t',
+    'GLfloat', 'GLclampf',
+    'GLboolean', 'bool'
+}
+# ArrayBuffers and views, borrowed in place by the directArg overloads
+BUFFER_ARGS = {'WebGLByteArray', 'WebGLBufferData'}
+SCALAR_RETURNS = {'void', 'GLint', 'int', 'GLenum', 'GLuint', 'GLboolean', 'bool'}
+
+
+def read(name):
+    with open(os.path.join(ROOT, name)) as f:
+        return f.read()
+
+
+def parse_bindings(source):
+    return re.findall(r'\.fun<&WebGLRenderingContext::(\w+)>\("(\w+)"\)', source)
+
+
+def parse_declarations(header):
+    declarations = {}
+    overloaded = set()
+    for match in re.finditer(r'^\s+([\w:<>]+)\s+(\w+)\(([^)]*)\);', header, re.M):
+        ret, name, params = match.groups()
+        types = []
+        for param in filter(None, (p.strip() for p in params.split(','))):
+            types.append(param.rsplit(None, 1)[0] if ' ' in param else param)
+        if name in declarations:
+            overloaded.add(name)
+        declarations[name] = (ret, tuple(types))
+    for name in overloaded:
+        del declarations[name]
+    return declarations
+
+
+def handler_name(signature):
+    ret, types = signature
+    return 'direct_' + '_'.join((ret,) + types if types else (ret, 'void'))
+
+
+def table_name(signature):
+    return handler_name(signature).upper()
+
+
+def emit(bindings, declarations):
+    groups = {}
+    entries = []
+    for method, js_name in bindings:
+        signature = declarations.get(method)
+        if signature is None:
+            continue
+        ret, types = signature
+        if ret not in SCALAR_RETURNS or any(t not in SCALAR_ARGS | BUFFER_ARGS for t in types):
+            continue
+        methods = groups.setdefault(signature, [])
+        if method not in methods:
+            methods.append(method)
+        entries.append((js_name, len(types), signature, methods.index(method)))
+
+    out = []
+    out.append('// Generated by tools/gen-direct-bindings.py from webgl.h and bindings.cpp, do not edit')
+    out.append('')
+    out.append('#ifndef WEBGL_BINDINGS_DIRECT_H_')
+    out.append('#define WEBGL_BINDINGS_DIRECT_H_')
+
+    for signature in sorted(groups):
+        ret, types = signature
+        name = handler_name(signature)
+        table = table_name(signature)
+        out.append('')
+        out.append('static %s (WebGLRenderingContext::* const %s[])(%s) = {' % (ret, table, ', '.join(types)))
+        for method in groups[signature]:
+            out.append('  &WebGLRenderingContext::%s,' % method)
+        out.append('};')
+        out.append('')
+        out.append('static JSValue %s(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int magic) {' % name)
+        out.append('  WebGLRenderingContext* self = directContext(ctx, this_val);')
+        out.append('  if(!self) {')
+        out.append('    return JS_EXCEPTION;')
+        out.append('  }')
+        for i, t in enumerate(types):
+            out.append('  %s a%d;' % (t, i))
+        if types:
+            reads = ' ||\n     '.join('directArg(ctx, argv[%d], &a%d)' % (i, i) for i in range(len(types)))
+            out.append('  if(%s) {' % reads)
+            out.append('    return JS_EXCEPTION;')
+            out.append('  }')
+        call = '(self->*%s[magic])(%s)' % (table, ', '.join('a%d' % i for i in range(len(types))))
+        if ret == 'void':
+            out.append('  %s;' % call)
+            out.append('  return JS_UNDEFINED;')
+        else:
+            out.append('  return directReturn(ctx, %s);' % call)
+        out.append('}')
+
+    out.append('')
+    out.append('static const JSCFunctionListEntry DIRECT_BINDINGS[] = {')
+    for js_name, length, signature, magic in entries:
+        out.append('  JS_CFUNC_MAGIC_DEF("%s", %d, %s, %d),' % (js_name, length, handler_name(signature), magic))
+    out.append('};')
+    out.append('')
+    out.append('#endif')
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    bindings = parse_bindings(read('bindings.cpp'))
+    declarations = parse_declarations(read('webgl.h'))
+    output = emit(bindings, declarations)
+    with open(os.path.join(ROOT, 'bindings-direct.h'), 'w') as f:
+        f.write(output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())